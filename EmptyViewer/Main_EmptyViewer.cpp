@@ -1,3 +1,18 @@
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <climits>
+#include <cstdlib>
+#endif
 #include <Windows.h>
 #include <iostream>
 #include <GL/glew.h>
@@ -9,15 +24,147 @@
 #define GLFW_DLL
 #include <GLFW/glfw3.h>
 #include <vector>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cctype>
+#include <cfloat>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <emmintrin.h>
 
 #define GLM_SWIZZLE
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/noise.hpp>
+#include <glm/gtc/packing.hpp>
 #include <glm/gtx/string_cast.hpp>
+#include <glm/gtx/spline.hpp>
+#include <glm/gtx/simd_wide.hpp>
+#include <glm/gtx/simd_soa.hpp>
+#include <glm/gtx/simd_packing.hpp>
+#include <glm/gtx/simd_transform.hpp>
 
 using namespace glm;
 
+// --------------------------
+// ޸ 뷮 
+// --------------------------
+
+// MemCategory: ϴ Ҵ з
+enum MemCategory {
+    MEM_GEOMETRY,
+    MEM_ACCEL,
+    MEM_TEXTURE,
+    MEM_FRAMEBUFFER,
+    MEM_SCRATCH,
+    MEM_CATEGORY_COUNT
+};
+
+const char* MemCategoryNames[MEM_CATEGORY_COUNT] = {
+    "geometry", "accel", "texture", "framebuffer", "scratch"
+};
+
+// ζ ʴ Լ (Ҵ ο )
+#ifdef _MSC_VER
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+// MemoryTracker: з /ִ 뷮 ü (budget, 0̸ )
+class MemoryTracker {
+public:
+    std::atomic<size_t> current[MEM_CATEGORY_COUNT];
+    std::atomic<size_t> peak[MEM_CATEGORY_COUNT];
+    std::atomic<size_t> peakTotal;
+    size_t budget;
+    MemoryTracker() : peakTotal(0), budget(0) {
+        for (int c = 0; c < MEM_CATEGORY_COUNT; ++c) {
+            current[c] = 0;
+            peak[c] = 0;
+        }
+    }
+    void add(MemCategory c, size_t bytes) {
+        size_t now = current[c].fetch_add(bytes) + bytes;
+        raise(peak[c], now);
+        raise(peakTotal, total());
+    }
+    void sub(MemCategory c, size_t bytes) {
+        current[c].fetch_sub(bytes);
+    }
+    // ϴ Ҵ ,   Ҵ    ħ
+    // allocate() ζεǸ GCC ::operator new  Ŭ operator delete Ѵٰ 
+    // -Wmismatched-new-delete Ƿ (  ) ζ 
+    NOINLINE void* allocate(MemCategory c, size_t bytes) {
+        void* p = ::operator new(bytes);
+        add(c, bytes);
+        return p;
+    }
+    NOINLINE void release(MemCategory c, void* p, size_t bytes) {
+        sub(c, bytes);
+        ::operator delete(p);
+    }
+    size_t currentBytes(MemCategory c) const { return current[c].load(); }
+    size_t peakBytes(MemCategory c) const { return peak[c].load(); }
+    size_t total() const {
+        size_t sum = 0;
+        for (int c = 0; c < MEM_CATEGORY_COUNT; ++c)
+            sum += current[c].load();
+        return sum;
+    }
+    // ߰ extra Ʈ Ҵص  ȿ 
+    bool fits(size_t extra) const {
+        return budget == 0 || total() + extra <= budget;
+    }
+    void report(std::ostream& os) const {
+        char line[128];
+        os << "[memory] category        current        peak\n";
+        for (int c = 0; c < MEM_CATEGORY_COUNT; ++c) {
+            snprintf(line, sizeof(line), "[memory] %-12s %12zu B %12zu B\n",
+                MemCategoryNames[c], current[c].load(), peak[c].load());
+            os << line;
+        }
+        snprintf(line, sizeof(line), "[memory] total %zu B, peak %zu B", total(), peakTotal.load());
+        os << line;
+        if (budget) os << ", budget " << budget << " B";
+        os << std::endl;
+    }
+private:
+    static void raise(std::atomic<size_t>& p, size_t v) {
+        size_t old = p.load();
+        while (v > old && !p.compare_exchange_weak(old, v)) {}
+    }
+};
+
+MemoryTracker memTracker;
+
+// TrackedAllocator: std::vector  ٿ з C 뷮 ϴ Ҵ
+template <class T, MemCategory C>
+struct TrackedAllocator {
+    typedef T value_type;
+    TrackedAllocator() {}
+    template <class U> TrackedAllocator(const TrackedAllocator<U, C>&) {}
+    template <class U> struct rebind { typedef TrackedAllocator<U, C> other; };
+    T* allocate(size_t n) {
+        return static_cast<T*>(memTracker.allocate(C, n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t n) {
+        memTracker.release(C, p, n * sizeof(T));
+    }
+    template <class U> bool operator==(const TrackedAllocator<U, C>&) const { return true; }
+    template <class U> bool operator!=(const TrackedAllocator<U, C>&) const { return false; }
+};
+
 // --------------------------
 // ⺻ Ŭ 
 // --------------------------
@@ -30,12 +177,121 @@ public:
     Ray(const vec3& o, const vec3& d) : origin(o), direction(normalize(d)) { }
 };
 
+// Pcg32: °    (PCG-XSH-RR), ¸ ״ /  
+struct Pcg32 {
+    uint64_t state = 0;
+    uint64_t inc = 1;
+    Pcg32() { }
+    Pcg32(uint64_t seed, uint64_t stream) {
+        inc = (stream << 1u) | 1u;
+        next();
+        state += seed;
+        next();
+    }
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        uint32_t xorshifted = uint32_t(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = uint32_t(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+    // [0, 1) 
+    float nextFloat() { return (next() >> 8) * (1.0f / 16777216.0f); }
+};
+
+// FNV-1a 64Ʈ ؽ
+uint64_t hashBytes(const void* data, size_t size, uint64_t h = 14695981039346656037ULL) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t k = 0; k < size; ++k) {
+        h ^= p[k];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Material: ǥ ,   "material ..."  (Ȯ ݻ, ſ ݻ ,  ,  )
+// GLOSSY ȭ Phong ݻ (MIS 忡  ϰ ٸ 忡 Ȯ )
+struct Material {
+    enum Type { DIFFUSE, MIRROR, GLASS, GLOSSY };
+    Type type = DIFFUSE;
+    vec3 color = vec3(1.0f);
+    float ior = 1.5f;
+    float exponent = 0.0f;
+    //  ϳ   (ſ, )
+    bool specular() const { return type == MIRROR || type == GLASS; }
+    bool operator==(const Material& o) const {
+        return type == o.type && color == o.color && ior == o.ior && exponent == o.exponent;
+    }
+    bool operator!=(const Material& o) const { return !(*this == o); }
+    void write(std::ostream& os) const {
+        if (type == GLASS) os << "material glass " << ior << '\n';
+        else if (type == GLOSSY) os << "material glossy " << color.r << ' ' << color.g << ' ' << color.b << ' ' << exponent << '\n';
+        else os << "material " << (type == MIRROR ? "mirror " : "diffuse ")
+                << color.r << ' ' << color.g << ' ' << color.b << '\n';
+    }
+};
+
+// PointLight: , power    ü Ϸ (RGB)
+struct PointLight {
+    vec3 position;
+    vec3 power;
+};
+
+// SphereLight:  , ǥ鿡    radiance  ( ü  )
+struct SphereLight {
+    vec3 center;
+    float radius;
+    vec3 radiance;
+    // ray  ǥ鿡    t (  )
+    float intersect(const Ray& ray) const {
+        vec3 oc = ray.origin - center;
+        float b = dot(ray.direction, oc);
+        float disc = b * b - (dot(oc, oc) - radius * radius);
+        if (disc < 0.0f) return -1.0f;
+        float s = sqrtf(disc);
+        if (-b - s > 1e-4f) return -b - s;
+        return (-b + s > 1e-4f) ? -b + s : -1.0f;
+    }
+};
+
+// PrimKind: BVH  SoA    ˻ϴ ü  (PrimBatch)
+enum PrimKind { PRIM_OTHER, PRIM_BOX, PRIM_DISK };
+
 // Surface:   ü ӹ ߻ Ŭ
 class Surface {
 public:
+    Material material;
     virtual ~Surface() {}
     // ־ ray  t (  )
     virtual float intersect(const Ray& ray) const = 0;
+    // ǥ   p ٱ  
+    virtual vec3 normal(const vec3& p) const = 0;
+    //  ,  ü( ) false
+    virtual bool bounds(vec3& /*lo*/, vec3& /*hi*/) const { return false; }
+    //    ٷ  (readScene() ¦)
+    virtual void write(std::ostream& os) const = 0;
+    virtual Surface* clone() const = 0;
+    // ִϸ̼ Ű ġ ̵ (ġ   ü )
+    virtual void moveTo(const vec3& /*p*/) { }
+    // PrimBatch   ִ  (, Ǹ)
+    virtual PrimKind primKind() const { return PRIM_OTHER; }
+    // mask ִ ray  tNearest  (  ), ⺻ intersect() ϳ ȣ
+    virtual void intersectPacket(const Ray* rays, uint32_t mask, float* tNearest) const {
+        for (int k = 0; k < 32; ++k) {
+            if (!(mask & (1u << k))) continue;
+            float t = intersect(rays[k]);
+            if (t > 0.0f && (tNearest[k] < 0.0f || t < tNearest[k]))
+                tNearest[k] = t;
+        }
+    }
+
+    //  ü ޸𸮴 geometry з 
+    static void* operator new(size_t sz) {
+        return memTracker.allocate(MEM_GEOMETRY, sz);
+    }
+    static void operator delete(void* p, size_t sz) {
+        memTracker.release(MEM_GEOMETRY, p, sz);
+    }
 };
 
 // Sphere: ü,   ⺻ 2  Ǯ 
@@ -57,140 +313,6174 @@ public:
         if (t2 > 0.001f) return t2;
         return -1.0f;
     }
+    virtual void intersectPacket(const Ray* rays, uint32_t mask, float* tNearest) const override;
+    virtual vec3 normal(const vec3& p) const override { return (p - center) / radius; }
+    virtual bool bounds(vec3& lo, vec3& hi) const override {
+        lo = center - vec3(radius);
+        hi = center + vec3(radius);
+        return true;
+    }
+    virtual void write(std::ostream& os) const override {
+        os << "sphere " << center.x << ' ' << center.y << ' ' << center.z << ' ' << radius << '\n';
+    }
+    virtual Surface* clone() const override { return new Sphere(*this); }
+    virtual void moveTo(const vec3& p) override { center = p; }
+};
+
+// Sphere::intersect() ray 8 SoA(vec3x8) , İ   Į ڵ 
+template <typename isa>
+struct SpherePacketKernel {
+    typedef glm::detail::fvecNSIMD<isa, 8> V;
+
+    static void run(const Sphere& sphere, const Ray* rays, uint32_t mask, float* tNearest) {
+        int idx[32], n = 0;
+        for (int k = 0; k < 32; ++k)
+            if (mask & (1u << k)) idx[n++] = k;
+        V zero(0.0f), eps(0.001f);
+        for (int g = 0; g < n; g += 8) {
+            int lanes = std::min(n - g, 8);
+            //    ray ݺ
+            vec3x8<isa> origin, direction;
+            for (int l = 0; l < 8; ++l) {
+                const Ray& r = rays[idx[g + std::min(l, lanes - 1)]];
+                origin.setLane(l, r.origin);
+                direction.setLane(l, r.direction);
+            }
+            vec3x8<isa> oc = origin - vec3x8<isa>(sphere.center);
+            V b = 2.0f * dot(direction, oc);
+            V c_val = dot(oc, oc) - V(sphere.radius * sphere.radius);
+            V disc = b * b - 4.0f * c_val;
+            V sqrtDisc = sqrt(max(disc, zero));
+            V t1 = (-b - sqrtDisc) / 2.0f;
+            V t2 = (-b + sqrtDisc) / 2.0f;
+            V t = select(t1 > eps, t1, t2);
+            unsigned hit = bitmask((disc >= zero) & (t > eps));
+            for (int l = 0; l < lanes; ++l) {
+                int k = idx[g + l];
+                if ((hit & (1u << l)) && (tNearest[k] < 0.0f || t[l] < tNearest[k])) tNearest[k] = t[l];
+            }
+        }
+    }
 };
 
-// Plane: y = constant 
+void Sphere::intersectPacket(const Ray* rays, uint32_t mask, float* tNearest) const {
+    // ray    Ǹ  ä   ŭ
+    if (bitCount(mask) < 4)
+        Surface::intersectPacket(rays, mask, tNearest);
+    else
+        simdDispatch<SpherePacketKernel>(*this, rays, mask, tNearest);
+}
+
+// Plane: dot(n, p) = d   (n  ), "plane y" n = (0, 1, 0) ٴ
 class Plane : public Surface {
 public:
-    float y;
-    Plane(float yVal) : y(yVal) { }
+    vec3 n;
+    float d;
+    Plane(float yVal) : n(0.0f, 1.0f, 0.0f), d(yVal) { }
+    Plane(const vec3& normal, float dist) : n(normalize(normal)), d(dist / length(normal)) { }
     virtual float intersect(const Ray& ray) const override {
-        if (fabs(ray.direction.y) < 1e-6f) return -1.0f;
-        float t = (y - ray.origin.y) / ray.direction.y;
+        float denom = dot(n, ray.direction);
+        if (fabs(denom) < 1e-6f) return -1.0f;
+        float t = (d - dot(n, ray.origin)) / denom;
         return (t > 0.001f) ? t : -1.0f;
     }
+    virtual vec3 normal(const vec3& /*p*/) const override { return n; }
+    virtual void write(std::ostream& os) const override {
+        if (n == vec3(0.0f, 1.0f, 0.0f)) os << "plane " << d << '\n';
+        else os << "plane " << n.x << ' ' << n.y << ' ' << n.z << ' ' << d << '\n';
+    }
+    virtual Surface* clone() const override { return new Plane(*this); }
+    //  ״ ΰ p  ̵
+    virtual void moveTo(const vec3& p) override { d = dot(n, p); }
 };
 
-// Camera:  ġ   ̿ ȼ ϴ ray 
-class Camera {
+// Disk: ߽, ,   
+class Disk : public Surface {
 public:
-    vec3 eye;
-    float l, r, b, t, d;
-    Camera(const vec3& e, float l_, float r_, float b_, float t_, float d_)
-        : eye(e), l(l_), r(r_), b(b_), t(t_), d(d_) { }
-    Ray generateRay(int i, int j, int nx, int ny) const {
-        float u = l + (r - l) * ((i + 0.5f) / float(nx));
-        float v = b + (t - b) * ((j + 0.5f) / float(ny));
-        vec3 imagePoint(u, v, -d);
-        return Ray(eye, imagePoint - eye);
+    vec3 center, n;
+    float radius;
+    Disk(const vec3& c, const vec3& normal, float r) : center(c), n(normalize(normal)), radius(r) { }
+    virtual float intersect(const Ray& ray) const override {
+        float denom = dot(n, ray.direction);
+        if (fabs(denom) < 1e-6f) return -1.0f;
+        float t = dot(n, center - ray.origin) / denom;
+        vec3 q = ray.origin + ray.direction * t - center;
+        return (t > 0.001f && dot(q, q) <= radius * radius) ? t : -1.0f;
+    }
+    virtual vec3 normal(const vec3& /*p*/) const override { return n; }
+    //  a   radius * sqrt(1 - n[a]^2)
+    virtual bool bounds(vec3& lo, vec3& hi) const override {
+        vec3 e = radius * sqrt(max(vec3(1.0f) - n * n, vec3(0.0f))) + vec3(1e-4f);
+        lo = center - e;
+        hi = center + e;
+        return true;
     }
+    virtual void write(std::ostream& os) const override {
+        os << "disk " << center.x << ' ' << center.y << ' ' << center.z << ' '
+           << n.x << ' ' << n.y << ' ' << n.z << ' ' << radius << '\n';
+    }
+    virtual Surface* clone() const override { return new Disk(*this); }
+    virtual void moveTo(const vec3& p) override { center = p; }
+    virtual PrimKind primKind() const override { return PRIM_DISK; }
 };
 
-// Scene:   ü ϰ, ־ ray     t ã
-class Scene {
+// boxSlab(): θ  ǥ ű ray  slab ˻ 4,   ũ (t  t)
+// o  ߽  , axis[3 * a + c]   a  c, İ   Box::intersect() 
+// Box::intersectPacket()(ray 4,  1) PrimBatch(ray 1,  4) Բ 
+int boxSlab(__m128 ox, __m128 oy, __m128 oz, __m128 dx, __m128 dy, __m128 dz,
+            const __m128* axis, const __m128* half, __m128& t) {
+    __m128 enter = _mm_set1_ps(-FLT_MAX), exit = _mm_set1_ps(FLT_MAX);
+    for (int a = 0; a < 3; ++a) {
+        __m128 ax = axis[3 * a], ay = axis[3 * a + 1], az = axis[3 * a + 2];
+        __m128 o = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ox, ax), _mm_mul_ps(oy, ay)), _mm_mul_ps(oz, az));
+        __m128 dir = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, ax), _mm_mul_ps(dy, ay)), _mm_mul_ps(dz, az));
+        __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), dir), h = half[a];
+        __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_setzero_ps(), h), o), inv);
+        __m128 t1 = _mm_mul_ps(_mm_sub_ps(h, o), inv);
+        enter = _mm_max_ps(enter, _mm_min_ps(t0, t1));
+        exit = _mm_min_ps(exit, _mm_max_ps(t0, t1));
+    }
+    //  ȿ ϸ  
+    __m128 eps = _mm_set1_ps(0.001f);
+    __m128 useEnter = _mm_cmpgt_ps(enter, eps);
+    t = _mm_or_ps(_mm_and_ps(useEnter, enter), _mm_andnot_ps(useEnter, exit));
+    return _mm_movemask_ps(_mm_and_ps(_mm_cmple_ps(enter, exit), _mm_cmpgt_ps(t, eps)));
+}
+
+// Box: ߽,  ũ, ȸ(, )  , ȸ    
+//  ray  ǥ ű  б  slab ˻, Ŷ ray 4 boxSlab()   ˻
+class Box : public Surface {
 public:
-    std::vector<Surface*> objects;
-    ~Scene() {
-        for (auto obj : objects)
-            delete obj;
+    vec3 center, half;
+    vec3 axis;    // ȸ (  Ͽ)
+    float angle;  // ȸ ()
+    mat3 rot;     //   
+
+    Box(const vec3& lo, const vec3& hi)
+        : center((lo + hi) * 0.5f), half(abs(hi - lo) * 0.5f), axis(0.0f, 1.0f, 0.0f), angle(0.0f), rot(1.0f) { }
+    Box(const vec3& c, const vec3& h, const vec3& rotAxis, float degrees)
+        : center(c), half(abs(h)), axis(normalize(rotAxis)), angle(degrees),
+          rot(mat3(rotate(mat4(1.0f), degrees, normalize(rotAxis)))) { }
+
+    virtual float intersect(const Ray& ray) const override {
+        vec3 o = (ray.origin - center) * rot, dir = ray.direction * rot;
+        vec3 inv = 1.0f / dir;
+        vec3 t0 = (-half - o) * inv, t1 = (half - o) * inv;
+        vec3 tn = min(t0, t1), tf = max(t0, t1);
+        float enter = max(max(tn.x, tn.y), tn.z), exit = min(min(tf.x, tf.y), tf.z);
+        if (enter > exit) return -1.0f;
+        //  ȿ ϸ  
+        return enter > 0.001f ? enter : (exit > 0.001f ? exit : -1.0f);
     }
-    float findNearest(const Ray& ray) const {
-        float t_nearest = -1.0f;
-        for (const auto obj : objects) {
-            float t = obj->intersect(ray);
-            if (t > 0.0f && (t_nearest < 0.0f || t < t_nearest))
-                t_nearest = t;
+    virtual void intersectPacket(const Ray* rays, uint32_t mask, float* tNearest) const override {
+        int idx[32], n = 0;
+        for (int k = 0; k < 32; ++k)
+            if (mask & (1u << k)) idx[n++] = k;
+        __m128 axes[9], halves[3];
+        for (int a = 0; a < 3; ++a) {
+            for (int c = 0; c < 3; ++c) axes[3 * a + c] = _mm_set1_ps(rot[a][c]);
+            halves[a] = _mm_set1_ps(half[a]);
         }
-        return t_nearest;
+        for (int g = 0; g < n; g += 4) {
+            int lanes = std::min(n - g, 4);
+            //    ray ݺ
+            alignas(16) float ox[4], oy[4], oz[4], dx[4], dy[4], dz[4], t[4];
+            for (int l = 0; l < 4; ++l) {
+                const Ray& r = rays[idx[g + std::min(l, lanes - 1)]];
+                ox[l] = r.origin.x - center.x; oy[l] = r.origin.y - center.y; oz[l] = r.origin.z - center.z;
+                dx[l] = r.direction.x; dy[l] = r.direction.y; dz[l] = r.direction.z;
+            }
+            __m128 tw;
+            int hit = boxSlab(_mm_load_ps(ox), _mm_load_ps(oy), _mm_load_ps(oz), _mm_load_ps(dx), _mm_load_ps(dy), _mm_load_ps(dz),
+                              axes, halves, tw);
+            _mm_store_ps(t, tw);
+            for (int l = 0; l < lanes; ++l) {
+                int k = idx[g + l];
+                if ((hit & (1 << l)) && (tNearest[k] < 0.0f || t[l] < tNearest[k])) tNearest[k] = t[l];
+            }
+        }
+    }
+    //  ǥ  ũ   ٱ  
+    virtual vec3 normal(const vec3& p) const override {
+        vec3 q = ((p - center) * rot) / max(half, vec3(1e-12f));
+        vec3 a = abs(q);
+        int k = (a.x > a.y && a.x > a.z) ? 0 : (a.y > a.z ? 1 : 2);
+        return rot[k] * (q[k] < 0.0f ? -1.0f : 1.0f);
+    }
+    virtual bool bounds(vec3& lo, vec3& hi) const override {
+        vec3 e = abs(rot[0]) * half.x + abs(rot[1]) * half.y + abs(rot[2]) * half.z;
+        lo = center - e;
+        hi = center + e;
+        return true;
     }
+    virtual void write(std::ostream& os) const override {
+        if (angle == 0.0f) {
+            vec3 lo = center - half, hi = center + half;
+            os << "box " << lo.x << ' ' << lo.y << ' ' << lo.z << ' ' << hi.x << ' ' << hi.y << ' ' << hi.z << '\n';
+        }
+        else {
+            os << "obox " << center.x << ' ' << center.y << ' ' << center.z << ' ' << half.x << ' ' << half.y << ' ' << half.z
+               << ' ' << axis.x << ' ' << axis.y << ' ' << axis.z << ' ' << angle << '\n';
+        }
+    }
+    virtual Surface* clone() const override { return new Box(*this); }
+    virtual void moveTo(const vec3& p) override { center = p; }
+    virtual PrimKind primKind() const override { return PRIM_BOX; }
 };
 
 // --------------------------
-//     Լ
+// SDF (ȣ ִ Ÿ Լ) ü
 // --------------------------
-int Width = 512;
-int Height = 512;
-std::vector<float> OutputImage;
-Camera* camera = nullptr;
-Scene* scene = nullptr;
 
-// render():  ȼ  ray    ο   
-void render() {
-    const int nx = 512, ny = 512;
-    OutputImage.clear();
-    OutputImage.resize(nx * ny * 3);
+// 4  float (SSE), Ÿ Լ float   ۼϱ   
+struct Float4 {
+    __m128 v;
+    Float4() { }
+    Float4(__m128 x) : v(x) { }
+};
+inline Float4 operator+(Float4 a, Float4 b) { return _mm_add_ps(a.v, b.v); }
+inline Float4 operator-(Float4 a, Float4 b) { return _mm_sub_ps(a.v, b.v); }
+inline Float4 operator*(Float4 a, Float4 b) { return _mm_mul_ps(a.v, b.v); }
+inline Float4 operator/(Float4 a, Float4 b) { return _mm_div_ps(a.v, b.v); }
+
+// SDF 꿡   Լ: float Float4  ̸ 
+inline float sdfMin(float a, float b) { return std::min(a, b); }
+inline float sdfMax(float a, float b) { return std::max(a, b); }
+inline float sdfSqrt(float a) { return sqrtf(a); }
+inline float sdfAbs(float a) { return fabsf(a); }
+inline Float4 sdfMin(Float4 a, Float4 b) { return _mm_min_ps(a.v, b.v); }
+inline Float4 sdfMax(Float4 a, Float4 b) { return _mm_max_ps(a.v, b.v); }
+inline Float4 sdfSqrt(Float4 a) { return _mm_sqrt_ps(a.v); }
+inline Float4 sdfAbs(Float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+template <class T> inline T sdfSplat(float a);
+template <> inline float sdfSplat<float>(float a) { return a; }
+template <> inline Float4 sdfSplat<Float4>(float a) { return _mm_set1_ps(a); }
+
+// SDFSurface:  ǥ α׷  SDF ü,  (sphere tracing)  
+// ⺻ : sphere cx cy cz r / box cx cy cz hx hy hz / torus cx cy cz R r (y) / mandelbulb cx cy cz scale
+//  (  ): union / intersect / subtract ( - ) / smooth k (ε巯 )
+// α׷   ڷ BVH ,       
+class SDFSurface : public Surface {
+public:
+    enum OpCode { SPHERE, BOX, TORUS, MANDELBULB, UNION, INTERSECT, SUBTRACT, SMOOTH };
+    struct Op {
+        OpCode code;
+        float a[6];
+    };
+    static const int MaxStack = 16;
+    static const int MaxSteps = 256;
+    std::vector<Op> program;
+    vec3 position;     // α׷ ü ̵ (ִϸ̼)
+    vec3 boxLo, boxHi; // ̵  
+
+    SDFSurface() : position(0.0f), boxLo(0.0f), boxHi(0.0f) { }
+
+    // "sdf x y z <α׷>"  α׷ κ,   ʰų    ̸̸ false
+    bool parse(std::istream& is) {
+        program.clear();
+        std::vector<vec3> lo, hi;
+        std::string name;
+        while (is >> name) {
+            Op op = Op();
+            int args = 0;
+            if (name == "sphere") { op.code = SPHERE; args = 4; }
+            else if (name == "box") { op.code = BOX; args = 6; }
+            else if (name == "torus") { op.code = TORUS; args = 5; }
+            else if (name == "mandelbulb") { op.code = MANDELBULB; args = 4; }
+            else if (name == "union") op.code = UNION;
+            else if (name == "intersect") op.code = INTERSECT;
+            else if (name == "subtract") op.code = SUBTRACT;
+            else if (name == "smooth") { op.code = SMOOTH; args = 1; }
+            else return false;
+            for (int k = 0; k < args; ++k)
+                if (!(is >> op.a[k])) return false;
+            vec3 c(op.a[0], op.a[1], op.a[2]);
+            if (op.code <= MANDELBULB) {
+                if (lo.size() >= size_t(MaxStack)) return false;
+                vec3 e = (op.code == SPHERE) ? vec3(op.a[3]) : (op.code == BOX) ? vec3(op.a[3], op.a[4], op.a[5])
+                       : (op.code == TORUS) ? vec3(op.a[3] + op.a[4], op.a[4], op.a[3] + op.a[4]) : vec3(1.2f * op.a[3]);
+                lo.push_back(c - e);
+                hi.push_back(c + e);
+            }
+            else {
+                if (lo.size() < 2) return false;
+                vec3 blo = lo.back(), bhi = hi.back();
+                lo.pop_back();
+                hi.pop_back();
+                if (op.code == INTERSECT) {
+                    lo.back() = max(lo.back(), blo);
+                    hi.back() = min(hi.back(), bhi);
+                }
+                else if (op.code != SUBTRACT) {
+                    // ε巯    ̸ ִ k/4ŭ ä
+                    float grow = (op.code == SMOOTH) ? 0.25f * op.a[0] : 0.0f;
+                    lo.back() = min(lo.back(), blo) - vec3(grow);
+                    hi.back() = max(hi.back(), bhi) + vec3(grow);
+                }
+            }
+            program.push_back(op);
+        }
+        if (lo.size() != 1) return false;
+        boxLo = lo[0];
+        boxHi = hi[0];
+        return true;
+    }
+
+    //  (x, y, z) Ÿ, T float Ǵ Float4 (θ ٸ )
+    template <class T>
+    T distance(T x, T y, T z) const {
+        T stack[MaxStack];
+        int sp = 0;
+        x = x - sdfSplat<T>(position.x);
+        y = y - sdfSplat<T>(position.y);
+        z = z - sdfSplat<T>(position.z);
+        for (const Op& op : program) {
+            T dx = x - sdfSplat<T>(op.a[0]), dy = y - sdfSplat<T>(op.a[1]), dz = z - sdfSplat<T>(op.a[2]);
+            switch (op.code) {
+            case SPHERE:
+                stack[sp++] = sdfSqrt(dx * dx + dy * dy + dz * dz) - sdfSplat<T>(op.a[3]);
+                break;
+            case BOX: {
+                T qx = sdfAbs(dx) - sdfSplat<T>(op.a[3]), qy = sdfAbs(dy) - sdfSplat<T>(op.a[4]), qz = sdfAbs(dz) - sdfSplat<T>(op.a[5]);
+                T zero = sdfSplat<T>(0.0f);
+                T ox = sdfMax(qx, zero), oy = sdfMax(qy, zero), oz = sdfMax(qz, zero);
+                stack[sp++] = sdfSqrt(ox * ox + oy * oy + oz * oz) + sdfMin(sdfMax(qx, sdfMax(qy, qz)), zero);
+                break;
+            }
+            case TORUS: {
+                T qx = sdfSqrt(dx * dx + dz * dz) - sdfSplat<T>(op.a[3]);
+                stack[sp++] = sdfSqrt(qx * qx + dy * dy) - sdfSplat<T>(op.a[4]);
+                break;
+            }
+            case MANDELBULB:
+                stack[sp++] = mandelbulb(dx, dy, dz, op.a[3]);
+                break;
+            case UNION: --sp; stack[sp - 1] = sdfMin(stack[sp - 1], stack[sp]); break;
+            case INTERSECT: --sp; stack[sp - 1] = sdfMax(stack[sp - 1], stack[sp]); break;
+            case SUBTRACT: --sp; stack[sp - 1] = sdfMax(stack[sp - 1], sdfSplat<T>(0.0f) - stack[sp]); break;
+            case SMOOTH: {
+                --sp;
+                T a = stack[sp - 1], b = stack[sp], k = sdfSplat<T>(op.a[0]);
+                T h = sdfMax(k - sdfAbs(a - b), sdfSplat<T>(0.0f)) / k;
+                stack[sp - 1] = sdfMin(a, b) - h * h * k * sdfSplat<T>(0.25f);
+                break;
+            }
+            }
+        }
+        return stack[0];
+    }
+
+    virtual float intersect(const Ray& ray) const override {
+        float t0, t1;
+        if (!clip(ray, t0, t1)) return -1.0f;
+        float t = t0, step = 0.0f, prevRadius = 0.0f, omega = 1.6f;
+        float sign = distance(ray.origin.x + ray.direction.x * t, ray.origin.y + ray.direction.y * t,
+                              ray.origin.z + ray.direction.z * t) < 0.0f ? -1.0f : 1.0f;
+        for (int i = 0; i < MaxSteps && t <= t1; ++i) {
+            vec3 p = ray.origin + ray.direction * t;
+            float signedRadius = sign * distance(p.x, p.y, p.z);
+            if (march(signedRadius, t, step, prevRadius, omega)) return t > 0.001f ? t : -1.0f;
+        }
+        return -1.0f;
+    }
 
-    for (int j = 0; j < ny; ++j) {
-        for (int i = 0; i < nx; ++i) {
-            Ray ray = camera->generateRay(i, j, nx, ny);
-            float t = scene->findNearest(ray);
-            int idx = (j * nx + i) * 3;
-            if (t > 0.0f) { // ü ϸ 
-                OutputImage[idx] = 1.0f;
-                OutputImage[idx + 1] = 1.0f;
-                OutputImage[idx + 2] = 1.0f;
+    // 4  θ   , Ÿ Լ SSE   
+    virtual void intersectPacket(const Ray* rays, uint32_t mask, float* tNearest) const override {
+        int idx[32], n = 0;
+        for (int k = 0; k < 32; ++k)
+            if (mask & (1u << k)) idx[n++] = k;
+        for (int g = 0; g < n; g += 4) {
+            int lanes = std::min(n - g, 4);
+            float t[4], t1[4], step[4] = { 0, 0, 0, 0 }, prev[4] = { 0, 0, 0, 0 }, omega[4], sign[4] = { 1, 1, 1, 1 };
+            alignas(16) float ox[4] = { 0 }, oy[4] = { 0 }, oz[4] = { 0 }, d[4];
+            bool active[4] = { false, false, false, false };
+            for (int l = 0; l < lanes; ++l) {
+                omega[l] = 1.6f;
+                active[l] = clip(rays[idx[g + l]], t[l], t1[l]);
+                if (active[l]) {
+                    vec3 p = rays[idx[g + l]].origin + rays[idx[g + l]].direction * t[l];
+                    sign[l] = distance(p.x, p.y, p.z) < 0.0f ? -1.0f : 1.0f;
+                }
             }
-            else {         //   
-                OutputImage[idx] = 0.0f;
-                OutputImage[idx + 1] = 0.0f;
-                OutputImage[idx + 2] = 0.0f;
+            for (int i = 0; i < MaxSteps && (active[0] || active[1] || active[2] || active[3]); ++i) {
+                for (int l = 0; l < 4; ++l) {
+                    if (!active[l]) continue;
+                    vec3 p = rays[idx[g + l]].origin + rays[idx[g + l]].direction * t[l];
+                    ox[l] = p.x;
+                    oy[l] = p.y;
+                    oz[l] = p.z;
+                }
+                _mm_store_ps(d, distance(Float4(_mm_load_ps(ox)), Float4(_mm_load_ps(oy)), Float4(_mm_load_ps(oz))).v);
+                for (int l = 0; l < 4; ++l) {
+                    if (!active[l]) continue;
+                    int k = idx[g + l];
+                    if (march(sign[l] * d[l], t[l], step[l], prev[l], omega[l])) {
+                        active[l] = false;
+                        if (t[l] > 0.001f && (tNearest[k] < 0.0f || t[l] < tNearest[k])) tNearest[k] = t[l];
+                    }
+                    else if (t[l] > t1[l]) active[l] = false;
+                }
             }
         }
     }
+
+    // ߽  (ü 4)  
+    virtual vec3 normal(const vec3& p) const override {
+        const float h = 1e-4f;
+        vec3 k0(1, -1, -1), k1(-1, -1, 1), k2(-1, 1, -1), k3(1, 1, 1);
+        auto f = [&](const vec3& q) { return distance(q.x, q.y, q.z); };
+        vec3 g = k0 * f(p + k0 * h) + k1 * f(p + k1 * h) + k2 * f(p + k2 * h) + k3 * f(p + k3 * h);
+        float len = length(g);
+        return len > 0.0f ? g / len : vec3(0.0f, 1.0f, 0.0f);
+    }
+    virtual bool bounds(vec3& lo, vec3& hi) const override {
+        lo = boxLo + position;
+        hi = boxHi + position;
+        return true;
+    }
+    virtual void write(std::ostream& os) const override {
+        static const char* names[] = { "sphere", "box", "torus", "mandelbulb", "union", "intersect", "subtract", "smooth" };
+        static const int args[] = { 4, 6, 5, 4, 0, 0, 0, 1 };
+        os << "sdf " << position.x << ' ' << position.y << ' ' << position.z;
+        for (const Op& op : program) {
+            os << ' ' << names[op.code];
+            for (int k = 0; k < args[op.code]; ++k) os << ' ' << op.a[k];
+        }
+        os << '\n';
+    }
+    virtual Surface* clone() const override { return new SDFSurface(*this); }
+    virtual void moveTo(const vec3& p) override { position = p; }
+
+private:
+    //     [t0, t1]
+    bool clip(const Ray& ray, float& t0, float& t1) const {
+        vec3 lo = boxLo + position - vec3(1e-3f), hi = boxHi + position + vec3(1e-3f);
+        t0 = 0.001f;
+        t1 = FLT_MAX;
+        for (int a = 0; a < 3; ++a) {
+            float inv = 1.0f / ray.direction[a];
+            float ta = (lo[a] - ray.origin[a]) * inv, tb = (hi[a] - ray.origin[a]) * inv;
+            t0 = std::max(t0, std::min(ta, tb));
+            t1 = std::min(t1, std::max(ta, tb));
+        }
+        return t0 <= t1;
+    }
+
+    // ȭ    ܰ (Keinert et al.): Ÿ omega踸ŭ ư,
+    // յ  ġ  ģ ̹Ƿ ǵư omega = 1 , ǥ鿡  true
+    static bool march(float signedRadius, float& t, float& step, float& prevRadius, float& omega) {
+        float radius = fabsf(signedRadius);
+        bool overshoot = omega > 1.0f && radius + prevRadius < step;
+        if (overshoot) {
+            step -= omega * step;
+            omega = 1.0f;
+        }
+        else {
+            if (radius < 1e-4f * (1.0f + t)) return true;
+            step = signedRadius * omega;
+        }
+        prevRadius = radius;
+        t += step;
+        return false;
+    }
+
+    // 8 Mandelbulb Ÿ  (߽  ǥ, scale)
+    static float mandelbulb(float x, float y, float z, float scale) {
+        vec3 c = vec3(x, y, z) / scale, p = c;
+        float dr = 1.0f, r = 0.0f;
+        for (int i = 0; i < 8; ++i) {
+            r = length(p);
+            if (r > 2.0f || r < 1e-6f) break;
+            float theta = acosf(clamp(p.z / r, -1.0f, 1.0f)) * 8.0f;
+            float phi = atan2f(p.y, p.x) * 8.0f;
+            float r7 = r * r * r * r * r * r * r;
+            dr = 8.0f * r7 * dr + 1.0f;
+            p = (r7 * r) * vec3(sinf(theta) * cosf(phi), sinf(phi) * sinf(theta), cosf(theta)) + c;
+        }
+        if (r < 1e-6f) return -1e-3f * scale;
+        return 0.5f * logf(r) * r / dr * scale;
+    }
+    // θ Į 
+    static Float4 mandelbulb(Float4 x, Float4 y, Float4 z, float scale) {
+        alignas(16) float xs[4], ys[4], zs[4], d[4];
+        _mm_store_ps(xs, x.v);
+        _mm_store_ps(ys, y.v);
+        _mm_store_ps(zs, z.v);
+        for (int l = 0; l < 4; ++l) d[l] = mandelbulb(xs[l], ys[l], zs[l], scale);
+        return _mm_load_ps(d);
+    }
+};
+
+// hitBox(): ray  [lo, hi] slab ˻ (inv  ), tMax > 0̸ (0, tMax) ȿ
+// BVH, CurveSet, ParticleCloud Ʈ Բ  (RayPacketSIMD::hitBoxes()   8ξ)
+bool hitBox(const Ray& ray, const vec3& inv, const vec3& lo, const vec3& hi, float tMax) {
+    vec3 t0 = (lo - ray.origin) * inv;
+    vec3 t1 = (hi - ray.origin) * inv;
+    vec3 tn = min(t0, t1), tf = max(t0, t1);
+    float enter = max(max(tn.x, tn.y), tn.z);
+    float exit = min(min(tf.x, tf.y), tf.z);
+    if (tMax > 0.0f) exit = min(exit, tMax);
+    return enter <= exit && exit > 0.0f;
 }
 
-// --------------------------
-// GLFW ݹ   Լ
-// --------------------------
-void resize_callback(GLFWwindow*, int nw, int nh) {
-    Width = nw;
-    Height = nh;
-    glViewport(0, 0, nw, nh);
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(0.0, Width, 0.0, Height, 1.0, -1.0);
-    OutputImage.reserve(Width * Height * 3);
-    render();
+// RayPacketSIMD: ray (ִ 32) ,  ,  ˻ tMax к 迭  (   ray ݺ)
+// ڿ slab ˻縦 8ξ, İ  (min/max   ) ray ϳ ϴ ˻ Ƽ  
+template <typename isa>
+struct RayPacketSIMD {
+    typedef glm::detail::fvecNSIMD<isa, 8> V;
+    alignas(64) float ox[32], oy[32], oz[32];
+    alignas(64) float ix[32], iy[32], iz[32];
+    alignas(64) float tMax[32];
+    int groups;
+
+    // offset   ü ̵ (ParticleCloud)
+    RayPacketSIMD(const Ray* rays, const float* t, int count, const vec3& offset = vec3(0.0f))
+        : groups((count + 7) / 8) {
+        for (int k = 0; k < groups * 8; ++k) {
+            int r = std::min(k, count - 1);
+            vec3 o = rays[r].origin - offset;
+            const vec3& d = rays[r].direction;
+            ox[k] = o.x; oy[k] = o.y; oz[k] = o.z;
+            ix[k] = 1.0f / d.x; iy[k] = 1.0f / d.y; iz[k] = 1.0f / d.z;
+            tMax[k] = t[r];
+        }
+    }
+
+    // mask   [lo, hi] (0, tMax[k]) ȿ ϴ ray (tMax[k] <= 0̸  )
+    uint32_t hitBoxes(uint32_t mask, const vec3& lo, const vec3& hi) const {
+        V zero(0.0f), lx(lo.x), ly(lo.y), lz(lo.z), hx(hi.x), hy(hi.y), hz(hi.z);
+        uint32_t result = 0;
+        for (int g = 0; g < groups; ++g) {
+            if (!((mask >> (8 * g)) & 0xFFu)) continue;
+            V x(ox + 8 * g), y(oy + 8 * g), z(oz + 8 * g);
+            V inx(ix + 8 * g), iny(iy + 8 * g), inz(iz + 8 * g);
+            V tx0 = (lx - x) * inx, ty0 = (ly - y) * iny, tz0 = (lz - z) * inz;
+            V tx1 = (hx - x) * inx, ty1 = (hy - y) * iny, tz1 = (hz - z) * inz;
+            V enter = max(max(min(tx0, tx1), min(ty0, ty1)), min(tz0, tz1));
+            V exit = min(min(max(tx0, tx1), max(ty0, ty1)), max(tz0, tz1));
+            V t(tMax + 8 * g);
+            exit = select(t > zero, min(exit, t), exit);
+            result |= uint32_t(bitmask((enter <= exit) & (exit > zero))) << (8 * g);
+        }
+        return result & mask;
+    }
+};
+
+// ParticleCloud:   ϳ ü  ( Surface vtable  )
+//  Morton   LeafSize  ,     Ʈ  迭  (ڽ 2i+1, 2i+2)
+//      16Ʈ,  ߽ ڱ    16Ʈ (gtc/packing packUnorm1x16)
+//    , ٸ ִ   8Ʈ
+// ȸ  ˻ ParticleKernel ְ,   16   ˻ (  SSE2/AVX2/AVX-512 )
+template <typename isa> struct ParticleKernel;
+
+class ParticleCloud : public Surface {
+public:
+    static const int LeafSize = 16;
+    struct Node {
+        uint16_t lo[3];
+        uint16_t hi[3];
+    };
+    struct Particle {
+        vec3 p;
+        float r;
+        uint64_t key;  // Morton ڵ (Ŀ)
+    };
+    typedef std::vector<Particle, TrackedAllocator<Particle, MEM_SCRATCH> > Input;
+
+    std::string source;  //    ̵  κ (random ... Ǵ file ...)
+    vec3 offset;         //  ü ̵ (ִϸ̼)
+    size_t count = 0;
+    std::vector<Node, TrackedAllocator<Node, MEM_ACCEL> > nodes;
+    std::vector<uint16_t, TrackedAllocator<uint16_t, MEM_GEOMETRY> > qx, qy, qz;
+    std::vector<uint8_t, TrackedAllocator<uint8_t, MEM_GEOMETRY> > qr;  //  ̸  
+
+    ParticleCloud() : offset(0.0f) { }
+
+    //  ϰ ȭؼ Ʈ ,  in 
+    void build(Input& in) {
+        count = in.size();
+        cloudLo = vec3(FLT_MAX);
+        vec3 chi(-FLT_MAX);
+        maxRadius = 0.0f;
+        float minRadius = FLT_MAX;
+        for (const Particle& s : in) {
+            cloudLo = min(cloudLo, s.p - vec3(s.r));
+            chi = max(chi, s.p + vec3(s.r));
+            maxRadius = std::max(maxRadius, s.r);
+            minRadius = std::min(minRadius, s.r);
+        }
+        if (count == 0) cloudLo = chi = vec3(0.0f);
+        //   ȭ  Ŀ ŭ 
+        vec3 pad = (chi - cloudLo) * (2.0f / 65535.0f) + vec3(1e-6f);
+        cloudLo -= pad;
+        chi += pad;
+        nodeScale = max(chi - cloudLo, vec3(1e-6f)) / 65535.0f;
+        vec3 centerScale = 2097151.0f / max(chi - cloudLo, vec3(1e-6f));
+        for (Particle& s : in) {
+            vec3 q = (s.p - cloudLo) * centerScale;
+            s.key = (spread(uint64_t(q.x)) << 2) | (spread(uint64_t(q.y)) << 1) | spread(uint64_t(q.z));
+        }
+        std::sort(in.begin(), in.end(), [](const Particle& a, const Particle& b) { return a.key < b.key; });
+
+        size_t leaves = std::max<size_t>((count + LeafSize - 1) / LeafSize, 1);
+        leafBase = 1;
+        while (leafBase < leaves) leafBase <<= 1;
+        Node empty = { { 65535, 65535, 65535 }, { 0, 0, 0 } };
+        nodes.assign(2 * leafBase - 1, empty);
+        leafBase -= 1;
+        sharedRadius = (minRadius == maxRadius);
+        qx.assign(leaves * LeafSize, 0);
+        qy.assign(leaves * LeafSize, 0);
+        qz.assign(leaves * LeafSize, 0);
+        if (sharedRadius) std::vector<uint8_t, TrackedAllocator<uint8_t, MEM_GEOMETRY> >().swap(qr);
+        else qr.assign(leaves * LeafSize, 0);
+
+        for (size_t j = 0; j * LeafSize < count; ++j) {
+            size_t first = j * LeafSize, n = std::min<size_t>(LeafSize, count - first);
+            // ȭ(ø)   踦 ϰ ٱ ȭ
+            vec3 lo(FLT_MAX), hi(-FLT_MAX);
+            for (size_t k = first; k < first + n; ++k) {
+                float r = in[k].r;
+                if (!sharedRadius) {
+                    qr[k] = uint8_t(std::min(ceilf(r / maxRadius * 255.0f), 255.0f));
+                    r = unpackUnorm1x8(qr[k]) * maxRadius;
+                }
+                lo = min(lo, in[k].p - vec3(r));
+                hi = max(hi, in[k].p + vec3(r));
+            }
+            vec3 step = (hi - lo) / 65535.0f;
+            lo -= step;
+            hi += step;
+            Node& node = nodes[leafBase + j];
+            for (int a = 0; a < 3; ++a) {
+                node.lo[a] = uint16_t(clamp(floorf((lo[a] - cloudLo[a]) / nodeScale[a]), 0.0f, 65535.0f));
+                node.hi[a] = uint16_t(clamp(ceilf((hi[a] - cloudLo[a]) / nodeScale[a]), 0.0f, 65535.0f));
+            }
+            vec3 leafLo, leafScale;
+            decodeNode(leafBase + j, leafLo, leafScale);
+            for (size_t k = first; k < first + n; ++k) {
+                vec3 u = clamp((in[k].p - leafLo) / (leafScale * 65535.0f), vec3(0.0f), vec3(1.0f));
+                qx[k] = packUnorm1x16(u.x);
+                qy[k] = packUnorm1x16(u.y);
+                qz[k] = packUnorm1x16(u.z);
+            }
+        }
+        for (size_t i = leafBase; i-- > 0;) {
+            const Node& l = nodes[2 * i + 1];
+            const Node& r = nodes[2 * i + 2];
+            for (int a = 0; a < 3; ++a) {
+                nodes[i].lo[a] = std::min(l.lo[a], r.lo[a]);
+                nodes[i].hi[a] = std::max(l.hi[a], r.hi[a]);
+            }
+        }
+        if (sharedRadius) maxRadius = count ? minRadius : 0.0f;
+        Input().swap(in);
+    }
+
+    // Ʈ  ͸ ģ ޸
+    size_t bytes() const {
+        return nodes.size() * sizeof(Node) + (qx.size() + qy.size() + qz.size()) * sizeof(uint16_t) + qr.size();
+    }
+
+    virtual float intersect(const Ray& ray) const override {
+        float tNearest = -1.0f;
+        size_t hit;
+        traverse(ray, tNearest, hit);
+        return tNearest;
+    }
+    virtual void intersectPacket(const Ray* rays, uint32_t mask, float* tNearest) const override;
+
+    //  p   ǥ   Ʈ ã   
+    virtual vec3 normal(const vec3& p) const override {
+        vec3 q = p - offset;
+        float best = FLT_MAX;
+        vec3 center = q - vec3(0.0f, 1.0f, 0.0f);
+        vec3 tol = nodeScale * 2.0f;
+        size_t stack[64];
+        int sp = 0;
+        stack[sp++] = 0;
+        while (sp > 0) {
+            size_t idx = stack[--sp];
+            const Node& node = nodes[idx];
+            bool inside = true;
+            for (int a = 0; a < 3; ++a) {
+                float lo = cloudLo[a] + node.lo[a] * nodeScale[a], hi = cloudLo[a] + node.hi[a] * nodeScale[a];
+                inside = inside && q[a] >= lo - tol[a] && q[a] <= hi + tol[a];
+            }
+            if (!inside) continue;
+            if (idx < leafBase) {
+                stack[sp++] = 2 * idx + 1;
+                stack[sp++] = 2 * idx + 2;
+                continue;
+            }
+            vec3 leafLo, leafScale;
+            decodeNode(idx, leafLo, leafScale);
+            size_t first = (idx - leafBase) * LeafSize, n = std::min<size_t>(LeafSize, count - first);
+            for (size_t k = first; k < first + n; ++k) {
+                vec3 c = leafLo + vec3(qx[k], qy[k], qz[k]) * leafScale;
+                float err = fabsf(length(q - c) - particleRadius(k));
+                if (err < best) {
+                    best = err;
+                    center = c;
+                }
+            }
+        }
+        return normalize(q - center);
+    }
+
+    virtual bool bounds(vec3& lo, vec3& hi) const override {
+        if (count == 0) return false;
+        vec3 scale;
+        decodeNode(0, lo, scale);
+        hi = lo + scale * 65535.0f + offset;
+        lo += offset;
+        return true;
+    }
+    virtual void write(std::ostream& os) const override {
+        os << "particles " << offset.x << ' ' << offset.y << ' ' << offset.z << ' ' << source << '\n';
+    }
+    virtual Surface* clone() const override { return new ParticleCloud(*this); }
+    virtual void moveTo(const vec3& p) override { offset = p; }
+
+private:
+    template <typename isa> friend struct ParticleKernel;
+
+    vec3 cloudLo = vec3(0.0f), nodeScale = vec3(1.0f);
+    float maxRadius = 0.0f;  //  ̸  
+    bool sharedRadius = true;
+    size_t leafBase = 0;     // ù   ε
+
+    // 21Ʈ  Ʈ ̿ 0    (Morton ڵ)
+    static uint64_t spread(uint64_t v) {
+        v = std::min<uint64_t>(v, 0x1FFFFF);
+        v = (v | v << 32) & 0x1F00000000FFFFULL;
+        v = (v | v << 16) & 0x1F0000FF0000FFULL;
+        v = (v | v << 8) & 0x100F00F00F00F00FULL;
+        v = (v | v << 4) & 0x10C30C30C30C30C3ULL;
+        v = (v | v << 2) & 0x1249249249249249ULL;
+        return v;
+    }
+    void decodeNode(size_t idx, vec3& lo, vec3& scale) const {
+        const Node& node = nodes[idx];
+        lo = cloudLo + vec3(node.lo[0], node.lo[1], node.lo[2]) * nodeScale;
+        vec3 hi = cloudLo + vec3(node.hi[0], node.hi[1], node.hi[2]) * nodeScale;
+        scale = (hi - lo) / 65535.0f;
+    }
+    float particleRadius(size_t k) const {
+        return sharedRadius ? maxRadius : unpackUnorm1x8(qr[k]) * maxRadius;
+    }
+
+    //  ڽĺ 湮ϸ tNearest   ã
+    void traverse(const Ray& worldRay, float& tNearest, size_t& hit) const;
+    //  ڽ ߽     ( 湮 ڽ   )
+    int nearAxis(size_t idx) const {
+        const Node& l = nodes[2 * idx + 1];
+        const Node& r = nodes[2 * idx + 2];
+        int axis = 0;
+        float best = -1.0f;
+        for (int a = 0; a < 3; ++a) {
+            float d = fabsf((float(r.lo[a]) + r.hi[a] - l.lo[a] - l.hi[a]) * nodeScale[a]);
+            if (d > best) { best = d; axis = a; }
+        }
+        return axis;
+    }
+    bool hitNode(const Ray& ray, const vec3& inv, size_t idx, float tMax) const {
+        const Node& node = nodes[idx];
+        if (node.lo[0] > node.hi[0]) return false;  //  
+        vec3 lo = cloudLo + vec3(node.lo[0], node.lo[1], node.lo[2]) * nodeScale;
+        vec3 hi = cloudLo + vec3(node.hi[0], node.hi[1], node.hi[2]) * nodeScale;
+        return hitBox(ray, inv, lo, hi, tMax);
+    }
+
+};
+
+// ParticleCloud ȸ ɾ պ  (simdDispatch    )
+//   LeafSize fvec16SIMD   ˻ ( ȭǾ Ƿ t = -b -+ sqrt(b^2 - c))
+template <typename isa>
+struct ParticleKernel {
+    typedef glm::detail::fvecNSIMD<isa, ParticleCloud::LeafSize> V;
+
+    static void run(const ParticleCloud& cloud, const Ray& worldRay, float& tNearest, size_t& hit) {
+        Ray ray = worldRay;
+        ray.origin -= cloud.offset;
+        vec3 inv = 1.0f / ray.direction;
+        size_t stack[64];
+        int sp = 0;
+        stack[sp++] = 0;
+        while (sp > 0) {
+            size_t idx = stack[--sp];
+            if (!cloud.hitNode(ray, inv, idx, tNearest)) continue;
+            if (idx < cloud.leafBase) {
+                bool flip = ray.direction[cloud.nearAxis(idx)] < 0.0f;
+                stack[sp++] = flip ? 2 * idx + 1 : 2 * idx + 2;
+                stack[sp++] = flip ? 2 * idx + 2 : 2 * idx + 1;
+                continue;
+            }
+            leaf(cloud, ray, idx, tNearest, hit);
+        }
+    }
+
+    // ray :    а ڿ ϴ ray ũ Ʒ,  ray leaf()
+    static void run(const ParticleCloud& cloud, const Ray* rays, uint32_t mask, float* tNearest) {
+        int count = 0;
+        for (uint32_t m = mask; m; m >>= 1) ++count;
+        RayPacketSIMD<isa> p(rays, tNearest, count, cloud.offset);
+        size_t stack[64];
+        uint32_t masks[64];
+        int sp = 0;
+        stack[sp] = 0;
+        masks[sp++] = mask;
+        while (sp > 0) {
+            --sp;
+            size_t idx = stack[sp];
+            const ParticleCloud::Node& node = cloud.nodes[idx];
+            if (node.lo[0] > node.hi[0]) continue;  //  
+            vec3 lo = cloud.cloudLo + vec3(node.lo[0], node.lo[1], node.lo[2]) * cloud.nodeScale;
+            vec3 hi = cloud.cloudLo + vec3(node.hi[0], node.hi[1], node.hi[2]) * cloud.nodeScale;
+            uint32_t active = p.hitBoxes(masks[sp], lo, hi);
+            if (!active) continue;
+            if (idx < cloud.leafBase) {
+                int first = 0;
+                while (!(active & (1u << first))) ++first;
+                bool flip = rays[first].direction[cloud.nearAxis(idx)] < 0.0f;
+                stack[sp] = flip ? 2 * idx + 1 : 2 * idx + 2;
+                masks[sp++] = active;
+                stack[sp] = flip ? 2 * idx + 2 : 2 * idx + 1;
+                masks[sp++] = active;
+                continue;
+            }
+            for (int k = 0; k < count; ++k) {
+                if (!(active & (1u << k))) continue;
+                Ray ray = rays[k];
+                ray.origin -= cloud.offset;
+                size_t hit;
+                leaf(cloud, ray, idx, p.tMax[k], hit);
+            }
+        }
+        for (int k = 0; k < count; ++k)
+            if (mask & (1u << k)) tNearest[k] = p.tMax[k];
+    }
+
+    static void leaf(const ParticleCloud& cloud, const Ray& ray, size_t idx, float& tNearest, size_t& hit) {
+        const int N = ParticleCloud::LeafSize;
+        vec3 leafLo, leafScale;
+        cloud.decodeNode(idx, leafLo, leafScale);
+        size_t first = (idx - cloud.leafBase) * N, n = std::min<size_t>(N, cloud.count - first);
+        // ȭ ߽ɰ  float ǯ ( LeafSize ä Ƿ   )
+        alignas(64) float fx[N], fy[N], fz[N], fr[N];
+        for (int l = 0; l < N; ++l) {
+            fx[l] = cloud.qx[first + l];
+            fy[l] = cloud.qy[first + l];
+            fz[l] = cloud.qz[first + l];
+        }
+        V r(cloud.maxRadius);
+        if (!cloud.sharedRadius) {
+            for (int l = 0; l < N; ++l) fr[l] = cloud.qr[first + l];
+            r = V(fr) * (cloud.maxRadius / 255.0f);
+        }
+        V px = V(ray.origin.x - leafLo.x) - V(fx) * leafScale.x;
+        V py = V(ray.origin.y - leafLo.y) - V(fy) * leafScale.y;
+        V pz = V(ray.origin.z - leafLo.z) - V(fz) * leafScale.z;
+        V b = px * ray.direction.x + py * ray.direction.y + pz * ray.direction.z;
+        // b^2 - c  r^2 - |p - b d|^2: ָ ִ   b^2 c    ⸦ 
+        V ex = px - b * ray.direction.x, ey = py - b * ray.direction.y, ez = pz - b * ray.direction.z;
+        V disc = r * r - (ex * ex + ey * ey + ez * ez);
+        V zero(0.0f), eps(0.001f);
+        V root = sqrt(max(disc, zero));
+        V t1 = -b - root, t2 = root - b;
+        V t = select(t1 > eps, t1, t2);
+        unsigned mask = bitmask((disc >= zero) & (t > eps)) & ((1u << n) - 1u);
+        if (!mask) return;
+        alignas(64) float ts[N];
+        t.store(ts);
+        for (int l = 0; mask; ++l, mask >>= 1) {
+            if ((mask & 1) && (tNearest < 0.0f || ts[l] < tNearest)) {
+                tNearest = ts[l];
+                hit = first + l;
+            }
+        }
+    }
+};
+
+void ParticleCloud::traverse(const Ray& worldRay, float& tNearest, size_t& hit) const {
+    if (count == 0) return;
+    simdDispatch<ParticleKernel>(*this, worldRay, tNearest, hit);
 }
 
-int main(int argc, char* argv[]) {
-    GLFWwindow* window;
-    if (!glfwInit()) return -1;
+void ParticleCloud::intersectPacket(const Ray* rays, uint32_t mask, float* tNearest) const {
+    if (count == 0 || !mask) return;
+    simdDispatch<ParticleKernel>(*this, rays, mask, tNearest);
+}
 
-    window = glfwCreateWindow(Width, Height, "Simple Ray Tracer", NULL, NULL);
-    if (!window) {
-        glfwTerminate();
-        return -1;
+// "particles x y z random count seed x0 y0 z0 x1 y1 z1 rmin rmax" ( ȿ ϰ, rmin = rmax  )
+// "particles x y z file <> radius" (radius > 0̸ float32 xyz ڵ, 0̸ xyzr ڵ)
+// ڿ "rotate ax ay az degrees", "scale s" ̸  ߽ ü   ġ ȯ ( s)
+bool loadParticles(std::istream& ls, ParticleCloud& cloud) {
+    std::string kind;
+    if (!(ls >> kind)) return false;
+    ParticleCloud::Input in;
+    std::ostringstream src;
+    if (kind == "random") {
+        size_t n;
+        uint64_t seed;
+        vec3 lo, hi;
+        float rmin, rmax;
+        if (!(ls >> n >> seed >> lo.x >> lo.y >> lo.z >> hi.x >> hi.y >> hi.z >> rmin >> rmax) || rmin <= 0.0f || rmax < rmin)
+            return false;
+        if (!memTracker.fits(n * sizeof(ParticleCloud::Particle))) {
+            std::cerr << "particles: " << n << " particles do not fit in the memory budget" << std::endl;
+            return false;
+        }
+        src << "random " << n << ' ' << seed << ' ' << lo.x << ' ' << lo.y << ' ' << lo.z << ' '
+            << hi.x << ' ' << hi.y << ' ' << hi.z << ' ' << rmin << ' ' << rmax;
+        Pcg32 rng(seed, 0x9e3779b97f4a7c15ULL);
+        in.resize(n);
+        for (ParticleCloud::Particle& s : in) {
+            s.p = lo + (hi - lo) * vec3(rng.nextFloat(), rng.nextFloat(), rng.nextFloat());
+            s.r = (rmin == rmax) ? rmin : rmin + (rmax - rmin) * rng.nextFloat();
+        }
+    }
+    else if (kind == "file") {
+        std::string path;
+        float radius;
+        if (!(ls >> path >> radius) || radius < 0.0f) return false;
+        std::ifstream f(path.c_str(), std::ios::binary);
+        if (!f) {
+            std::cerr << "particles: cannot open " << path << std::endl;
+            return false;
+        }
+        src << "file " << path << ' ' << radius;
+        int stride = radius > 0.0f ? 3 : 4;
+        // ڵ   ũ Ƿ ̸  ξ push_back Ҵϸ    ʰ 
+        f.seekg(0, std::ios::end);
+        size_t records = size_t(std::streamoff(f.tellg())) / (stride * sizeof(float));
+        f.seekg(0, std::ios::beg);
+        if (!memTracker.fits(records * sizeof(ParticleCloud::Particle))) {
+            std::cerr << "particles: " << records << " particles do not fit in the memory budget" << std::endl;
+            return false;
+        }
+        in.reserve(records);
+        float rec[4];
+        while (f.read(reinterpret_cast<char*>(rec), stride * sizeof(float))) {
+            ParticleCloud::Particle s = ParticleCloud::Particle();
+            s.p = vec3(rec[0], rec[1], rec[2]);
+            s.r = radius > 0.0f ? radius : rec[3];
+            if (s.r > 0.0f) in.push_back(s);
+        }
     }
+    else return false;
+    vec3 axis(0.0f, 1.0f, 0.0f);
+    float degrees = 0.0f, factor = 1.0f;
+    std::string opt;
+    while (ls >> opt) {
+        if (opt == "rotate" && (ls >> axis.x >> axis.y >> axis.z >> degrees) && length(axis) > 0.0f)
+            src << " rotate " << axis.x << ' ' << axis.y << ' ' << axis.z << ' ' << degrees;
+        else if (opt == "scale" && (ls >> factor) && factor > 0.0f)
+            src << " scale " << factor;
+        else return false;
+    }
+    if ((degrees != 0.0f || factor != 1.0f) && !in.empty()) {
+        // Particle ڵ  p stride ǳʶٸ ڸ ȯ
+        // (GLM_FORCE_RADIANS Ƿ  glm rotate    )
+        mat4 m = rotate(mat4(1.0f), degrees, normalize(axis)) * scale(mat4(1.0f), vec3(factor));
+        transformPoints(m, &in[0].p, in.size(), &in[0].p, sizeof(ParticleCloud::Particle));
+        for (ParticleCloud::Particle& s : in) s.r *= factor;
+    }
+    cloud.source = src.str();
+    cloud.build(in);
+    std::cout << "particles: " << cloud.count << " spheres, " << cloud.bytes() << " bytes ("
+              << double(cloud.bytes()) / std::max<size_t>(cloud.count, 1) << " bytes per sphere)" << std::endl;
+    return true;
+}
 
-    glfwMakeContextCurrent(window);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glPixelStorei(GL_PACK_ALIGNMENT, 1);
-    glfwSetFramebufferSizeCallback(window, resize_callback);
+// Medium:     ұ  (Ȱ, ),  Լ 漺
+// е res^3 ڸ Ｑ , Ҹ  = sigma * е,   = albedo * Ҹ 
+// ڴ seed    (simplex fBm ΰ  κ  )
+//   ø Block^3  ִ Ҹ (majorant) ڸ 3D-DDA 󰡸 ĭ majorant 
+class Medium {
+public:
+    static const int Block = 8;
+    vec3 lo, hi;
+    int res;
+    float sigma;
+    vec3 albedo;
+    uint32_t seed;
+    std::vector<float, TrackedAllocator<float, MEM_TEXTURE> > density;   // res^3, x   
+    std::vector<float, TrackedAllocator<float, MEM_TEXTURE> > majorant;  // cells^3, ĭ  ִ Ҹ 
+    int cells;
 
-    // ī޶: eye = (0, 0, 0),  : l = -0.1, r = 0.1, b = -0.1, t = 0.1, d = 0.1
-    camera = new Camera(vec3(0.0f, 0.0f, 0.0f), -0.1f, 0.1f, -0.1f, 0.1f, 0.1f);
-    scene = new Scene();
-
-    //  :
-    //  P: y = -2
-    scene->objects.push_back(new Plane(-2.0f));
-    // Sphere S1: center (-4, 0, -7), radius 1
-    scene->objects.push_back(new Sphere(vec3(-4.0f, 0.0f, -7.0f), 1.0f));
-    // Sphere S2: center (0, 0, -7), radius 2
-    scene->objects.push_back(new Sphere(vec3(0.0f, 0.0f, -7.0f), 2.0f));
-    // Sphere S3: center (4, 0, -7), radius 1
-    scene->objects.push_back(new Sphere(vec3(4.0f, 0.0f, -7.0f), 1.0f));
+    Medium(const vec3& lo_, const vec3& hi_, int res_, float sigma_, const vec3& albedo_, uint32_t seed_)
+        : lo(lo_), hi(hi_), res(std::max(res_, 2)), sigma(sigma_), albedo(albedo_), seed(seed_) {
+        generate();
+        buildMajorants();
+    }
 
-    resize_callback(NULL, Width, Height);
+    void write(std::ostream& os) const {
+        os << "medium " << lo.x << ' ' << lo.y << ' ' << lo.z << ' ' << hi.x << ' ' << hi.y << ' ' << hi.z << ' '
+           << res << ' ' << sigma << ' ' << albedo.r << ' ' << albedo.g << ' ' << albedo.b << ' ' << seed << '\n';
+    }
 
-    while (!glfwWindowShouldClose(window)) {
-        glClear(GL_COLOR_BUFFER_BIT);
-        glDrawPixels(Width, Height, GL_RGB, GL_FLOAT, &OutputImage[0]);
-        glfwSwapBuffers(window);
+    //  p Ҹ  (  0)
+    float sigmaT(const vec3& p) const {
+        vec3 g = (p - lo) / (hi - lo) * float(res) - 0.5f;
+        vec3 f = floor(g);
+        int x = int(f.x), y = int(f.y), z = int(f.z);
+        vec3 w = g - f;
+        float sum = 0.0f;
+        for (int c = 0; c < 8; ++c) {
+            int xi = x + (c & 1), yi = y + ((c >> 1) & 1), zi = z + (c >> 2);
+            if (xi < 0 || yi < 0 || zi < 0 || xi >= res || yi >= res || zi >= res) continue;
+            float wc = ((c & 1) ? w.x : 1.0f - w.x) * (((c >> 1) & 1) ? w.y : 1.0f - w.y) * ((c >> 2) ? w.z : 1.0f - w.z);
+            sum += wc * density[(size_t(zi) * res + yi) * res + xi];
+        }
+        return sigma * sum;
+    }
+
+    // ray  ȿ ִ  [0, tMax] ڸ, ġ  false
+    bool clip(const Ray& ray, float tMax, float& t0, float& t1) const {
+        t0 = 0.0f;
+        t1 = tMax;
+        for (int a = 0; a < 3; ++a) {
+            float inv = 1.0f / ray.direction[a];
+            float ta = (lo[a] - ray.origin[a]) * inv, tb = (hi[a] - ray.origin[a]) * inv;
+            t0 = std::max(t0, std::min(ta, tb));
+            t1 = std::min(t1, std::max(ta, tb));
+        }
+        return t0 < t1;
+    }
+
+    // [0, tMax]  majorant ĭ 3D-DDA  湮, fn(ĭ  t, ĭ  t, majorant) false 
+    template <class F>
+    void traverse(const Ray& ray, float tMax, F fn) const {
+        float t0, t1;
+        if (!clip(ray, tMax, t0, t1)) return;
+        vec3 cellSize = (hi - lo) / float(cells);
+        vec3 start = (ray.origin + ray.direction * t0 - lo) / cellSize;
+        int cell[3], step[3];
+        float next[3], delta[3];
+        for (int a = 0; a < 3; ++a) {
+            cell[a] = clamp(int(start[a]), 0, cells - 1);
+            float d = ray.direction[a];
+            step[a] = d > 0.0f ? 1 : -1;
+            delta[a] = (d != 0.0f) ? fabsf(cellSize[a] / d) : FLT_MAX;
+            float boundary = lo[a] + (cell[a] + (d > 0.0f ? 1 : 0)) * cellSize[a];
+            next[a] = (d != 0.0f) ? (boundary - ray.origin[a]) / d : FLT_MAX;
+        }
+        float t = t0;
+        while (t < t1) {
+            int a = (next[0] < next[1]) ? (next[0] < next[2] ? 0 : 2) : (next[1] < next[2] ? 1 : 2);
+            float exit = std::min(next[a], t1);
+            if (!fn(t, exit, majorant[(size_t(cell[2]) * cells + cell[1]) * cells + cell[0]])) return;
+            t = exit;
+            cell[a] += step[a];
+            if (cell[a] < 0 || cell[a] >= cells) return;
+            next[a] += delta[a];
+        }
+    }
+
+    // Ÿ : [0, tMax] ȿ  浹 Ͼ true  Ÿ t
+    bool sampleCollision(const Ray& ray, float tMax, Pcg32& rng, float& t) const {
+        bool collided = false;
+        traverse(ray, tMax, [&](float enter, float exit, float maj) {
+            if (maj <= 0.0f) return true;  //  ĭ   ǳʶ
+            for (float s = enter;;) {
+                s -= logf(1.0f - rng.nextFloat()) / maj;
+                if (s >= exit) return true;
+                if (rng.nextFloat() * maj < sigmaT(ray.origin + ray.direction * s)) {
+                    t = s;
+                    collided = true;
+                    return false;
+                }
+            }
+        });
+        return collided;
+    }
+
+    //   [0, tMax]   , ۾ þ 귿
+    float transmittance(const Ray& ray, float tMax, Pcg32& rng) const {
+        float T = 1.0f;
+        traverse(ray, tMax, [&](float enter, float exit, float maj) {
+            if (maj <= 0.0f) return true;
+            for (float s = enter;;) {
+                s -= logf(1.0f - rng.nextFloat()) / maj;
+                if (s >= exit) return true;
+                T *= 1.0f - sigmaT(ray.origin + ray.direction * s) / maj;
+                if (T < 0.1f) {
+                    if (rng.nextFloat() >= T) {
+                        T = 0.0f;
+                        return false;
+                    }
+                    T = 1.0f;
+                }
+            }
+        });
+        return T;
+    }
+
+private:
+    void generate() {
+        density.assign(size_t(res) * res * res, 0.0f);
+        vec3 offset(float(seed % 1000) * 17.0f, float(seed / 1000 % 1000) * 31.0f, 0.0f);
+        for (int z = 0; z < res; ++z)
+            for (int y = 0; y < res; ++y)
+                for (int x = 0; x < res; ++x) {
+                    vec3 u = (vec3(float(x), float(y), float(z)) + 0.5f) / float(res);
+                    float n = 0.0f, amp = 0.5f;
+                    vec3 q = u * 3.0f + offset;
+                    for (int o = 0; o < 4; ++o, amp *= 0.5f, q *= 2.0f)
+                        n += amp * simplex(q);
+                    // ڸ  ٿ    ʰ 
+                    float falloff = 1.0f - length(u - 0.5f) * 2.0f;
+                    density[(size_t(z) * res + y) * res + x] = std::max(0.0f, n + falloff - 0.6f) * 2.5f;
+                }
+    }
+
+    // ĭ majorant  ĭ   ĭ ٱ ̿ ִ (Ｑ   )
+    void buildMajorants() {
+        cells = (res + Block - 1) / Block;
+        majorant.assign(size_t(cells) * cells * cells, 0.0f);
+        for (int z = 0; z < res; ++z)
+            for (int y = 0; y < res; ++y)
+                for (int x = 0; x < res; ++x) {
+                    float d = sigma * density[(size_t(z) * res + y) * res + x];
+                    if (d <= 0.0f) continue;
+                    for (int c = 0; c < 8; ++c) {
+                        int cx = clamp((x + ((c & 1) ? 1 : -1)) / Block, 0, cells - 1);
+                        int cy = clamp((y + ((c & 2) ? 1 : -1)) / Block, 0, cells - 1);
+                        int cz = clamp((z + ((c & 4) ? 1 : -1)) / Block, 0, cells - 1);
+                        float& m = majorant[(size_t(cz) * cells + cy) * cells + cx];
+                        m = std::max(m, d);
+                    }
+                    float& m = majorant[(size_t(z / Block) * cells + y / Block) * cells + x / Block];
+                    m = std::max(m, d);
+                }
+    }
+};
+
+// Camera:  ġ   ̿ ȼ ϴ ray 
+// axisU/V/W ī޶   (⺻  x, y, z -z  ٶ)
+class Camera {
+public:
+    vec3 eye;
+    float l, r, b, t, d;
+    vec3 axisU, axisV, axisW;
+    Camera(const vec3& e, float l_, float r_, float b_, float t_, float d_)
+        : eye(e), l(l_), r(r_), b(b_), t(t_), d(d_),
+          axisU(1.0f, 0.0f, 0.0f), axisV(0.0f, 1.0f, 0.0f), axisW(0.0f, 0.0f, 1.0f) { }
+    // eye target ٶ󺸵  
+    void lookAt(const vec3& target, const vec3& up) {
+        axisW = normalize(eye - target);
+        axisU = normalize(cross(up, axisW));
+        axisV = cross(axisW, axisU);
+    }
+    Ray generateRay(int i, int j, int nx, int ny) const {
+        return generateRay(i + 0.5f, j + 0.5f, nx, ny);
+    }
+    // ȼ   ġ (x, y)  ray, ȼ ߽ (i + 0.5, j + 0.5)
+    Ray generateRay(float x, float y, int nx, int ny) const {
+        float u = l + (r - l) * (x / float(nx));
+        float v = b + (t - b) * (y / float(ny));
+        return Ray(eye, u * axisU + v * axisV - d * axisW);
+    }
+    void write(std::ostream& os) const {
+        os << "camera " << eye.x << ' ' << eye.y << ' ' << eye.z << ' '
+           << l << ' ' << r << ' ' << b << ' ' << t << ' ' << d << '\n';
+        if (axisU != vec3(1.0f, 0.0f, 0.0f) || axisV != vec3(0.0f, 1.0f, 0.0f) || axisW != vec3(0.0f, 0.0f, 1.0f))
+            os << "basis " << axisU.x << ' ' << axisU.y << ' ' << axisU.z << ' '
+               << axisV.x << ' ' << axisV.y << ' ' << axisV.z << ' '
+               << axisW.x << ' ' << axisW.y << ' ' << axisW.z << '\n';
+    }
+};
+
+// --------------------------
+//   (BVH)
+// --------------------------
+
+// BVHNode: ⺻  (32Ʈ), count > 0̸ 
+//   count = -(  + 1), first  ڽ ( ڽ ٷ  )
+struct BVHNode {
+    vec3 lo;
+    int first;
+    vec3 hi;
+    int count;
+};
+
+// CompactBVHNode:    16Ʈ ȭ  (16Ʈ)
+// info: ֻ Ʈ = ,  4Ʈ = ( - 1) Ǵ  ,  27Ʈ = ù ε Ǵ  ڽ
+struct CompactBVHNode {
+    uint16_t lo[3];
+    uint16_t hi[3];
+    uint32_t info;
+};
+
+// PrimBatch: ڳ Ǹ ִ BVH   SoA  SSE 4    ˻
+// BVH::buildNode() ̷ ( , ִ Width) prims 迭  [start, n) Ƿ   first - start
+// İ   Box::intersect(), Disk::intersect() Ƽ  
+struct PrimBatch {
+    static const int Width = 4;
+    static const size_t SlotBytes = 19 * sizeof(float) + 1;  //  ϳ (BVH::build()  )
+    typedef std::vector<float, TrackedAllocator<float, MEM_ACCEL> > Floats;
+    int start = 0;       //   ù prim
+    std::vector<uint8_t, TrackedAllocator<uint8_t, MEM_ACCEL> > kind;  //  PrimKind,     
+    Floats cx, cy, cz;   // ߽
+    Floats hx, hy, hz;   //   ũ
+    Floats rot[9];       //   ( a  c rot[3 * a + c])
+    Floats nx, ny, nz;   //  
+    Floats r2;           //   
+
+    void clear() {
+        start = 0;
+        std::vector<uint8_t, TrackedAllocator<uint8_t, MEM_ACCEL> >().swap(kind);
+        Floats* all[] = { &cx, &cy, &cz, &hx, &hy, &hz, &nx, &ny, &nz, &r2 };
+        for (Floats* f : all) Floats().swap(*f);
+        for (Floats& f : rot) Floats().swap(f);
+    }
+    // prims[first, n)  Կ  (ü  ڿ ȣ),  Width - 1 loadu  ʵ  
+    void set(const std::vector<const Surface*, TrackedAllocator<const Surface*, MEM_ACCEL> >& prims, int first) {
+        size_t used = prims.size() - size_t(first);
+        if (!used) {
+            clear();
+            return;
+        }
+        start = first;
+        size_t padded = used + Width - 1;
+        if (kind.size() != padded) {
+            kind.assign(padded, uint8_t(PRIM_OTHER));
+            Floats* all[] = { &cx, &cy, &cz, &hx, &hy, &hz, &nx, &ny, &nz, &r2 };
+            for (Floats* f : all) f->assign(padded, 0.0f);
+            for (Floats& f : rot) f.assign(padded, 0.0f);
+        }
+        for (size_t k = 0; k < used; ++k) {
+            const Surface* p = prims[start + k];
+            kind[k] = uint8_t(p->primKind());
+            if (kind[k] == PRIM_BOX) {
+                const Box* b = static_cast<const Box*>(p);
+                cx[k] = b->center.x; cy[k] = b->center.y; cz[k] = b->center.z;
+                hx[k] = b->half.x; hy[k] = b->half.y; hz[k] = b->half.z;
+                for (int a = 0; a < 3; ++a)
+                    for (int c = 0; c < 3; ++c) rot[3 * a + c][k] = b->rot[a][c];
+            }
+            else {
+                const Disk* d = static_cast<const Disk*>(p);
+                cx[k] = d->center.x; cy[k] = d->center.y; cz[k] = d->center.z;
+                nx[k] = d->n.x; ny[k] = d->n.y; nz[k] = d->n.z;
+                r2[k] = d->radius * d->radius;
+            }
+        }
+    }
+    // first ϴ     , ƴϸ PRIM_OTHER
+    PrimKind leafKind(int first) const {
+        return (kind.empty() || first < start) ? PRIM_OTHER : PrimKind(kind[first - start]);
+    }
+    //   prims[first, first + count) t t[]    ũ 
+    int intersect(PrimKind k, int first, int count, const Ray& ray, float* t) const {
+        int g = first - start;
+        int mask = (k == PRIM_BOX) ? boxes(g, ray, t) : disks(g, ray, t);
+        return mask & ((1 << count) - 1);
+    }
+
+private:
+    int boxes(int g, const Ray& ray, float* t) const {
+        __m128 ox = _mm_sub_ps(_mm_set1_ps(ray.origin.x), _mm_loadu_ps(&cx[g]));
+        __m128 oy = _mm_sub_ps(_mm_set1_ps(ray.origin.y), _mm_loadu_ps(&cy[g]));
+        __m128 oz = _mm_sub_ps(_mm_set1_ps(ray.origin.z), _mm_loadu_ps(&cz[g]));
+        __m128 axes[9], halves[3] = { _mm_loadu_ps(&hx[g]), _mm_loadu_ps(&hy[g]), _mm_loadu_ps(&hz[g]) };
+        for (int c = 0; c < 9; ++c) axes[c] = _mm_loadu_ps(&rot[c][g]);
+        __m128 tw;
+        int mask = boxSlab(ox, oy, oz, _mm_set1_ps(ray.direction.x), _mm_set1_ps(ray.direction.y), _mm_set1_ps(ray.direction.z),
+                           axes, halves, tw);
+        _mm_storeu_ps(t, tw);
+        return mask;
+    }
+    int disks(int g, const Ray& ray, float* t) const {
+        __m128 px = _mm_loadu_ps(&nx[g]), py = _mm_loadu_ps(&ny[g]), pz = _mm_loadu_ps(&nz[g]);
+        __m128 ox = _mm_set1_ps(ray.origin.x), oy = _mm_set1_ps(ray.origin.y), oz = _mm_set1_ps(ray.origin.z);
+        __m128 dx = _mm_set1_ps(ray.direction.x), dy = _mm_set1_ps(ray.direction.y), dz = _mm_set1_ps(ray.direction.z);
+        __m128 ccx = _mm_loadu_ps(&cx[g]), ccy = _mm_loadu_ps(&cy[g]), ccz = _mm_loadu_ps(&cz[g]);
+        __m128 denom = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, dx), _mm_mul_ps(py, dy)), _mm_mul_ps(pz, dz));
+        __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_sub_ps(ccx, ox)), _mm_mul_ps(py, _mm_sub_ps(ccy, oy))),
+                                 _mm_mul_ps(pz, _mm_sub_ps(ccz, oz)));
+        __m128 tw = _mm_div_ps(dist, denom);
+        __m128 qx = _mm_sub_ps(_mm_add_ps(ox, _mm_mul_ps(dx, tw)), ccx);
+        __m128 qy = _mm_sub_ps(_mm_add_ps(oy, _mm_mul_ps(dy, tw)), ccy);
+        __m128 qz = _mm_sub_ps(_mm_add_ps(oz, _mm_mul_ps(dz, tw)), ccz);
+        __m128 q2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)), _mm_mul_ps(qz, qz));
+        __m128 absDenom = _mm_andnot_ps(_mm_set1_ps(-0.0f), denom);
+        _mm_storeu_ps(t, tw);
+        __m128 ok = _mm_and_ps(_mm_cmpge_ps(absDenom, _mm_set1_ps(1e-6f)), _mm_cmpgt_ps(tw, _mm_set1_ps(0.001f)));
+        return _mm_movemask_ps(_mm_and_ps(ok, _mm_cmple_ps(q2, _mm_loadu_ps(&r2[g]))));
+    }
+};
+
+// BVH: 谡 ִ ü鿡    , ޸ 꿡    
+class BVH {
+public:
+    enum Mode { NONE, STANDARD, COMPACT };
+    Mode mode;
+    std::vector<const Surface*, TrackedAllocator<const Surface*, MEM_ACCEL> > prims;
+    std::vector<BVHNode, TrackedAllocator<BVHNode, MEM_ACCEL> > nodes;
+    std::vector<CompactBVHNode, TrackedAllocator<CompactBVHNode, MEM_ACCEL> > compact;
+    vec3 sceneLo, sceneHi, quantScale;
+    PrimBatch batch;  //  /   ˻
+    template <typename isa> friend struct BVHPacketKernel;
+
+    BVH() : mode(NONE) { }
+
+    void clear() {
+        mode = NONE;
+        batch.clear();
+        std::vector<const Surface*, TrackedAllocator<const Surface*, MEM_ACCEL> >().swap(prims);
+        std::vector<BVHNode, TrackedAllocator<BVHNode, MEM_ACCEL> >().swap(nodes);
+        std::vector<CompactBVHNode, TrackedAllocator<CompactBVHNode, MEM_ACCEL> >().swap(compact);
+    }
+
+    //  ȿ    · ,   NONE( Ž)
+    void build(const std::vector<const Surface*>& input) {
+        clear();
+        if (input.empty()) return;
+        size_t n = input.size();
+        size_t maxNodes = 2 * n - 1;
+        std::vector<uint8_t, TrackedAllocator<uint8_t, MEM_SCRATCH> > kinds(n);
+        size_t batched = 0;
+        for (size_t k = 0; k < n; ++k) {
+            kinds[k] = uint8_t(input[k]->primKind());
+            if (kinds[k] != PRIM_OTHER) ++batched;
+        }
+        //   ӽ 迭(,   ) scratch Ƿ Բ , /   ŭ PrimBatch Ե
+        size_t common = n * sizeof(const Surface*) + n * (2 * sizeof(vec3) + 2 * sizeof(int));
+        if (batched) common += (batched + PrimBatch::Width - 1) * PrimBatch::SlotBytes;
+        Mode target;
+        if (memTracker.fits(common + maxNodes * sizeof(BVHNode))) target = STANDARD;
+        // compact  ε 27Ʈ,  ִ 2n - 1̹Ƿ n < 2^26
+        else if (memTracker.fits(common + maxNodes * sizeof(CompactBVHNode)) && n < (1u << 26)) {
+            std::cerr << "[memory] budget too small for standard BVH, using compact nodes" << std::endl;
+            target = COMPACT;
+        }
+        else {
+            std::cerr << "[memory] budget too small for BVH, using linear scan" << std::endl;
+            return;
+        }
+
+        std::vector<vec3, TrackedAllocator<vec3, MEM_SCRATCH> > lo(n), hi(n);
+        std::vector<int, TrackedAllocator<int, MEM_SCRATCH> > order(n), placed(n);
+        sceneLo = vec3(FLT_MAX);
+        sceneHi = vec3(-FLT_MAX);
+        for (size_t k = 0; k < n; ++k) {
+            input[k]->bounds(lo[k], hi[k]);
+            sceneLo = min(sceneLo, lo[k]);
+            sceneHi = max(sceneHi, hi[k]);
+            order[k] = int(k);
+        }
+        quantScale = max(sceneHi - sceneLo, vec3(1e-6f)) / 65535.0f;
+        mode = target;
+        if (mode == STANDARD) nodes.reserve(maxNodes);
+        else compact.reserve(maxNodes);
+        BuildInput in = { lo, hi, order, kinds, placed, 0, int(n) };
+        buildNode(in, 0, int(n));
+
+        prims.resize(n);
+        for (size_t k = 0; k < n; ++k) prims[k] = input[placed[k]];
+        batch.set(prims, in.tail);
+        builtCost = (mode == STANDARD) ? treeCost() : 0.0f;
+    }
+
+    // ü   Ʈ  ״ ΰ 踸 ٽ 
+    // ⺻ 尡 ƴϰų   ǥ     踦  false (ٽ  ʿ)
+    bool refit() {
+        if (mode != STANDARD) return false;
+        for (int idx = int(nodes.size()) - 1; idx >= 0; --idx) {
+            BVHNode& node = nodes[idx];
+            if (node.count > 0) {
+                vec3 lo(FLT_MAX), hi(-FLT_MAX), plo, phi;
+                for (int k = node.first; k < node.first + node.count; ++k) {
+                    prims[k]->bounds(plo, phi);
+                    lo = min(lo, plo);
+                    hi = max(hi, phi);
+                }
+                node.lo = lo;
+                node.hi = hi;
+            }
+            else {
+                // ڽ ׻ θ𺸴 ڿ Ƿ ̹ ŵ
+                node.lo = min(nodes[idx + 1].lo, nodes[node.first].lo);
+                node.hi = max(nodes[idx + 1].hi, nodes[node.first].hi);
+            }
+        }
+        if (!batch.kind.empty()) batch.set(prims, batch.start);
+        return treeCost() <= 2.0f * builtCost;
+    }
+
+    // hit     ü  (t_nearest    ״ )
+    float findNearest(const Ray& ray, float t_nearest, const Surface** hit = nullptr) const {
+        if (mode == NONE) return t_nearest;
+        vec3 inv(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+        int stack[64];
+        int sp = 0;
+        stack[sp++] = 0;
+        while (sp > 0) {
+            int idx = stack[--sp];
+            vec3 lo, hi;
+            int first, count, axis;
+            decode(idx, lo, hi, first, count, axis);
+            if (!hitBox(ray, inv, lo, hi, t_nearest)) continue;
+            if (count > 0) leafNearest(ray, first, count, t_nearest, hit);
+            else if (ray.direction[axis] < 0.0f) {  //  ڽ  湮
+                stack[sp++] = idx + 1;
+                stack[sp++] = first;
+            }
+            else {
+                stack[sp++] = first;
+                stack[sp++] = idx + 1;
+            }
+        }
+        return t_nearest;
+    }
+
+    // anyHit(): (0, tMax) ȿ  ϳ  ٷ true (׸, AOó    ʿ  ray)
+    // cullByLength ray   ڿ ġ ʴ /ü slab ˻   (ª ray )
+    bool anyHit(const Ray& ray, float tMax, bool cullByLength = false) const {
+        if (mode == NONE) return false;
+        vec3 inv(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+        vec3 end = ray.origin + ray.direction * tMax;
+        vec3 segLo = min(ray.origin, end), segHi = max(ray.origin, end);
+        int stack[64];
+        int sp = 0;
+        stack[sp++] = 0;
+        while (sp > 0) {
+            int idx = stack[--sp];
+            vec3 lo, hi;
+            int first, count, axis;
+            decode(idx, lo, hi, first, count, axis);
+            if (cullByLength && !overlaps(lo, hi, segLo, segHi)) continue;
+            if (!hitBox(ray, inv, lo, hi, tMax)) continue;
+            if (count > 0 && batch.leafKind(first) != PRIM_OTHER) {
+                if (leafAnyHit(ray, first, count, tMax)) return true;
+            }
+            else if (count > 0) {
+                for (int k = first; k < first + count; ++k) {
+                    if (cullByLength) {
+                        vec3 plo, phi;
+                        prims[k]->bounds(plo, phi);
+                        if (!overlaps(plo, phi, segLo, segHi)) continue;
+                    }
+                    float t = prims[k]->intersect(ray);
+                    if (t > 0.0f && t < tMax) return true;
+                }
+            }
+            else if (ray.direction[axis] < 0.0f) {
+                stack[sp++] = idx + 1;
+                stack[sp++] = first;
+            }
+            else {
+                stack[sp++] = first;
+                stack[sp++] = idx + 1;
+            }
+        }
+        return false;
+    }
+
+    static const int MaxPacket = 32;
+
+    static int lowestBit(uint32_t m) {
+#ifdef _MSC_VER
+        unsigned long k;
+        _BitScanForward(&k, m);
+        return int(k);
+#else
+        return __builtin_ctz(m);
+#endif
+    }
+
+    //  ray(count <= MaxPacket) Բ ȸ:    а, ڿ ϴ ray ũ Ʒ 
+    //  ˻ BVHPacketKernel  ü 8ξ, tNearest[k] findNearest()  ǹ̷ ŵǰ  
+    void findNearestPacket(const Ray* rays, float* tNearest, int count) const;
+
+    // anyHitPacket():  ray anyHit() Բ ȸ,  ray Ʈ ũ (done ִ ray ǳʶ)
+    //   Ȯε ray ٷ ũ Ƿ  ray  
+    uint32_t anyHitPacket(const Ray* rays, const float* tMax, int count, uint32_t done = 0) const;
+
+private:
+    float builtCost = 0.0f;
+
+    //  prims[first, first + count) tNearest   ã
+    void leafNearest(const Ray& ray, int first, int count, float& tNearest, const Surface** hit) const {
+        PrimKind kind = batch.leafKind(first);
+        if (kind != PRIM_OTHER) {
+            float t[PrimBatch::Width];
+            int mask = batch.intersect(kind, first, count, ray, t);
+            for (int l = 0; mask; ++l, mask >>= 1) {
+                if ((mask & 1) && (tNearest < 0.0f || t[l] < tNearest)) {
+                    tNearest = t[l];
+                    if (hit) *hit = prims[first + l];
+                }
+            }
+            return;
+        }
+        for (int k = first; k < first + count; ++k) {
+            float t = prims[k]->intersect(ray);
+            if (t > 0.0f && (tNearest < 0.0f || t < tNearest)) {
+                tNearest = t;
+                if (hit) *hit = prims[k];
+            }
+        }
+    }
+    // /Ǹ ִ  (0, tMax)   ִ
+    bool leafAnyHit(const Ray& ray, int first, int count, float tMax) const {
+        float t[PrimBatch::Width];
+        int mask = batch.intersect(batch.leafKind(first), first, count, ray, t);
+        for (int l = 0; mask; ++l, mask >>= 1)
+            if ((mask & 1) && t[l] < tMax) return true;
+        return false;
+    }
+
+    //  count > 0,   count = 0̰ axis  
+    void decode(int idx, vec3& lo, vec3& hi, int& first, int& count, int& axis) const {
+        if (mode == STANDARD) {
+            const BVHNode& node = nodes[idx];
+            lo = node.lo; hi = node.hi;
+            first = node.first;
+            count = std::max(node.count, 0);
+            axis = -node.count - 1;
+        }
+        else {
+            const CompactBVHNode& node = compact[idx];
+            lo = sceneLo + vec3(node.lo[0], node.lo[1], node.lo[2]) * quantScale;
+            hi = sceneLo + vec3(node.hi[0], node.hi[1], node.hi[2]) * quantScale;
+            first = int(node.info & 0x7FFFFFF);
+            bool leaf = (node.info & 0x80000000u) != 0;
+            count = leaf ? int((node.info >> 27) & 0xF) + 1 : 0;
+            axis = leaf ? 0 : int((node.info >> 27) & 0x3);
+        }
+    }
+
+    static float area(const vec3& lo, const vec3& hi) {
+        vec3 e = max(hi - lo, vec3(0.0f));
+        return e.x * e.y + e.y * e.z + e.z * e.x;
+    }
+    // Ʈ    ǥ  (SAH  ٻ)
+    float treeCost() const {
+        float rootArea = std::max(area(nodes[0].lo, nodes[0].hi), 1e-12f);
+        float sum = 0.0f;
+        for (const auto& node : nodes)
+            if (node.count <= 0) sum += area(node.lo, node.hi);
+        return sum / rootArea;
+    }
+
+    static bool overlaps(const vec3& lo, const vec3& hi, const vec3& otherLo, const vec3& otherHi) {
+        return lo.x <= otherHi.x && lo.y <= otherHi.y && lo.z <= otherHi.z &&
+               otherLo.x <= hi.x && otherLo.y <= hi.y && otherLo.z <= hi.z;
+    }
+
+    struct BuildInput {
+        const std::vector<vec3, TrackedAllocator<vec3, MEM_SCRATCH> >& lo;
+        const std::vector<vec3, TrackedAllocator<vec3, MEM_SCRATCH> >& hi;
+        std::vector<int, TrackedAllocator<int, MEM_SCRATCH> >& order;
+        const std::vector<uint8_t, TrackedAllocator<uint8_t, MEM_SCRATCH> >& kind;  // PrimKind
+        std::vector<int, TrackedAllocator<int, MEM_SCRATCH> >& placed;  //    prims
+        int head, tail;  // placed (Ϲ ) ( )    
+    };
+
+    // [begin, end)    ڳ ̶ PrimBatch   ˻  ִ
+    static bool batchable(const BuildInput& in, int begin, int end) {
+        if (end - begin > PrimBatch::Width) return false;
+        uint8_t k0 = in.kind[in.order[begin]];
+        if (k0 == PRIM_OTHER) return false;
+        for (int k = begin + 1; k < end; ++k)
+            if (in.kind[in.order[k]] != k0) return false;
+        return true;
+    }
+
+    // ߽   ࿡  ߾Ӱ 
+    int buildNode(BuildInput& in, int begin, int end) {
+        int idx = int(mode == STANDARD ? nodes.size() : compact.size());
+        if (mode == STANDARD) nodes.push_back(BVHNode());
+        else compact.push_back(CompactBVHNode());
+        vec3 blo(FLT_MAX), bhi(-FLT_MAX), clo(FLT_MAX), chi(-FLT_MAX);
+        for (int k = begin; k < end; ++k) {
+            int p = in.order[k];
+            blo = min(blo, in.lo[p]);
+            bhi = max(bhi, in.hi[p]);
+            vec3 c = (in.lo[p] + in.hi[p]) * 0.5f;
+            clo = min(clo, c);
+            chi = max(chi, c);
+        }
+        bool batched = batchable(in, begin, end);
+        if (end - begin <= 2 || batched) {
+            //   prims  ä PrimBatch  ƴ ̾
+            int count = end - begin, at = batched ? (in.tail -= count) : in.head;
+            if (!batched) in.head += count;
+            std::copy(in.order.begin() + begin, in.order.begin() + end, in.placed.begin() + at);
+            writeNode(idx, blo, bhi, at, count);
+            return idx;
+        }
+        vec3 ext = chi - clo;
+        int axis = (ext.x > ext.y && ext.x > ext.z) ? 0 : (ext.y > ext.z ? 1 : 2);
+        int mid = (begin + end) / 2;
+        std::nth_element(in.order.begin() + begin, in.order.begin() + mid, in.order.begin() + end,
+            [&](int a, int b) { return in.lo[a][axis] + in.hi[a][axis] < in.lo[b][axis] + in.hi[b][axis]; });
+        buildNode(in, begin, mid);
+        int right = buildNode(in, mid, end);
+        writeNode(idx, blo, bhi, right, -(axis + 1));
+        return idx;
+    }
+
+    //  忡    (ٱ) ȭ
+    void writeNode(int idx, const vec3& lo, const vec3& hi, int first, int count) {
+        if (mode == STANDARD) {
+            BVHNode& dst = nodes[idx];
+            dst.lo = lo; dst.hi = hi;
+            dst.first = first; dst.count = count;
+            return;
+        }
+        CompactBVHNode& dst = compact[idx];
+        for (int a = 0; a < 3; ++a) {
+            float qlo = floorf((lo[a] - sceneLo[a]) / quantScale[a]);
+            float qhi = ceilf((hi[a] - sceneLo[a]) / quantScale[a]);
+            dst.lo[a] = uint16_t(clamp(qlo, 0.0f, 65535.0f));
+            dst.hi[a] = uint16_t(clamp(qhi, 0.0f, 65535.0f));
+        }
+        if (count > 0)
+            dst.info = 0x80000000u | (uint32_t(count - 1) << 27) | uint32_t(first);
+        else
+            dst.info = (uint32_t(-count - 1) << 27) | uint32_t(first);
+    }
+};
+
+// std::min   Ƿ Ŭ  ǰ ʿ
+const int BVH::MaxPacket;
+
+// BVH::findNearestPacket()/anyHitPacket() ȸ:   ˻ RayPacketSIMD  ü  
+//  ray ϳ findNearest()/anyHit() ȸ Ͱ 
+template <typename isa>
+struct BVHPacketKernel {
+    typedef RayPacketSIMD<isa> Packet;
+
+    // findNearestPacket():  ϴ tNearest  tMax ٷ ΰ  
+    static void run(const BVH& bvh, const Ray* rays, float* tNearest, int count) {
+        Packet p(rays, tNearest, count);
+        int stack[64];
+        uint32_t masks[64];
+        int sp = 0;
+        stack[sp] = 0;
+        masks[sp++] = (count == 32) ? 0xFFFFFFFFu : ((1u << count) - 1u);
+        while (sp > 0) {
+            --sp;
+            int idx = stack[sp];
+            vec3 lo, hi;
+            int first, n, axis;
+            bvh.decode(idx, lo, hi, first, n, axis);
+            uint32_t active = p.hitBoxes(masks[sp], lo, hi);
+            if (!active) continue;
+            if (n > 0 && bvh.batch.leafKind(first) != PRIM_OTHER) {
+                // /Ǹ ִ  ray ü    
+                for (uint32_t m = active; m; m &= m - 1) {
+                    int k = BVH::lowestBit(m);
+                    bvh.leafNearest(rays[k], first, n, p.tMax[k], nullptr);
+                }
+            }
+            else if (n > 0) {
+                for (int k = first; k < first + n; ++k)
+                    bvh.prims[k]->intersectPacket(rays, active, p.tMax);
+            }
+            else {
+                // ù ° Ȱ ray   ڽ  湮
+                bool flip = rays[BVH::lowestBit(active)].direction[axis] < 0.0f;
+                stack[sp] = flip ? idx + 1 : first;
+                masks[sp++] = active;
+                stack[sp] = flip ? first : idx + 1;
+                masks[sp++] = active;
+            }
+        }
+        std::copy(p.tMax, p.tMax + count, tNearest);
+    }
+
+    // anyHitPacket(): mask ray  (0, tMax[k]) ȿ  ray Ʈ ũ
+    static uint32_t run(const BVH& bvh, const Ray* rays, const float* tMax, int count, uint32_t mask) {
+        Packet p(rays, tMax, count);
+        uint32_t hitMask = 0;
+        int stack[64];
+        uint32_t masks[64];
+        int sp = 0;
+        stack[sp] = 0;
+        masks[sp++] = mask;
+        while (sp > 0) {
+            --sp;
+            int idx = stack[sp];
+            uint32_t live = masks[sp] & ~hitMask;
+            if (!live) continue;
+            vec3 lo, hi;
+            int first, n, axis;
+            bvh.decode(idx, lo, hi, first, n, axis);
+            uint32_t active = p.hitBoxes(live, lo, hi);
+            if (!active) continue;
+            if (n > 0 && bvh.batch.leafKind(first) != PRIM_OTHER) {
+                for (uint32_t m = active & ~hitMask; m; m &= m - 1) {
+                    int k = BVH::lowestBit(m);
+                    if (bvh.leafAnyHit(rays[k], first, n, tMax[k])) hitMask |= 1u << k;
+                }
+            }
+            else if (n > 0) {
+                for (int q = first; q < first + n; ++q) {
+                    for (uint32_t m = active & ~hitMask; m; m &= m - 1) {
+                        int k = BVH::lowestBit(m);
+                        float t = bvh.prims[q]->intersect(rays[k]);
+                        if (t > 0.0f && t < tMax[k]) hitMask |= 1u << k;
+                    }
+                }
+            }
+            else {
+                bool flip = rays[BVH::lowestBit(active)].direction[axis] < 0.0f;
+                stack[sp] = flip ? idx + 1 : first;
+                masks[sp++] = active;
+                stack[sp] = flip ? first : idx + 1;
+                masks[sp++] = active;
+            }
+        }
+        return hitMask;
+    }
+};
+
+void BVH::findNearestPacket(const Ray* rays, float* tNearest, int count) const {
+    if (mode == NONE || count <= 0) return;
+    simdDispatch<BVHPacketKernel>(*this, rays, tNearest, count);
+}
+
+uint32_t BVH::anyHitPacket(const Ray* rays, const float* tMax, int count, uint32_t done) const {
+    uint32_t all = (count == 32) ? 0xFFFFFFFFu : ((1u << count) - 1u);
+    if (mode == NONE || count <= 0 || (done & all) == all) return 0;
+    return simdDispatch<BVHPacketKernel>(*this, rays, tMax, count, all & ~done);
+}
+
+// CurveSet: Ӹī, ó  3 Bezier   ϳ ü 
+// TUBE ձ , RIBBON  ־   ϴ 
+//  /ʺ   ִ MaxSplit      ڷ ü BVH 
+// (ð 񽺵  ϳ  ϳ θ κ  ̶)
+//  ray ǥ ű       ó ˻ (Nakamaru-Ohnishi)
+class CurveSet : public Surface {
+public:
+    enum Type { TUBE, RIBBON };
+    static const int MaxSplit = 4;
+    static const int LeafSize = 4;
+    struct Curve {
+        vec3 cp[4];
+        float width[2];  //   ʺ ()
+        vec3 n;          // RIBBON ϴ 
+    };
+    struct Ref {
+        uint32_t curve;
+        float u0, u1;
+    };
+
+    Type type = TUBE;
+    std::string source;  //      κ (hair ... Ǵ strand ...)
+    vec3 offset;         // ü ̵ (ִϸ̼)
+    std::vector<Curve, TrackedAllocator<Curve, MEM_GEOMETRY> > curves;
+    std::vector<Ref, TrackedAllocator<Ref, MEM_ACCEL> > refs;
+    std::vector<BVHNode, TrackedAllocator<BVHNode, MEM_ACCEL> > nodes;
+
+    CurveSet() : offset(0.0f) { }
+
+    // Catmull-Rom  ( n, n >= 2) n - 1 Bezier  ٲ ߰ (   ݺ)
+    // ʺ w0 w1 ,  RIBBON 
+    void addStrand(const vec3* p, int n, float w0, float w1, const vec3& normal) {
+        for (int k = 0; k + 1 < n; ++k) {
+            vec3 p0 = p[k > 0 ? k - 1 : 0], p1 = p[k], p2 = p[k + 1], p3 = p[std::min(k + 2, n - 1)];
+            Curve c;
+            c.cp[0] = p1;
+            c.cp[1] = p1 + (p2 - p0) / 6.0f;
+            c.cp[2] = p2 - (p3 - p1) / 6.0f;
+            c.cp[3] = p2;
+            c.width[0] = mix(w0, w1, float(k) / (n - 1));
+            c.width[1] = mix(w0, w1, float(k + 1) / (n - 1));
+            c.n = normal;
+            curves.push_back(c);
+        }
+    }
+
+    void build() {
+        refs.clear();
+        nodes.clear();
+        std::vector<vec3, TrackedAllocator<vec3, MEM_SCRATCH> > lo, hi;
+        for (uint32_t i = 0; i < curves.size(); ++i) {
+            const Curve& c = curves[i];
+            float len = length(c.cp[1] - c.cp[0]) + length(c.cp[2] - c.cp[1]) + length(c.cp[3] - c.cp[2]);
+            float w = std::max(std::max(c.width[0], c.width[1]), 1e-6f);
+            int split = clamp(int(ceilf(len / (4.0f * w))), 1, MaxSplit);
+            for (int s = 0; s < split; ++s) {
+                Ref r = { i, float(s) / split, float(s + 1) / split };
+                vec3 cp[4], blo, bhi;
+                subCurve(c, r.u0, r.u1, cp);
+                refBounds(cp, halfWidth(c, r.u0, r.u1), blo, bhi);
+                refs.push_back(r);
+                lo.push_back(blo);
+                hi.push_back(bhi);
+            }
+        }
+        if (refs.empty()) return;
+        std::vector<int, TrackedAllocator<int, MEM_SCRATCH> > order(refs.size());
+        for (size_t k = 0; k < order.size(); ++k) order[k] = int(k);
+        buildNode(lo, hi, order, 0, int(order.size()));
+        std::vector<Ref, TrackedAllocator<Ref, MEM_ACCEL> > sorted(refs.size());
+        for (size_t k = 0; k < order.size(); ++k) sorted[k] = refs[order[k]];
+        refs.swap(sorted);
+    }
+
+    virtual float intersect(const Ray& worldRay) const override {
+        if (nodes.empty()) return -1.0f;
+        Ray ray = worldRay;
+        ray.origin -= offset;
+        // ray  z ϴ ǥ
+        vec3 dz = ray.direction;
+        vec3 dx = normalize(fabsf(dz.x) > 0.9f ? cross(dz, vec3(0.0f, 1.0f, 0.0f)) : cross(dz, vec3(1.0f, 0.0f, 0.0f)));
+        vec3 dy = cross(dz, dx);
+        vec3 inv = 1.0f / ray.direction;
+        float tNearest = -1.0f;
+        int stack[64];
+        int sp = 0;
+        stack[sp++] = 0;
+        while (sp > 0) {
+            int idx = stack[--sp];
+            const BVHNode& node = nodes[idx];
+            if (!hitBox(ray, inv, node.lo, node.hi, tNearest)) continue;
+            if (node.count > 0) {
+                for (int k = node.first; k < node.first + node.count; ++k) {
+                    const Ref& r = refs[k];
+                    const Curve& c = curves[r.curve];
+                    vec3 cp[4];
+                    subCurve(c, r.u0, r.u1, cp);
+                    for (int i = 0; i < 4; ++i) {
+                        vec3 d = cp[i] - ray.origin;
+                        cp[i] = vec3(dot(d, dx), dot(d, dy), dot(d, dz));
+                    }
+                    float scale = 1.0f;
+                    if (type == RIBBON) scale = std::max(fabsf(dot(c.n, ray.direction)), 0.05f);
+                    intersectSegment(c, cp, r.u0, r.u1, maxDepth(c, cp), scale, tNearest);
+                }
+                continue;
+            }
+            int axis = -node.count - 1, right = node.first, left = idx + 1;
+            bool flip = ray.direction[axis] < 0.0f;
+            stack[sp++] = flip ? left : right;
+            stack[sp++] = flip ? right : left;
+        }
+        return tNearest;
+    }
+
+    // p ó     ã TUBE ߽࿡ p , RIBBON  
+    virtual vec3 normal(const vec3& world) const override {
+        vec3 p = world - offset;
+        float best = FLT_MAX;
+        vec3 result(0.0f, 1.0f, 0.0f);
+        int stack[64];
+        int sp = 0;
+        if (!nodes.empty()) stack[sp++] = 0;
+        while (sp > 0) {
+            int idx = stack[--sp];
+            const BVHNode& node = nodes[idx];
+            vec3 tol = vec3(1e-3f);
+            if (any(lessThan(p, node.lo - tol)) || any(greaterThan(p, node.hi + tol))) continue;
+            if (node.count <= 0) {
+                stack[sp++] = node.first;
+                stack[sp++] = idx + 1;
+                continue;
+            }
+            for (int k = node.first; k < node.first + node.count; ++k) {
+                const Ref& r = refs[k];
+                const Curve& c = curves[r.curve];
+                auto distance2 = [&](float v) { vec3 d = p - evalBezier(c.cp, v); return dot(d, d); };
+                //  ǥ     Ÿ ּ u
+                float u = r.u0, d2 = FLT_MAX, step = (r.u1 - r.u0) / 8.0f;
+                for (int s = 0; s <= 8; ++s) {
+                    float us = r.u0 + s * step, ds = distance2(us);
+                    if (ds < d2) { d2 = ds; u = us; }
+                }
+                for (int it = 0; it < 12; ++it) {
+                    step *= 0.5f;
+                    float ua = std::max(u - step, r.u0), ub = std::min(u + step, r.u1);
+                    float da = distance2(ua), db = distance2(ub);
+                    if (da < d2) { d2 = da; u = ua; }
+                    if (db < d2) { d2 = db; u = ub; }
+                }
+                float err = fabsf(sqrtf(d2) - 0.5f * mix(c.width[0], c.width[1], u));
+                if (type == RIBBON) err = sqrtf(d2);
+                if (err >= best) continue;
+                best = err;
+                vec3 center = evalBezier(c.cp, u), tangent = bezierTangent(c.cp, u);
+                vec3 dir = (type == TUBE) ? p - center : c.n;
+                vec3 n = dir - tangent * (dot(dir, tangent) / std::max(dot(tangent, tangent), 1e-12f));
+                if (dot(n, n) > 1e-20f) result = normalize(n);
+            }
+        }
+        return result;
+    }
+
+    virtual bool bounds(vec3& lo, vec3& hi) const override {
+        if (nodes.empty()) return false;
+        lo = nodes[0].lo + offset;
+        hi = nodes[0].hi + offset;
+        return true;
+    }
+    virtual void write(std::ostream& os) const override {
+        os << "curves " << offset.x << ' ' << offset.y << ' ' << offset.z << ' '
+           << (type == TUBE ? "tube " : "ribbon ") << source << '\n';
+    }
+    virtual Surface* clone() const override { return new CurveSet(*this); }
+    virtual void moveTo(const vec3& p) override { offset = p; }
+
+private:
+    static vec3 evalBezier(const vec3* cp, float u) {
+        vec3 a = mix(cp[0], cp[1], u), b = mix(cp[1], cp[2], u), c = mix(cp[2], cp[3], u);
+        vec3 d = mix(a, b, u), e = mix(b, c, u);
+        return mix(d, e, u);
+    }
+    static vec3 bezierTangent(const vec3* cp, float u) {
+        vec3 a = mix(cp[0], cp[1], u), b = mix(cp[1], cp[2], u), c = mix(cp[2], cp[3], u);
+        return mix(b, c, u) - mix(a, b, u);
+    }
+    // blossom [u0, u1]  
+    static vec3 blossom(const vec3* cp, float u0, float u1, float u2) {
+        vec3 a = mix(cp[0], cp[1], u0), b = mix(cp[1], cp[2], u0), c = mix(cp[2], cp[3], u0);
+        vec3 d = mix(a, b, u1), e = mix(b, c, u1);
+        return mix(d, e, u2);
+    }
+    static void subCurve(const Curve& c, float u0, float u1, vec3* out) {
+        out[0] = blossom(c.cp, u0, u0, u0);
+        out[1] = blossom(c.cp, u0, u0, u1);
+        out[2] = blossom(c.cp, u0, u1, u1);
+        out[3] = blossom(c.cp, u1, u1, u1);
+    }
+    static float halfWidth(const Curve& c, float u0, float u1) {
+        return 0.5f * std::max(mix(c.width[0], c.width[1], u0), mix(c.width[0], c.width[1], u1));
+    }
+    //     ʺŭ  
+    static void refBounds(const vec3* cp, float r, vec3& lo, vec3& hi) {
+        lo = min(min(cp[0], cp[1]), min(cp[2], cp[3])) - vec3(r);
+        hi = max(max(cp[0], cp[1]), max(cp[2], cp[3])) + vec3(r);
+    }
+    //    ʺ 5%    
+    static int maxDepth(const Curve& c, const vec3* cp) {
+        float l0 = 0.0f;
+        for (int i = 0; i < 2; ++i) {
+            vec3 d = abs(cp[i] - 2.0f * cp[i + 1] + cp[i + 2]);
+            l0 = std::max(l0, std::max(std::max(d.x, d.y), d.z));
+        }
+        float eps = std::max(c.width[0], c.width[1]) * 0.05f;
+        float r = sqrtf(1.41421356f * 6.0f * l0 / (8.0f * eps));
+        return r > 1.0f ? clamp(int(log2f(r)), 0, 10) : 0;
+    }
+
+    // cp ray ǥ (ray  +z ),    tNearest 
+    // scale RIBBON 񽺵   پ Ѻ ʺ
+    void intersectSegment(const Curve& c, const vec3* cp, float u0, float u1, int depth, float scale, float& tNearest) const {
+        float hw = halfWidth(c, u0, u1) * scale;
+        vec3 lo = min(min(cp[0], cp[1]), min(cp[2], cp[3])), hi = max(max(cp[0], cp[1]), max(cp[2], cp[3]));
+        if (lo.x - hw > 0.0f || hi.x + hw < 0.0f || lo.y - hw > 0.0f || hi.y + hw < 0.0f) return;
+        if (hi.z + hw < 0.0f || (tNearest > 0.0f && lo.z - hw > tNearest)) return;
+        if (depth > 0) {
+            vec3 a = mix(cp[0], cp[1], 0.5f), b = mix(cp[1], cp[2], 0.5f), e = mix(cp[2], cp[3], 0.5f);
+            vec3 ab = mix(a, b, 0.5f), be = mix(b, e, 0.5f), mid = mix(ab, be, 0.5f);
+            vec3 left[4] = { cp[0], a, ab, mid }, right[4] = { mid, be, e, cp[3] };
+            float um = 0.5f * (u0 + u1);
+            intersectSegment(c, left, u0, um, depth - 1, scale, tNearest);
+            intersectSegment(c, right, um, u1, depth - 1, scale, tNearest);
+            return;
+        }
+        //       ̿ ray ־ 
+        if ((cp[1].y - cp[0].y) * -cp[0].y + cp[0].x * (cp[0].x - cp[1].x) < 0.0f) return;
+        if ((cp[2].y - cp[3].y) * -cp[3].y + cp[3].x * (cp[3].x - cp[2].x) < 0.0f) return;
+        vec2 seg = vec2(cp[3]) - vec2(cp[0]);
+        float denom = dot(seg, seg);
+        if (denom == 0.0f) return;
+        float w = clamp(dot(-vec2(cp[0]), seg) / denom, 0.0f, 1.0f);
+        float u = mix(u0, u1, w);
+        float r = 0.5f * mix(c.width[0], c.width[1], u) * scale;
+        vec3 pc = evalBezier(cp, w);
+        float dist2 = pc.x * pc.x + pc.y * pc.y;
+        if (dist2 > r * r) return;
+        // TUBE ray ϴ   ձ ܸ  
+        float t = (type == TUBE) ? pc.z - sqrtf(r * r - dist2) : pc.z;
+        if (t <= 0.001f || (tNearest > 0.0f && t >= tNearest)) return;
+        tNearest = t;
+    }
+
+    //   ߽   ࿡  ߾Ӱ ,  ڽ ٷ  
+    template <class V, class I>
+    int buildNode(const V& lo, const V& hi, I& order, int begin, int end) {
+        int idx = int(nodes.size());
+        nodes.push_back(BVHNode());
+        vec3 blo(FLT_MAX), bhi(-FLT_MAX), clo(FLT_MAX), chi(-FLT_MAX);
+        for (int k = begin; k < end; ++k) {
+            int p = order[k];
+            blo = min(blo, lo[p]);
+            bhi = max(bhi, hi[p]);
+            clo = min(clo, (lo[p] + hi[p]) * 0.5f);
+            chi = max(chi, (lo[p] + hi[p]) * 0.5f);
+        }
+        nodes[idx].lo = blo;
+        nodes[idx].hi = bhi;
+        if (end - begin <= LeafSize) {
+            nodes[idx].first = begin;
+            nodes[idx].count = end - begin;
+            return idx;
+        }
+        vec3 ext = chi - clo;
+        int axis = (ext.x > ext.y && ext.x > ext.z) ? 0 : (ext.y > ext.z ? 1 : 2);
+        int mid = (begin + end) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+            [&](int a, int b) { return lo[a][axis] + hi[a][axis] < lo[b][axis] + hi[b][axis]; });
+        buildNode(lo, hi, order, begin, mid);
+        int right = buildNode(lo, hi, order, mid, end);
+        nodes[idx].first = right;
+        nodes[idx].count = -(axis + 1);
+        return idx;
+    }
+};
+
+// "hair count seed cx cy cz radius length width":  ǥ鿡 ڶ Ʒ ó  (ڸ Catmull-Rom  5)
+// "strand w0 w1 nx ny nz n x y z ...": Catmull-Rom  n   ϳ ( ribbon )
+bool loadCurves(std::istream& ls, CurveSet& set) {
+    std::string type, kind;
+    if (!(ls >> type >> kind)) return false;
+    if (type == "tube") set.type = CurveSet::TUBE;
+    else if (type == "ribbon") set.type = CurveSet::RIBBON;
+    else return false;
+    std::ostringstream src;
+    if (kind == "hair") {
+        size_t n;
+        uint64_t seed;
+        vec3 c;
+        float radius, len, width;
+        if (!(ls >> n >> seed >> c.x >> c.y >> c.z >> radius >> len >> width) || radius <= 0.0f || len <= 0.0f || width <= 0.0f)
+            return false;
+        src << "hair " << n << ' ' << seed << ' ' << c.x << ' ' << c.y << ' ' << c.z << ' ' << radius << ' ' << len << ' ' << width;
+        Pcg32 rng(seed, 0xda3e39cb94b95bdbULL);
+        set.curves.reserve(n * 4);
+        for (size_t h = 0; h < n; ++h) {
+            float z = 1.0f - 2.0f * rng.nextFloat(), phi = 2.0f * pi<float>() * rng.nextFloat();
+            vec3 dir(sqrtf(std::max(0.0f, 1.0f - z * z)) * cosf(phi), sqrtf(std::max(0.0f, 1.0f - z * z)) * sinf(phi), z);
+            vec3 jitter = vec3(rng.nextFloat(), rng.nextFloat(), rng.nextFloat()) - vec3(0.5f);
+            vec3 p[5];
+            p[0] = c + dir * radius;
+            vec3 v = normalize(dir + 0.3f * jitter) * (len / 4.0f);
+            for (int k = 1; k < 5; ++k) {
+                v = normalize(v + vec3(0.0f, -0.35f * len / 4.0f, 0.0f)) * (len / 4.0f);
+                p[k] = p[k - 1] + v;
+            }
+            set.addStrand(p, 5, width, width * 0.2f, dir);
+        }
+    }
+    else if (kind == "strand") {
+        float w0, w1;
+        vec3 nrm;
+        int n;
+        if (!(ls >> w0 >> w1 >> nrm.x >> nrm.y >> nrm.z >> n) || n < 2 || w0 <= 0.0f || w1 < 0.0f) return false;
+        std::vector<vec3> p(n);
+        for (vec3& q : p)
+            if (!(ls >> q.x >> q.y >> q.z)) return false;
+        src << "strand " << w0 << ' ' << w1 << ' ' << nrm.x << ' ' << nrm.y << ' ' << nrm.z << ' ' << n;
+        for (const vec3& q : p) src << ' ' << q.x << ' ' << q.y << ' ' << q.z;
+        if (dot(nrm, nrm) == 0.0f) nrm = vec3(0.0f, 1.0f, 0.0f);
+        set.addStrand(p.data(), n, w0, w1, normalize(nrm));
+    }
+    else return false;
+    set.source = src.str();
+    set.build();
+    std::cout << "curves: " << set.curves.size() << " segments, " << set.refs.size() << " bounded pieces, "
+              << set.nodes.size() << " nodes" << std::endl;
+    return true;
+}
+
+// PlaneBatch: BVH  ʴ  SoA  SSE 4    ˻
+//    0̶ ׻ 
+struct PlaneBatch {
+    std::vector<const Plane*> planes;
+    std::vector<float> nx, ny, nz, d;
+
+    void set(const std::vector<const Plane*>& list) {
+        planes = list;
+        refresh();
+    }
+    //    (refit)  ٽ 
+    void refresh() {
+        size_t n = (planes.size() + 3) & ~size_t(3);
+        nx.assign(n, 0.0f);
+        ny.assign(n, 0.0f);
+        nz.assign(n, 0.0f);
+        d.assign(n, 0.0f);
+        for (size_t k = 0; k < planes.size(); ++k) {
+            nx[k] = planes[k]->n.x;
+            ny[k] = planes[k]->n.y;
+            nz[k] = planes[k]->n.z;
+            d[k] = planes[k]->d;
+        }
+    }
+    // 4  t ȿ  ũ
+    int intersect4(size_t g, const __m128* o, const __m128* dir, float* t) const {
+        __m128 px = _mm_loadu_ps(&nx[g]), py = _mm_loadu_ps(&ny[g]), pz = _mm_loadu_ps(&nz[g]);
+        __m128 denom = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, dir[0]), _mm_mul_ps(py, dir[1])), _mm_mul_ps(pz, dir[2]));
+        __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, o[0]), _mm_mul_ps(py, o[1])), _mm_mul_ps(pz, o[2]));
+        __m128 tw = _mm_div_ps(_mm_sub_ps(_mm_loadu_ps(&d[g]), dist), denom);
+        __m128 absDenom = _mm_andnot_ps(_mm_set1_ps(-0.0f), denom);
+        _mm_storeu_ps(t, tw);
+        return _mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(absDenom, _mm_set1_ps(1e-6f)), _mm_cmpgt_ps(tw, _mm_set1_ps(0.001f))));
+    }
+    // tNearest     (hit )
+    void nearest(const Ray& ray, float& tNearest, const Surface** hit) const {
+        __m128 o[3] = { _mm_set1_ps(ray.origin.x), _mm_set1_ps(ray.origin.y), _mm_set1_ps(ray.origin.z) };
+        __m128 dir[3] = { _mm_set1_ps(ray.direction.x), _mm_set1_ps(ray.direction.y), _mm_set1_ps(ray.direction.z) };
+        float t[4];
+        for (size_t g = 0; g < nx.size(); g += 4) {
+            int mask = intersect4(g, o, dir, t);
+            for (int l = 0; mask; ++l, mask >>= 1) {
+                if ((mask & 1) && (tNearest < 0.0f || t[l] < tNearest)) {
+                    tNearest = t[l];
+                    if (hit) *hit = planes[g + l];
+                }
+            }
+        }
+    }
+    bool occluded(const Ray& ray, float tMax) const {
+        __m128 o[3] = { _mm_set1_ps(ray.origin.x), _mm_set1_ps(ray.origin.y), _mm_set1_ps(ray.origin.z) };
+        __m128 dir[3] = { _mm_set1_ps(ray.direction.x), _mm_set1_ps(ray.direction.y), _mm_set1_ps(ray.direction.z) };
+        float t[4];
+        for (size_t g = 0; g < nx.size(); g += 4) {
+            int mask = intersect4(g, o, dir, t);
+            for (int l = 0; mask; ++l, mask >>= 1)
+                if ((mask & 1) && t[l] < tMax) return true;
+        }
+        return false;
+    }
+};
+
+// Scene:   ü ϰ, ־ ray     t ã
+class Scene {
+public:
+    std::vector<Surface*, TrackedAllocator<Surface*, MEM_GEOMETRY> > objects;
+    std::vector<PointLight> lights;
+    std::vector<SphereLight> sphereLights;
+    std::vector<Medium*> media;  //   忡 
+    std::vector<const Surface*> unbounded;  // BVH  ʴ ü ( )
+    PlaneBatch planes;                      // BVH  ʴ 
+    BVH bvh;
+    bool built = false;
+    ~Scene() {
+        for (auto obj : objects)
+            delete obj;
+        for (auto med : media)
+            delete med;
+    }
+    // ü ߰     
+    void build() {
+        std::vector<const Surface*> bounded;
+        std::vector<const Plane*> planeList;
+        unbounded.clear();
+        for (const auto obj : objects) {
+            vec3 lo, hi;
+            if (obj->bounds(lo, hi)) bounded.push_back(obj);
+            else if (const Plane* pl = dynamic_cast<const Plane*>(obj)) planeList.push_back(pl);
+            else unbounded.push_back(obj);
+        }
+        bvh.build(bounded);
+        if (bvh.mode == BVH::NONE) {
+            unbounded.insert(unbounded.end(), bounded.begin(), bounded.end());
+        }
+        planes.set(planeList);
+        built = true;
+    }
+    // ü   ȣ, ϸ refitϰ ƴϸ ٽ 
+    void update() {
+        if (!bvh.refit()) build();
+        else planes.refresh();
+    }
+    Scene* clone() const {
+        Scene* sc = new Scene();
+        sc->lights = lights;
+        sc->sphereLights = sphereLights;
+        for (const auto med : media)
+            sc->media.push_back(new Medium(*med));
+        for (const auto obj : objects)
+            sc->objects.push_back(obj->clone());
+        sc->build();
+        return sc;
+    }
+    // hit   ü  (  nullptr)
+    float findNearest(const Ray& ray, const Surface** hit = nullptr) const {
+        float t_nearest = -1.0f;
+        if (hit) *hit = nullptr;
+        if (!built) {
+            for (const auto obj : objects) {
+                float t = obj->intersect(ray);
+                if (t > 0.0f && (t_nearest < 0.0f || t < t_nearest)) {
+                    t_nearest = t;
+                    if (hit) *hit = obj;
+                }
+            }
+            return t_nearest;
+        }
+        planes.nearest(ray, t_nearest, hit);
+        for (const auto obj : unbounded) {
+            float t = obj->intersect(ray);
+            if (t > 0.0f && (t_nearest < 0.0f || t < t_nearest)) {
+                t_nearest = t;
+                if (hit) *hit = obj;
+            }
+        }
+        return bvh.findNearest(ray, t_nearest, hit);
+    }
+    // (0, tMax) ȿ ̵ ϴ Ȯ
+    bool occluded(const Ray& ray, float tMax, bool cullByLength = false) const {
+        if (!built) {
+            for (const auto obj : objects) {
+                float t = obj->intersect(ray);
+                if (t > 0.0f && t < tMax) return true;
+            }
+            return false;
+        }
+        if (planes.occluded(ray, tMax)) return true;
+        for (const auto obj : unbounded) {
+            float t = obj->intersect(ray);
+            if (t > 0.0f && t < tMax) return true;
+        }
+        return bvh.anyHit(ray, tMax, cullByLength);
+    }
+    //  ray   t   BVH ȸ  (count <= BVH::MaxPacket)
+    void findNearestPacket(const Ray* rays, float* tNearest, int count) const {
+        if (!built) {
+            for (int k = 0; k < count; ++k) tNearest[k] = findNearest(rays[k]);
+            return;
+        }
+        for (int k = 0; k < count; ++k) {
+            tNearest[k] = -1.0f;
+            planes.nearest(rays[k], tNearest[k], nullptr);
+            for (const auto obj : unbounded) {
+                float t = obj->intersect(rays[k]);
+                if (t > 0.0f && (tNearest[k] < 0.0f || t < tNearest[k]))
+                    tNearest[k] = t;
+            }
+        }
+        bvh.findNearestPacket(rays, tNearest, count);
+    }
+    //  ׸ ray(count <= BVH::MaxPacket)   ˻, (0, tMax[k]) ȿ  ray Ʈ ũ
+    uint32_t occludedPacket(const Ray* rays, const float* tMax, int count) const {
+        uint32_t result = 0;
+        if (!built) {
+            for (int k = 0; k < count; ++k)
+                if (occluded(rays[k], tMax[k])) result |= 1u << k;
+            return result;
+        }
+        for (int k = 0; k < count; ++k) {
+            if (planes.occluded(rays[k], tMax[k])) {
+                result |= 1u << k;
+                continue;
+            }
+            for (const auto obj : unbounded) {
+                float t = obj->intersect(rays[k]);
+                if (t > 0.0f && t < tMax[k]) {
+                    result |= 1u << k;
+                    break;
+                }
+            }
+        }
+        return result | bvh.anyHitPacket(rays, tMax, count, result);
+    }
+};
+
+// --------------------------
+// ִϸ̼ Ű
+// --------------------------
+
+// Track: Ű  Catmull-Rom ö  (   ݺ)
+struct Track {
+    std::vector<float> frames;
+    std::vector<vec3> values;
+    bool empty() const { return frames.empty(); }
+    void add(float frame, const vec3& value) {
+        size_t k = std::upper_bound(frames.begin(), frames.end(), frame) - frames.begin();
+        frames.insert(frames.begin() + k, frame);
+        values.insert(values.begin() + k, value);
+    }
+    vec3 eval(float frame) const {
+        size_t n = frames.size();
+        if (n == 1 || frame <= frames.front()) return values.front();
+        if (frame >= frames.back()) return values.back();
+        size_t k = std::upper_bound(frames.begin(), frames.end(), frame) - frames.begin() - 1;
+        float s = (frame - frames[k]) / (frames[k + 1] - frames[k]);
+        return catmullRom(values[k > 0 ? k - 1 : 0], values[k], values[k + 1], values[std::min(k + 2, n - 1)], s);
+    }
+};
+
+// Animation: ī޶( ġ, ٶ󺸴 ) ü ġ Ʈ
+struct Animation {
+    Track eye, target;
+    std::vector<std::pair<int, Track> > objects;  // (Scene::objects ȣ, ġ)
+
+    bool empty() const { return eye.empty() && objects.empty(); }
+    Track& objectTrack(int index) {
+        for (auto& o : objects)
+            if (o.first == index) return o.second;
+        objects.push_back(std::make_pair(index, Track()));
+        return objects.back().second;
+    }
+    // frame ¸ cam/sc     
+    void apply(float frame, Camera& cam, Scene& sc) const {
+        if (!eye.empty()) {
+            cam.eye = eye.eval(frame);
+            cam.lookAt(target.eval(frame), vec3(0.0f, 1.0f, 0.0f));
+        }
+        for (const auto& o : objects)
+            if (o.first >= 0 && o.first < int(sc.objects.size()))
+                sc.objects[o.first]->moveTo(o.second.eval(frame));
+        if (!objects.empty()) sc.update();
+    }
+};
+
+// --------------------------
+//   
+// --------------------------
+
+//  ٿ ϳ: "camera ex ey ez l r b t d", "plane y", "sphere cx cy cz r", '#' ּ
+// "basis ux uy uz vx vy vz wx wy wz" ٷ  ī޶ 
+// "light x y z r g b"  (ü Ϸ), "spherelight cx cy cz radius r g b"   (ǥ radiance)
+// "material diffuse r g b", "material mirror r g b", "material glass ior", "material glossy r g b exponent"  ü 
+// "medium x0 y0 z0 x1 y1 z1 res sigma r g b seed"   ұ  ( ػ, Ҹ  , albedo,   seed)
+// ִϸ̼: "key camera  ex ey ez tx ty tz", "key object ȣ  x y z"
+void writeScene(std::ostream& os, const Camera& cam, const Scene& sc) {
+    std::streamsize prec = os.precision(9);  // float պ   ٲ ʵ
+    cam.write(os);
+    for (const auto& light : sc.lights)
+        os << "light " << light.position.x << ' ' << light.position.y << ' ' << light.position.z << ' '
+           << light.power.r << ' ' << light.power.g << ' ' << light.power.b << '\n';
+    for (const auto& light : sc.sphereLights)
+        os << "spherelight " << light.center.x << ' ' << light.center.y << ' ' << light.center.z << ' ' << light.radius << ' '
+           << light.radiance.r << ' ' << light.radiance.g << ' ' << light.radiance.b << '\n';
+    for (const auto med : sc.media)
+        med->write(os);
+    Material current;
+    for (const auto obj : sc.objects) {
+        if (obj->material != current) {
+            current = obj->material;
+            current.write(os);
+        }
+        obj->write(os);
+    }
+    os.precision(prec);
+}
+
+// ϸ false, ϸ cam/sc  Ҵ (ȣ  )
+// anim nullptr̸ Ű  
+bool readScene(std::istream& is, Camera*& cam, Scene*& sc, Animation* anim = nullptr) {
+    cam = nullptr;
+    sc = new Scene();
+    std::string line;
+    int lineNo = 0;
+    Material material;
+    while (std::getline(is, line)) {
+        ++lineNo;
+        std::istringstream ls(line);
+        std::string type;
+        if (!(ls >> type) || type[0] == '#') continue;
+        bool ok = true;
+        if (type == "camera") {
+            vec3 e;
+            float l, r, b, t, d;
+            ok = bool(ls >> e.x >> e.y >> e.z >> l >> r >> b >> t >> d);
+            if (ok) {
+                delete cam;
+                cam = new Camera(e, l, r, b, t, d);
+            }
+        }
+        else if (type == "basis") {
+            vec3 u, v, w;
+            ok = cam && bool(ls >> u.x >> u.y >> u.z >> v.x >> v.y >> v.z >> w.x >> w.y >> w.z);
+            if (ok) {
+                cam->axisU = u;
+                cam->axisV = v;
+                cam->axisW = w;
+            }
+        }
+        else if (type == "key") {
+            std::string what;
+            float frame;
+            vec3 a, b;
+            int index = 0;
+            ls >> what;
+            if (what == "camera") {
+                ok = bool(ls >> frame >> a.x >> a.y >> a.z >> b.x >> b.y >> b.z);
+                if (ok && anim) {
+                    anim->eye.add(frame, a);
+                    anim->target.add(frame, b);
+                }
+            }
+            else if (what == "object") {
+                ok = bool(ls >> index >> frame >> a.x >> a.y >> a.z);
+                if (ok && anim) anim->objectTrack(index).add(frame, a);
+            }
+            else ok = false;
+        }
+        else if (type == "light") {
+            PointLight light;
+            ok = bool(ls >> light.position.x >> light.position.y >> light.position.z
+                         >> light.power.r >> light.power.g >> light.power.b);
+            if (ok) sc->lights.push_back(light);
+        }
+        else if (type == "spherelight") {
+            SphereLight light;
+            ok = bool(ls >> light.center.x >> light.center.y >> light.center.z >> light.radius
+                         >> light.radiance.r >> light.radiance.g >> light.radiance.b) && light.radius > 0.0f;
+            if (ok) sc->sphereLights.push_back(light);
+        }
+        else if (type == "medium") {
+            vec3 lo, hi, albedo;
+            int res;
+            float sigma;
+            uint32_t seed;
+            ok = bool(ls >> lo.x >> lo.y >> lo.z >> hi.x >> hi.y >> hi.z >> res >> sigma >> albedo.r >> albedo.g >> albedo.b >> seed)
+                 && lo.x < hi.x && lo.y < hi.y && lo.z < hi.z && res > 1 && res <= 1024 && sigma >= 0.0f;
+            if (ok) sc->media.push_back(new Medium(lo, hi, res, sigma, albedo, seed));
+        }
+        else if (type == "material") {
+            std::string kind;
+            ls >> kind;
+            Material m;
+            if (kind == "glass") {
+                m.type = Material::GLASS;
+                ok = bool(ls >> m.ior) && m.ior > 0.0f;
+            }
+            else if (kind == "diffuse" || kind == "mirror") {
+                m.type = (kind == "mirror") ? Material::MIRROR : Material::DIFFUSE;
+                ok = bool(ls >> m.color.r >> m.color.g >> m.color.b);
+            }
+            else if (kind == "glossy") {
+                m.type = Material::GLOSSY;
+                ok = bool(ls >> m.color.r >> m.color.g >> m.color.b >> m.exponent) && m.exponent >= 0.0f;
+            }
+            else ok = false;
+            if (ok) material = m;
+        }
+        else if (type == "plane") {
+            // "plane y" Ǵ "plane nx ny nz d"
+            std::vector<float> v;
+            float x;
+            while (ls >> x) v.push_back(x);
+            ok = v.size() == 1 || (v.size() == 4 && (v[0] != 0.0f || v[1] != 0.0f || v[2] != 0.0f));
+            if (ok) {
+                sc->objects.push_back(v.size() == 1 ? new Plane(v[0]) : new Plane(vec3(v[0], v[1], v[2]), v[3]));
+                sc->objects.back()->material = material;
+            }
+        }
+        else if (type == "disk") {
+            vec3 c, n;
+            float r;
+            ok = bool(ls >> c.x >> c.y >> c.z >> n.x >> n.y >> n.z >> r) && r > 0.0f && dot(n, n) > 0.0f;
+            if (ok) {
+                sc->objects.push_back(new Disk(c, n, r));
+                sc->objects.back()->material = material;
+            }
+        }
+        else if (type == "box") {
+            vec3 lo, hi;
+            ok = bool(ls >> lo.x >> lo.y >> lo.z >> hi.x >> hi.y >> hi.z);
+            if (ok) {
+                sc->objects.push_back(new Box(lo, hi));
+                sc->objects.back()->material = material;
+            }
+        }
+        else if (type == "obox") {
+            vec3 c, h, axis;
+            float angle;
+            ok = bool(ls >> c.x >> c.y >> c.z >> h.x >> h.y >> h.z >> axis.x >> axis.y >> axis.z >> angle) && dot(axis, axis) > 0.0f;
+            if (ok) {
+                sc->objects.push_back(new Box(c, h, axis, angle));
+                sc->objects.back()->material = material;
+            }
+        }
+        else if (type == "sphere") {
+            vec3 c;
+            float r;
+            ok = bool(ls >> c.x >> c.y >> c.z >> r);
+            if (ok) {
+                sc->objects.push_back(new Sphere(c, r));
+                sc->objects.back()->material = material;
+            }
+        }
+        else if (type == "sdf") {
+            SDFSurface* s = new SDFSurface();
+            ok = bool(ls >> s->position.x >> s->position.y >> s->position.z) && s->parse(ls);
+            if (ok) {
+                s->material = material;
+                sc->objects.push_back(s);
+            }
+            else delete s;
+        }
+        else if (type == "particles") {
+            ParticleCloud* c = new ParticleCloud();
+            ok = bool(ls >> c->offset.x >> c->offset.y >> c->offset.z) && loadParticles(ls, *c);
+            if (ok) {
+                c->material = material;
+                sc->objects.push_back(c);
+            }
+            else delete c;
+        }
+        else if (type == "curves") {
+            CurveSet* c = new CurveSet();
+            ok = bool(ls >> c->offset.x >> c->offset.y >> c->offset.z) && loadCurves(ls, *c);
+            if (ok) {
+                c->material = material;
+                sc->objects.push_back(c);
+            }
+            else delete c;
+        }
+        else ok = false;
+        if (!ok) {
+            std::cerr << "scene: cannot parse line " << lineNo << ": " << line << std::endl;
+            delete cam;
+            delete sc;
+            cam = nullptr;
+            sc = nullptr;
+            return false;
+        }
+    }
+    if (!cam) cam = new Camera(vec3(0.0f), -0.1f, 0.1f, -0.1f, 0.1f, 0.1f);
+    sc->build();
+    return true;
+}
+
+bool loadSceneFile(const std::string& path, Camera*& cam, Scene*& sc, Animation* anim = nullptr) {
+    std::ifstream in(path.c_str());
+    if (!in) {
+        std::cerr << "scene: cannot open " << path << std::endl;
+        return false;
+    }
+    return readScene(in, cam, sc, anim);
+}
+
+// ̹ P6 PPM , image 0  Ʒ(glDrawPixels )̹Ƿ  
+bool writePPM(std::ostream& out, const float* rgb, int nx, int ny) {
+    out << "P6\n" << nx << ' ' << ny << "\n255\n";
+    std::vector<unsigned char> row(nx * 3);
+    for (int j = ny - 1; j >= 0; --j) {
+        packUnorm1x8(rgb + j * nx * 3, nx * 3, &row[0]);
+        out.write(reinterpret_cast<const char*>(&row[0]), row.size());
+    }
+    return bool(out);
+}
+
+bool writePPM(const std::string& path, const float* rgb, int nx, int ny) {
+    std::ofstream out(path.c_str(), std::ios::binary);
+    return out && writePPM(out, rgb, nx, ny);
+}
+
+// writePPM()  nx x ny ̹ ٽ  (ũⰡ ٸ false)
+bool readPPM(const std::string& path, float* rgb, int nx, int ny) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    std::string magic;
+    int w = 0, h = 0, maxval = 0;
+    if (!(in >> magic >> w >> h >> maxval) || magic != "P6" || w != nx || h != ny || maxval != 255)
+        return false;
+    in.get();
+    std::vector<unsigned char> row(nx * 3);
+    for (int j = ny - 1; j >= 0; --j) {
+        if (!in.read(reinterpret_cast<char*>(&row[0]), row.size())) return false;
+        for (int k = 0; k < nx * 3; ++k)
+            rgb[j * nx * 3 + k] = row[k] / 255.0f;
+    }
+    return true;
+}
+
+// --------------------------
+//     Լ
+// --------------------------
+int Width = 512;
+int Height = 512;
+typedef std::vector<float, TrackedAllocator<float, MEM_FRAMEBUFFER> > FrameBuffer;
+FrameBuffer OutputImage;
+Camera* camera = nullptr;
+Scene* scene = nullptr;
+
+int ThreadCount = 0;  // 0̸ ϵ  
+const int TileSize = 32;
+
+// Tile: [x0, x1) x [y0, y1) ȼ 
+struct Tile {
+    int x0, y0, x1, y1;
+    int width() const { return x1 - x0; }
+    int height() const { return y1 - y0; }
+};
+
+// crop    ġ Ÿϸ,   ߶ (Ÿ ڴ ü  )
+std::vector<Tile> makeTiles(int nx, int ny, const Tile* crop = nullptr) {
+    int x0 = 0, y0 = 0, x1 = nx, y1 = ny;
+    if (crop) {
+        x0 = std::max(crop->x0, 0);
+        y0 = std::max(crop->y0, 0);
+        x1 = std::min(crop->x1, nx);
+        y1 = std::min(crop->y1, ny);
+    }
+    std::vector<Tile> tiles;
+    for (int y = y0 / TileSize * TileSize; y < y1; y += TileSize)
+        for (int x = x0 / TileSize * TileSize; x < x1; x += TileSize)
+            tiles.push_back({ std::max(x, x0), std::max(y, y0), std::min(x + TileSize, x1), std::min(y + TileSize, y1) });
+    return tiles;
+}
+
+// CropWindow: ٽ   (OutputImage ǥ, 0  Ʒ),   ü
+Tile CropWindow = { 0, 0, 0, 0 };
+
+bool hasCropWindow() {
+    return CropWindow.width() > 0 && CropWindow.height() > 0;
+}
+
+int renderThreads() {
+    if (ThreadCount > 0) return ThreadCount;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? int(hw) : 1;
+}
+
+// parallelFor: 0 ~ count-1 ۾  ϳ  ó
+template <class F>
+void parallelFor(int count, F fn) {
+    int n = std::min(renderThreads(), count);
+    if (n <= 1) {
+        for (int k = 0; k < count; ++k) fn(k);
+        return;
+    }
+    std::atomic<int> next(0);
+    std::vector<std::thread> pool;
+    for (int w = 0; w < n; ++w) {
+        pool.push_back(std::thread([&]() {
+            for (int k = next++; k < count; k = next++)
+                fn(k);
+        }));
+    }
+    for (auto& th : pool) th.join();
+}
+
+// shade():  Ÿ t(  ) ray  
+vec3 shade(float t) {
+    if (t > 0.0f) // ü ϸ 
+        return vec3(1.0f);
+    return vec3(0.0f); //   
+}
+
+// trace(): ray ϳ , depth   Ÿ(  FLT_MAX) 
+vec3 trace(const Scene& sc, const Ray& ray, float* depth = nullptr) {
+    float t = sc.findNearest(ray);
+    if (depth) *depth = (t > 0.0f) ? t : FLT_MAX;
+    return shade(t);
+}
+
+// renderTile() BVH Բ ȸϴ ray : PacketBlockWidth x PacketBlockHeight ȼ (BVH::MaxPacket)
+static const int PacketBlockWidth = 8, PacketBlockHeight = 4;
+
+// renderTile(): Ÿ  ȼ ߽ ray   
+// ̿ ȼ  ray   BVH Բ ȸ ( 带  ray ),  trace() 
+// dst Ÿ  Ʒ ȼ ġ, stride dst   ȼ 
+void renderTile(const Camera& cam, const Scene& sc, const Tile& tile, int nx, int ny, float* dst, int stride) {
+    std::vector<Ray> rays;
+    rays.reserve(BVH::MaxPacket);
+    float t[BVH::MaxPacket];
+    for (int j0 = tile.y0; j0 < tile.y1; j0 += PacketBlockHeight) {
+        int j1 = std::min(j0 + PacketBlockHeight, tile.y1);
+        for (int i0 = tile.x0; i0 < tile.x1; i0 += PacketBlockWidth) {
+            int i1 = std::min(i0 + PacketBlockWidth, tile.x1);
+            rays.clear();
+            for (int j = j0; j < j1; ++j)
+                for (int i = i0; i < i1; ++i)
+                    rays.push_back(cam.generateRay(i, j, nx, ny));
+            sc.findNearestPacket(&rays[0], t, int(rays.size()));
+            for (int j = j0, r = 0; j < j1; ++j) {
+                for (int i = i0; i < i1; ++i, ++r) {
+                    vec3 color = shade(t[r]);
+                    int idx = ((j - tile.y0) * stride + (i - tile.x0)) * 3;
+                    dst[idx] = color.r;
+                    dst[idx + 1] = color.g;
+                    dst[idx + 2] = color.b;
+                }
+            }
+        }
+    }
+}
+
+// Foveation:  ֺ  ȼ, ٱ rate x rate ȼ   ϴ ̸ 
+struct FoveationSettings {
+    bool enabled = false;
+    float radius = 64.0f;   //  ݰ(ȼ)  Ÿ  ȼ , 2 ݰ 2x2,   maxRate
+    float speedup = 0.0f;   // 0 ũ radius   ӵ    ̻  ū ݰ 
+    int maxRate = 4;        // 2 Ǵ 4
+    vec2 focus = vec2(-1.0f);  // OutputImage ǥ,  ̹ ߾
+};
+FoveationSettings Foveation;
+
+//  Ÿϱ   Ÿ   
+int foveationRate(const Tile& tile, int nx, int ny, float radius) {
+    vec2 focus = Foveation.focus.x < 0.0f ? vec2(nx * 0.5f, ny * 0.5f) : Foveation.focus;
+    vec2 nearest = clamp(focus, vec2(float(tile.x0), float(tile.y0)), vec2(float(tile.x1), float(tile.y1)));
+    float dist = length(focus - nearest);
+    if (dist <= radius) return 1;
+    if (dist <= 2.0f * radius || Foveation.maxRate <= 2) return 2;
+    return 4;
+}
+
+//   1, 2, 4 ȼ ϳ  :  3000  ( 1)  ӵ 󺸴 8% ̻  ϵ  
+//  ray  ־  ȸص ray (1/4, 1/16)ŭ  ʰ,  ֺ 밳   κ̶ ٱ Ÿ   
+static const float FoveationPixelCost[3] = { 1.0f, 0.9f, 0.5f };
+
+// speedup ̻   Ǵ  ū ݰ (TileSize/4  ã,  0)
+float foveationRadiusFor(float speedup, const std::vector<Tile>& tiles, int nx, int ny) {
+    float full = 0.0f;
+    for (const Tile& tile : tiles) full += float((tile.x1 - tile.x0) * (tile.y1 - tile.y0));
+    const float step = TileSize / 4;
+    for (float radius = ceilf(length(vec2(float(nx), float(ny))) / step) * step; radius > 0.0f; radius -= step) {
+        float cost = 0.0f;
+        for (const Tile& tile : tiles) {
+            int rate = foveationRate(tile, nx, ny, radius);
+            cost += (tile.x1 - tile.x0) * (tile.y1 - tile.y0) * FoveationPixelCost[rate == 1 ? 0 : rate == 2 ? 1 : 2];
+        }
+        if (full >= speedup * cost) return radius;
+    }
+    return 0.0f;
+}
+
+// renderTileCoarse(): rate   ȼ ϰ  ̸   ä
+//   4     ̿ ũ ٸ  ġ ٿ ü 谡  ʰ 
+void renderTileCoarse(const Camera& cam, const Scene& sc, const Tile& tile, int nx, int ny, float* dst, int stride, int rate) {
+    //  : Ÿ ȿ rate ,   Ÿ  ȼ
+    int gw = (tile.width() - 1 + rate - 1) / rate + 1;
+    int gh = (tile.height() - 1 + rate - 1) / rate + 1;
+    int gx[TileSize + 1], gy[TileSize + 1];
+    for (int a = 0; a < gw; ++a) gx[a] = std::min(tile.x0 + a * rate, tile.x1 - 1);
+    for (int b = 0; b < gh; ++b) gy[b] = std::min(tile.y0 + b * rate, tile.y1 - 1);
+    vec3 color[(TileSize + 1) * (TileSize + 1)];
+    float depth[(TileSize + 1) * (TileSize + 1)];
+    //   renderTile()ó BVH::MaxPacket  Բ ȸ ( trace() )
+    std::vector<Ray> rays;
+    rays.reserve(BVH::MaxPacket);
+    float t[BVH::MaxPacket];
+    for (int g0 = 0; g0 < gw * gh; g0 += BVH::MaxPacket) {
+        int g1 = std::min(g0 + BVH::MaxPacket, gw * gh);
+        rays.clear();
+        for (int g = g0; g < g1; ++g)
+            rays.push_back(cam.generateRay(gx[g % gw], gy[g / gw], nx, ny));
+        sc.findNearestPacket(&rays[0], t, g1 - g0);
+        for (int g = g0; g < g1; ++g) {
+            color[g] = shade(t[g - g0]);
+            depth[g] = (t[g - g0] > 0.0f) ? t[g - g0] : FLT_MAX;
+        }
+    }
+
+    //     x ġ, ึ    y ġ (ȼ   ʵ)
+    int colA[TileSize], rowB[TileSize];
+    float colF[TileSize], rowF[TileSize];
+    for (int i = tile.x0; i < tile.x1; ++i) {
+        int a = std::min((i - tile.x0) / rate, gw - 2 < 0 ? 0 : gw - 2);
+        int a1 = std::min(a + 1, gw - 1);
+        colA[i - tile.x0] = a;
+        colF[i - tile.x0] = (gx[a1] > gx[a]) ? float(i - gx[a]) / float(gx[a1] - gx[a]) : 0.0f;
+    }
+    for (int j = tile.y0; j < tile.y1; ++j) {
+        int b = std::min((j - tile.y0) / rate, gh - 2 < 0 ? 0 : gh - 2);
+        int b1 = std::min(b + 1, gh - 1);
+        rowB[j - tile.y0] = b;
+        rowF[j - tile.y0] = (gy[b1] > gy[b]) ? float(j - gy[b]) / float(gy[b1] - gy[b]) : 0.0f;
+    }
+    // ĭ(   )   𼭸  𼭸   (̰ ϸ 1, ƴϸ 1e-3)
+    // ĭ 𼭸 ̴ ȼ Ƿ rate x rate ȼ   񱳸 Բ 
+    //  𼭸 ̰   ĭ(κ)   1̶ ׳ ּ 
+    float factor[TileSize / 2 * TileSize / 2][4][4];
+    bool smooth[TileSize / 2 * TileSize / 2];
+    int cw = std::max(gw - 1, 1), ch = std::max(gh - 1, 1);
+    for (int b = 0; b < ch; ++b) {
+        for (int a = 0; a < cw; ++a) {
+            int a1 = std::min(a + 1, gw - 1), b1 = std::min(b + 1, gh - 1);
+            int idx4[4] = { b * gw + a, b * gw + a1, b1 * gw + a, b1 * gw + a1 };
+            bool all = true;
+            for (int nearest = 0; nearest < 4; ++nearest) {
+                float ref = depth[idx4[nearest]];
+                for (int n = 0; n < 4; ++n) {
+                    float d = depth[idx4[n]];
+                    bool similar = (d == ref) || (ref < FLT_MAX && d < FLT_MAX && fabsf(d - ref) < 0.05f * ref);
+                    factor[b * cw + a][nearest][n] = similar ? 1.0f : 1e-3f;
+                    all = all && similar;
+                }
+            }
+            smooth[b * cw + a] = all;
+        }
+    }
+
+    for (int j = tile.y0; j < tile.y1; ++j) {
+        int b = rowB[j - tile.y0], b1 = std::min(b + 1, gh - 1);
+        float fy = rowF[j - tile.y0];
+        float* row = dst + (j - tile.y0) * stride * 3;
+        for (int i = tile.x0; i < tile.x1; ++i) {
+            int a = colA[i - tile.x0], a1 = std::min(a + 1, gw - 1);
+            float fx = colF[i - tile.x0];
+            int idx4[4] = { b * gw + a, b * gw + a1, b1 * gw + a, b1 * gw + a1 };
+            float w4[4] = { (1 - fx) * (1 - fy), fx * (1 - fy), (1 - fx) * fy, fx * fy };
+            vec3 c;
+            if (smooth[b * cw + a]) {
+                c = color[idx4[0]] * w4[0] + color[idx4[1]] * w4[1] + color[idx4[2]] * w4[2] + color[idx4[3]] * w4[3];
+            }
+            else {
+                int nearest = 0;
+                for (int n = 1; n < 4; ++n)
+                    if (w4[n] > w4[nearest]) nearest = n;
+                const float* f = factor[b * cw + a][nearest];
+                vec3 sum(0.0f);
+                float wsum = 0.0f;
+                for (int n = 0; n < 4; ++n) {
+                    float w = w4[n] * f[n];
+                    sum += color[idx4[n]] * w;
+                    wsum += w;
+                }
+                c = sum / wsum;
+            }
+            float* px = row + (i - tile.x0) * 3;
+            px[0] = c.r;
+            px[1] = c.g;
+            px[2] = c.b;
+        }
+    }
+}
+
+void renderTilesLocal(const Camera& cam, const Scene& sc, const std::vector<Tile>& tiles, int nx, int ny, float* image) {
+    float radius = Foveation.radius;
+    if (Foveation.enabled && Foveation.speedup > 0.0f)
+        radius = foveationRadiusFor(Foveation.speedup, tiles, nx, ny);
+    parallelFor(int(tiles.size()), [&](int k) {
+        const Tile& tile = tiles[k];
+        float* dst = image + (tile.y0 * nx + tile.x0) * 3;
+        int rate = Foveation.enabled ? foveationRate(tile, nx, ny, radius) : 1;
+        if (rate > 1) renderTileCoarse(cam, sc, tile, nx, ny, dst, nx, rate);
+        else renderTile(cam, sc, tile, nx, ny, dst, nx);
+    });
+}
+
+// --------------------------
+// Ambient occlusion
+// --------------------------
+
+// AO:    ݱ ª ray  distance ȿ     
+struct AOSettings {
+    bool enabled = false;
+    int samples = 16;           // ȼ ݱ ray 
+    float distance = 1.0f;      // ̺  ü  ʴ  
+    bool cullByLength = false;  // ray   ڷ BVH 带  ɷ
+};
+AOSettings AO;
+std::string AOGuidePath;  //  Ϲ   AO ̹  ( ̵ )
+
+//   n    (б  Duff et al. )
+void orthonormalBasis(const vec3& n, vec3& b1, vec3& b2) {
+    float sign = n.z >= 0.0f ? 1.0f : -1.0f;
+    float a = -1.0f / (sign + n.z);
+    float b = n.x * n.y * a;
+    b1 = vec3(1.0f + sign * n.x * n.x * a, sign * b, -sign * n.x);
+    b2 = vec3(b, sign + n.y * n.y * a, -n.y);
+}
+
+// n  ݱ cos ϴ  (u1, u2 [0, 1) )
+vec3 cosineHemisphere(const vec3& n, float u1, float u2) {
+    vec3 b1, b2;
+    orthonormalBasis(n, b1, b2);
+    float r = sqrtf(u1);
+    float phi = 2.0f * pi<float>() * u2;
+    return (r * cosf(phi)) * b1 + (r * sinf(phi)) * b2 + sqrtf(std::max(0.0f, 1.0f - u1)) * n;
+}
+
+//  p( n) AO, cos  ø̹Ƿ   ray   
+float ambientOcclusion(const Scene& sc, const vec3& p, const vec3& n, Pcg32& rng) {
+    vec3 origin = p + n * 1e-3f;
+    int open = 0;
+    for (int s = 0; s < AO.samples; ++s) {
+        float u1 = rng.nextFloat(), u2 = rng.nextFloat();
+        if (!sc.occluded(Ray(origin, cosineHemisphere(n, u1, u2)), AO.distance, AO.cullByLength))
+            ++open;
+    }
+    return float(open) / float(std::max(AO.samples, 1));
+}
+
+// renderAO(): ȼ ߽ ray  AO  ȸ  (  )
+//  Ʈ ȼ ȣ Ƿ     
+void renderAO(const Camera& cam, const Scene& sc, int nx, int ny, float* image, const Tile* crop = nullptr) {
+    std::vector<Tile> tiles = makeTiles(nx, ny, crop);
+    parallelFor(int(tiles.size()), [&](int k) {
+        const Tile& tile = tiles[k];
+        for (int j = tile.y0; j < tile.y1; ++j) {
+            for (int i = tile.x0; i < tile.x1; ++i) {
+                Ray ray = cam.generateRay(i, j, nx, ny);
+                const Surface* hit;
+                float t = sc.findNearest(ray, &hit);
+                float value = 0.0f;
+                if (hit) {
+                    vec3 p = ray.origin + ray.direction * t;
+                    vec3 n = hit->normal(p);
+                    if (dot(n, ray.direction) > 0.0f) n = -n;
+                    Pcg32 rng(0, uint64_t(j) * nx + i);
+                    value = ambientOcclusion(sc, p, n, rng);
+                }
+                float* dst = image + (j * nx + i) * 3;
+                dst[0] = dst[1] = dst[2] = value;
+            }
+        }
+    });
+}
+
+// --------------------------
+//   (caustic)
+// --------------------------
+
+//  迡 ݻ  F (Schlick ٻ)  , ݻ F = 1
+// n ٱ , d  
+float glassInterface(const Material& m, const vec3& d, vec3 n, vec3& refracted) {
+    bool entering = dot(d, n) < 0.0f;
+    if (!entering) n = -n;
+    float eta = entering ? 1.0f / m.ior : m.ior;
+    float cosi = -dot(d, n);
+    float sin2t = eta * eta * (1.0f - cosi * cosi);
+    if (sin2t >= 1.0f) return 1.0f;
+    float cost = sqrtf(1.0f - sin2t);
+    refracted = eta * d + (eta * cosi - cost) * n;
+    float r0 = (1.0f - m.ior) / (1.0f + m.ior);
+    r0 *= r0;
+    float c = 1.0f - (entering ? cosi : cost);
+    return r0 + (1.0f - r0) * c * c * c * c * c;
+}
+
+// ſ/  ,  u < F ݻ ƴϸ  (Ȯ F̹Ƿ ġ ٲ )
+vec3 scatterSpecular(const Material& m, const vec3& d, const vec3& n, float u) {
+    if (m.type == Material::GLASS) {
+        vec3 refracted;
+        if (u >= glassInterface(m, d, n, refracted)) return refracted;
+    }
+    return reflect(d, n);
+}
+
+// Ȯ ǥ  p( n, ݻ albedo)   ,   ray  ׸
+//  ׸ڸ ,    caustic  
+//   ߽ɿ ִ  Ϸ(4 pi^2 r^2 L)  ٻ (鱤 ø MIS 忡)
+vec3 directLight(const Scene& sc, const vec3& p, const vec3& n, const vec3& albedo) {
+    vec3 sum(0.0f);
+    auto addPoint = [&](const vec3& position, const vec3& power, float skip) {
+        vec3 toLight = position - p;
+        float dist2 = dot(toLight, toLight);
+        float dist = sqrtf(dist2);
+        float cosTheta = dot(n, toLight) / dist;
+        if (cosTheta <= 0.0f || dist <= skip) return;
+        if (sc.occluded(Ray(p + n * 1e-3f, toLight), dist - skip - 2e-3f)) return;
+        sum += power / (4.0f * pi<float>()) * (cosTheta / dist2);
+    };
+    for (const auto& light : sc.lights)
+        addPoint(light.position, light.power, 0.0f);
+    for (const auto& light : sc.sphereLights)
+        addPoint(light.center, light.radiance * (4.0f * pi<float>() * pi<float>() * light.radius * light.radius), light.radius);
+    return albedo / pi<float>() * sum;
+}
+
+// Photon: Ȯ ǥ鿡   (ġ, Ϸ, kd-tree  )
+struct Photon {
+    vec3 position;
+    vec3 power;
+    int axis;
+};
+
+typedef std::vector<Photon, TrackedAllocator<Photon, MEM_SCRATCH> > PhotonBuffer;
+
+// PhotonMap:    kd-tree,  i ڽ 2i+1, 2i+2 (  迭 ϳ)
+class PhotonMap {
+public:
+    std::vector<Photon, TrackedAllocator<Photon, MEM_ACCEL> > photons;
+
+    // input  ٲٸ鼭 Ʈ 
+    void build(PhotonBuffer& input) {
+        photons.clear();
+        photons.resize(input.size());
+        if (!input.empty()) balance(&input[0], 0, int(input.size()), 0);
+    }
+
+    static const int MaxK = 256;
+    // k-NN :      ִ 
+    struct Neighbors {
+        int k;
+        int found;
+        float maxDist2;
+        std::pair<float, int> heap[MaxK];
+    };
+
+    // p maxDist2    ִ k
+    void nearest(const vec3& p, Neighbors& q) const {
+        if (!photons.empty()) nearestNode(0, p, q);
+    }
+
+    // p r2   濡 fn(photon) ȣ
+    template <class F>
+    void range(const vec3& p, float r2, F fn) const {
+        int stack[64];
+        int sp = 0;
+        int n = int(photons.size());
+        if (n > 0) stack[sp++] = 0;
+        while (sp > 0) {
+            int i = stack[--sp];
+            const Photon& ph = photons[i];
+            int left = 2 * i + 1;
+            if (left < n) {
+                float d = p[ph.axis] - ph.position[ph.axis];
+                if (d <= 0.0f || d * d < r2) stack[sp++] = left;
+                if (left + 1 < n && (d >= 0.0f || d * d < r2)) stack[sp++] = left + 1;
+            }
+            vec3 diff = ph.position - p;
+            if (dot(diff, diff) < r2) fn(ph);
+        }
+    }
+
+private:
+    // n     Ʈ  κ Ʈ  
+    static int leftSize(int n) {
+        if (n <= 1) return 0;
+        int full = 1;  // 2^h, h    
+        while (full * 2 <= n + 1) full *= 2;
+        int last = n - (full - 1);
+        return (full / 2 - 1) + std::min(last, full / 2);
+    }
+
+    void balance(Photon* p, int begin, int end, int index) {
+        int n = end - begin;
+        if (n <= 0) return;
+        vec3 lo(FLT_MAX), hi(-FLT_MAX);
+        for (int k = begin; k < end; ++k) {
+            lo = min(lo, p[k].position);
+            hi = max(hi, p[k].position);
+        }
+        vec3 ext = hi - lo;
+        int axis = (ext.x > ext.y && ext.x > ext.z) ? 0 : (ext.y > ext.z ? 1 : 2);
+        int median = begin + leftSize(n);
+        std::nth_element(p + begin, p + median, p + end,
+            [axis](const Photon& a, const Photon& b) { return a.position[axis] < b.position[axis]; });
+        photons[index] = p[median];
+        photons[index].axis = axis;
+        balance(p, begin, median, 2 * index + 1);
+        balance(p, median + 1, end, 2 * index + 2);
+    }
+
+    void nearestNode(int i, const vec3& p, Neighbors& q) const {
+        const Photon& ph = photons[i];
+        int left = 2 * i + 1;
+        if (left < int(photons.size())) {
+            float d = p[ph.axis] - ph.position[ph.axis];
+            int nearChild = (d <= 0.0f) ? left : left + 1;
+            int farChild = (d <= 0.0f) ? left + 1 : left;
+            if (nearChild < int(photons.size())) nearestNode(nearChild, p, q);
+            if (d * d < q.maxDist2 && farChild < int(photons.size())) nearestNode(farChild, p, q);
+        }
+        vec3 diff = ph.position - p;
+        float d2 = dot(diff, diff);
+        if (d2 >= q.maxDist2) return;
+        if (q.found < q.k) {
+            q.heap[q.found++] = std::make_pair(d2, i);
+            std::push_heap(q.heap, q.heap + q.found);
+            if (q.found == q.k) q.maxDist2 = q.heap[0].first;
+        }
+        else {
+            std::pop_heap(q.heap, q.heap + q.found);
+            q.heap[q.found - 1] = std::make_pair(d2, i);
+            std::push_heap(q.heap, q.heap + q.found);
+            q.maxDist2 = q.heap[0].first;
+        }
+    }
+};
+
+// Photons:    (count н   ,       )
+struct PhotonSettings {
+    bool enabled = false;
+    int count = 200000;
+    int k = 64;              // k-NN    
+    float radius = 0.25f;    // k-NN ִ Ž ݰ,   ó ݰ
+    int passes = 0;          // 0 ũ    (н   ݰ ٿ  )
+    float alpha = 0.7f;      //  忡   ݿϴ 
+    int maxDepth = 8;        // ſ/ 󰡴 ִ Ƚ
+};
+PhotonSettings Photons;
+
+//  ſ/ ü ϴ ,       ʵ  ȿ 
+struct EmitCone {
+    vec3 axis;
+    float cosMax;
+    float solidAngle;
+};
+
+//  ϳ  Ե, 谡  ſ/ ְų    ̸ ü  ϳ
+std::vector<EmitCone> emitCones(const Scene& sc, const PointLight& light) {
+    std::vector<EmitCone> cones;
+    const EmitCone sphere = { vec3(0.0f, 1.0f, 0.0f), -1.0f, 4.0f * pi<float>() };
+    for (const auto obj : sc.objects) {
+        if (!obj->material.specular()) continue;
+        vec3 lo, hi;
+        if (!obj->bounds(lo, hi)) return std::vector<EmitCone>(1, sphere);
+        vec3 center = (lo + hi) * 0.5f;
+        float r = length(hi - lo) * 0.5f;
+        vec3 toCenter = center - light.position;
+        float d = length(toCenter);
+        if (d <= r) return std::vector<EmitCone>(1, sphere);
+        float cosMax = sqrtf(1.0f - (r / d) * (r / d));
+        cones.push_back({ toCenter / d, cosMax, 2.0f * pi<float>() * (1.0f - cosMax) });
+    }
+    return cones;
+}
+
+// emitPhotons(): count   忡  ϰ caustic ( -> ſ/ -> Ȯ) 
+//  n Pcg32(seed, n) Ʈ    ġǷ     
+void emitPhotons(const Scene& sc, int count, uint64_t seed, PhotonBuffer& out) {
+    out.clear();
+    if (sc.lights.empty() || count <= 0) return;
+    std::vector<std::vector<EmitCone> > cones;
+    std::vector<float> lightCdf;
+    float totalPower = 0.0f;
+    for (const auto& light : sc.lights) {
+        cones.push_back(emitCones(sc, light));
+        totalPower += light.power.r + light.power.g + light.power.b;
+        lightCdf.push_back(totalPower);
+    }
+    if (totalPower <= 0.0f) return;
+
+    const int chunk = 4096;
+    int chunks = (count + chunk - 1) / chunk;
+    std::vector<PhotonBuffer> parts(chunks);
+    parallelFor(chunks, [&](int c) {
+        for (int n = c * chunk; n < std::min(count, (c + 1) * chunk); ++n) {
+            Pcg32 rng(seed, uint64_t(n));
+            //  Ϸ ؼ 
+            float u = rng.nextFloat() * totalPower;
+            int l = 0;
+            while (l + 1 < int(lightCdf.size()) && u >= lightCdf[l]) ++l;
+            const PointLight& light = sc.lights[l];
+            const std::vector<EmitCone>& lc = cones[l];
+            if (lc.empty()) continue;
+            float totalAngle = 0.0f;
+            for (const auto& cone : lc) totalAngle += cone.solidAngle;
+            //  ü ؼ   ȿ ϰ  
+            float v = rng.nextFloat() * totalAngle;
+            int ci = 0;
+            while (ci + 1 < int(lc.size()) && v >= lc[ci].solidAngle) v -= lc[ci++].solidAngle;
+            const EmitCone& cone = lc[ci];
+            float cosTheta = 1.0f - rng.nextFloat() * (1.0f - cone.cosMax);
+            float sinTheta = sqrtf(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+            float phi = 2.0f * pi<float>() * rng.nextFloat();
+            vec3 b1, b2;
+            orthonormalBasis(cone.axis, b1, b2);
+            vec3 dir = (sinTheta * cosf(phi)) * b1 + (sinTheta * sinf(phi)) * b2 + cosTheta * cone.axis;
+            //  ġ   pdf (ϴ  ) / totalAngle
+            int covering = 0;
+            for (const auto& other : lc)
+                if (dot(dir, other.axis) >= other.cosMax) ++covering;
+            vec3 power = light.power * (totalPower / (light.power.r + light.power.g + light.power.b))
+                       * (totalAngle / (4.0f * pi<float>() * float(std::max(covering, 1)) * float(count)));
+
+            Ray ray(light.position, dir);
+            bool specularSeen = false;
+            for (int depth = 0; depth < Photons.maxDepth; ++depth) {
+                const Surface* hit;
+                float t = sc.findNearest(ray, &hit);
+                if (!hit) break;
+                vec3 p = ray.origin + ray.direction * t;
+                const Material& m = hit->material;
+                if (!m.specular()) {
+                    if (specularSeen) parts[c].push_back({ p, power, 0 });
+                    break;
+                }
+                specularSeen = true;
+                if (m.type == Material::MIRROR) power *= m.color;
+                ray = Ray(p, scatterSpecular(m, ray.direction, hit->normal(p), rng.nextFloat()));
+            }
+        }
+    });
+    for (auto& part : parts) {
+        out.insert(out.end(), part.begin(), part.end());
+        PhotonBuffer().swap(part);
+    }
+}
+
+//  ȿ   ִ   ( , ģ 迭, kd-tree ÿ   )
+int photonBudget(int count) {
+    while (count > 1000 && !memTracker.fits(size_t(count) * sizeof(Photon) * 3)) count /= 2;
+    return count;
+}
+
+// k-NN : p ó  k Ϸ  / (pi r^2), k  Ǹ ִ ݰ 
+vec3 photonEstimate(const PhotonMap& map, const vec3& p) {
+    PhotonMap::Neighbors q;
+    q.k = std::max(1, std::min(Photons.k, PhotonMap::MaxK));
+    q.found = 0;
+    q.maxDist2 = Photons.radius * Photons.radius;
+    map.nearest(p, q);
+    if (q.found == 0) return vec3(0.0f);
+    vec3 sum(0.0f);
+    for (int k = 0; k < q.found; ++k)
+        sum += map.photons[q.heap[k].second].power;
+    float r2 = (q.found < q.k) ? Photons.radius * Photons.radius : q.maxDist2;
+    return sum / (pi<float>() * r2);
+}
+
+// photonRadiance(): ſ/ ݻ   󰡰 (Fresnel ), Ȯ ǥ鿡   + caustic
+vec3 photonRadiance(const Scene& sc, const PhotonMap& map, const Ray& ray, int depth) {
+    const Surface* hit;
+    float t = sc.findNearest(ray, &hit);
+    if (!hit) return vec3(0.0f);
+    vec3 p = ray.origin + ray.direction * t;
+    vec3 n = hit->normal(p);
+    const Material& m = hit->material;
+    if (!m.specular()) {
+        if (dot(n, ray.direction) > 0.0f) n = -n;
+        return directLight(sc, p, n, m.color) + m.color / pi<float>() * photonEstimate(map, p);
+    }
+    if (depth + 1 >= Photons.maxDepth) return vec3(0.0f);
+    vec3 reflected = photonRadiance(sc, map, Ray(p, reflect(ray.direction, n)), depth + 1);
+    if (m.type == Material::MIRROR) return m.color * reflected;
+    vec3 refracted;
+    float f = glassInterface(m, ray.direction, n, refracted);
+    vec3 result = f * reflected;
+    if (f < 1.0f) result += (1.0f - f) * photonRadiance(sc, map, Ray(p, refracted), depth + 1);
+    return result;
+}
+
+// ProgressivePhotons:    ȼ  (ݰ^2,   ,  Ϸ,   )
+struct ProgressivePhotons {
+    std::vector<float, TrackedAllocator<float, MEM_FRAMEBUFFER> > radius2, count;
+    std::vector<vec3, TrackedAllocator<vec3, MEM_FRAMEBUFFER> > flux, direct;
+};
+
+// renderPhotons():   kd-tree  (cams[v] ̹ images[v]) 
+// Photons.passes 0̸ ȼ ߽ ray k-NN   , ƴϸ н   ȼ   ġ
+// ݰ    ݰ ٿ   (Hachisuka & Jensen stochastic progressive photon mapping)
+//   ī޶ Ƿ (н)      Բ 
+void renderPhotons(const std::vector<Camera>& cams, const Scene& sc, int nx, int ny, float* const* images,
+                   const Tile* crop = nullptr) {
+    int count = photonBudget(Photons.count);
+    if (count < Photons.count)
+        std::cerr << "[memory] budget too small for " << Photons.count << " photons, using " << count << std::endl;
+    std::vector<Tile> tiles = makeTiles(nx, ny, crop);
+    PhotonBuffer emitted;
+    PhotonMap map;
+
+    if (Photons.passes <= 0) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        emitPhotons(sc, count, 0, emitted);
+        map.build(emitted);
+        PhotonBuffer().swap(emitted);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "photons: " << count << " emitted, " << map.photons.size() << " stored ("
+                  << map.photons.size() * sizeof(Photon) << " B) in " << seconds << " s" << std::endl;
+        // ۾ k Ÿ k /    k %  
+        parallelFor(int(tiles.size() * cams.size()), [&](int k) {
+            const Tile& tile = tiles[k / cams.size()];
+            const Camera& cam = cams[k % cams.size()];
+            float* image = images[k % cams.size()];
+            for (int j = tile.y0; j < tile.y1; ++j) {
+                for (int i = tile.x0; i < tile.x1; ++i) {
+                    vec3 color = photonRadiance(sc, map, cam.generateRay(i, j, nx, ny), 0);
+                    float* dst = image + (j * nx + i) * 3;
+                    dst[0] = color.r;
+                    dst[1] = color.g;
+                    dst[2] = color.b;
+                }
+            }
+        });
+        return;
+    }
+
+    //  ´ 
+    std::vector<ProgressivePhotons> states(cams.size());
+    size_t pixels = size_t(nx) * ny;
+    for (ProgressivePhotons& state : states) {
+        state.radius2.assign(pixels, Photons.radius * Photons.radius);
+        state.count.assign(pixels, 0.0f);
+        state.flux.assign(pixels, vec3(0.0f));
+        state.direct.assign(pixels, vec3(0.0f));
+    }
+    for (int pass = 0; pass < Photons.passes; ++pass) {
+        emitPhotons(sc, count, uint64_t(pass), emitted);
+        map.build(emitted);
+        parallelFor(int(tiles.size() * cams.size()), [&](int k) {
+            const Tile& tile = tiles[k / cams.size()];
+            size_t v = k % cams.size();
+            const Camera& cam = cams[v];
+            ProgressivePhotons& state = states[v];
+            for (int j = tile.y0; j < tile.y1; ++j) {
+                for (int i = tile.x0; i < tile.x1; ++i) {
+                    size_t idx = size_t(j) * nx + i;
+                    Pcg32 rng(uint64_t(pass), idx + v * pixels);
+                    Ray ray = cam.generateRay(i + rng.nextFloat(), j + rng.nextFloat(), nx, ny);
+                    // ſ/  Ȯ ǥ鿡   ϳ ( Fresnel Ȯ ݻ/ )
+                    vec3 throughput(1.0f);
+                    for (int depth = 0; depth < Photons.maxDepth; ++depth) {
+                        const Surface* hit;
+                        float t = sc.findNearest(ray, &hit);
+                        if (!hit) break;
+                        vec3 p = ray.origin + ray.direction * t;
+                        vec3 n = hit->normal(p);
+                        const Material& m = hit->material;
+                        if (m.specular()) {
+                            if (m.type == Material::MIRROR) throughput *= m.color;
+                            ray = Ray(p, scatterSpecular(m, ray.direction, n, rng.nextFloat()));
+                            continue;
+                        }
+                        if (dot(n, ray.direction) > 0.0f) n = -n;
+                        vec3 weight = throughput * m.color;
+                        state.direct[idx] += directLight(sc, p, n, weight);
+                        int found = 0;
+                        vec3 phi(0.0f);
+                        map.range(p, state.radius2[idx], [&](const Photon& ph) {
+                            ++found;
+                            phi += ph.power;
+                        });
+                        if (found > 0) {
+                            float n0 = state.count[idx];
+                            float n1 = n0 + Photons.alpha * found;
+                            float ratio = n1 / (n0 + found);
+                            state.flux[idx] = (state.flux[idx] + weight / pi<float>() * phi) * ratio;
+                            state.radius2[idx] *= ratio;
+                            state.count[idx] = n1;
+                        }
+                        break;
+                    }
+                }
+            }
+        });
+    }
+    std::cout << "photons: " << Photons.passes << " passes of " << count << " photons, last map "
+              << map.photons.size() << " stored (" << map.photons.size() * sizeof(Photon) << " B)" << std::endl;
+    for (size_t v = 0; v < cams.size(); ++v) {
+        const ProgressivePhotons& state = states[v];
+        for (const Tile& tile : tiles) {
+            for (int j = tile.y0; j < tile.y1; ++j) {
+                for (int i = tile.x0; i < tile.x1; ++i) {
+                    size_t idx = size_t(j) * nx + i;
+                    vec3 color = (state.direct[idx] + state.flux[idx] / (pi<float>() * state.radius2[idx])) / float(Photons.passes);
+                    float* dst = images[v] + idx * 3;
+                    dst[0] = color.r;
+                    dst[1] = color.g;
+                    dst[2] = color.b;
+                }
+            }
+        }
+    }
+}
+
+// --------------------------
+//   (irradiance cache)
+// --------------------------
+
+// GI: Ȯ ǥ   ݱ ø ϰ irradiance cache 
+struct GISettings {
+    bool enabled = false;
+    int samples = 64;           // ڵ ϳ    ݱ ray 
+    bool cache = true;          // false ȼ ݱ ø (񱳿)
+    float error = 0.25f;        // Ward   a, Ŭ ڵ带 а 
+    float minSpacing = 0.05f;   // ڵ ȭ  Ÿ R  ( )
+    float maxSpacing = 4.0f;
+};
+GISettings GI;
+
+// IrradianceRecord:    irradiance äκ ȸ/̵ gradient (Ward & Heckbert)
+struct IrradianceRecord {
+    vec3 position;
+    vec3 normal;
+    vec3 irradiance;
+    float radius;
+    vec3 rotGrad[3];
+    vec3 transGrad[3];
+};
+
+// ChunkArena:   Ҹ ϳ Ҵϴ  ũ  迭 ( clear() Ѳ)
+// ޸   nullptr
+template <class T>
+class ChunkArena {
+public:
+    static const int ChunkSize = 4096;
+    static const int MaxChunks = 4096;
+    ChunkArena() : next(0) {
+        for (auto& c : chunks) c.store(nullptr);
+    }
+    ~ChunkArena() { clear(); }
+    T* alloc() {
+        size_t idx = next++;
+        size_t c = idx / ChunkSize;
+        if (c >= size_t(MaxChunks)) return nullptr;
+        T* chunk = chunks[c].load(std::memory_order_acquire);
+        if (!chunk) {
+            if (!memTracker.fits(sizeof(T) * ChunkSize)) return nullptr;
+            T* fresh = new T[ChunkSize];
+            if (chunks[c].compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel))
+                memTracker.add(MEM_ACCEL, sizeof(T) * ChunkSize), chunk = fresh;
+            else
+                delete[] fresh;
+        }
+        return chunk + idx % ChunkSize;
+    }
+    size_t size() const { return std::min(next.load(), size_t(MaxChunks) * ChunkSize); }
+    // ٸ 尡    ȣ
+    void clear() {
+        for (auto& c : chunks) {
+            T* chunk = c.exchange(nullptr);
+            if (chunk) {
+                delete[] chunk;
+                memTracker.sub(MEM_ACCEL, sizeof(T) * ChunkSize);
+            }
+        }
+        next = 0;
+    }
+private:
+    std::atomic<size_t> next;
+    std::atomic<T*> chunks[MaxChunks];
+};
+
+// IrradianceCache: ڵ带 ȿ ݰ濡 ´   ĭ(ִ 8ĭ) ִ   ؽ
+// ĭ    Ʈ, ȸ  p  ִ ĭ ϳ 
+// ڵ Ͽ Ǳ   ϵǹǷ   ȸ ߰ ÿ Ͼ 
+class IrradianceCache {
+public:
+    static const int Levels = 12;
+    static const int TableSize = 1 << 17;
+    uint64_t sceneKey = 0;  // ڵ带   (ī޶ ), ٲ 
+    std::atomic<size_t> lookups, hits;
+
+    IrradianceCache() : lookups(0), hits(0) {
+        keys = new std::atomic<uint64_t>[TableSize];
+        heads = new std::atomic<Link*>[TableSize];
+        memTracker.add(MEM_ACCEL, TableSize * (sizeof(std::atomic<uint64_t>) + sizeof(std::atomic<Link*>)));
+        clear();
+    }
+    ~IrradianceCache() {
+        delete[] keys;
+        delete[] heads;
+        memTracker.sub(MEM_ACCEL, TableSize * (sizeof(std::atomic<uint64_t>) + sizeof(std::atomic<Link*>)));
+    }
+    void clear() {
+        for (int k = 0; k < TableSize; ++k) {
+            keys[k].store(0);
+            heads[k].store(nullptr);
+        }
+        records.clear();
+        links.clear();
+        lookups = 0;
+        hits = 0;
+    }
+    size_t size() const { return records.size(); }
+    size_t bytes() const {
+        return records.size() * sizeof(IrradianceRecord) + links.size() * sizeof(Link)
+             + TableSize * (sizeof(std::atomic<uint64_t>) + sizeof(std::atomic<Link*>));
+    }
+
+    // p( n)   ִ ڵ ,  false
+    bool lookup(const vec3& p, const vec3& n, vec3& irradiance) {
+        ++lookups;
+        vec3 sum(0.0f);
+        float wsum = 0.0f;
+        float cell = baseCell();
+        for (int level = 0; level < Levels; ++level, cell *= 2.0f) {
+            int slot = findSlot(cellKey(level, p, cell), false);
+            if (slot < 0) continue;
+            for (const Link* l = heads[slot].load(std::memory_order_acquire); l; l = l->next) {
+                const IrradianceRecord& r = *l->record;
+                float w = weight(r, p, n);
+                if (w <= 0.0f) continue;
+                vec3 dn = cross(r.normal, n), dp = p - r.position;
+                vec3 e = r.irradiance;
+                for (int c = 0; c < 3; ++c)
+                    e[c] += dot(r.rotGrad[c], dn) + dot(r.transGrad[c], dp);
+                sum += w * max(e, vec3(0.0f));
+                wsum += w;
+            }
+        }
+        if (wsum <= 0.0f) return false;
+        ++hits;
+        irradiance = sum / wsum;
+        return true;
+    }
+
+    // ڵ ߰,  ϸ ߰ 
+    void insert(const IrradianceRecord& record) {
+        IrradianceRecord* r = records.alloc();
+        if (!r) return;
+        *r = record;
+        float extent = GI.error * r->radius;  // ġ 0 ū 
+        int level = 0;
+        float cell = baseCell();
+        while (level + 1 < Levels && cell < 2.0f * extent) {
+            ++level;
+            cell *= 2.0f;
+        }
+        ivec3 lo = cellIndex(r->position - vec3(extent), cell), hi = cellIndex(r->position + vec3(extent), cell);
+        for (int z = lo.z; z <= hi.z; ++z)
+            for (int y = lo.y; y <= hi.y; ++y)
+                for (int x = lo.x; x <= hi.x; ++x) {
+                    int slot = findSlot(packKey(level, ivec3(x, y, z)), true);
+                    Link* link = (slot >= 0) ? links.alloc() : nullptr;
+                    if (!link) continue;
+                    link->record = r;
+                    link->next = heads[slot].load(std::memory_order_relaxed);
+                    while (!heads[slot].compare_exchange_weak(link->next, link, std::memory_order_release)) {}
+                }
+    }
+
+private:
+    struct Link {
+        const IrradianceRecord* record;
+        Link* next;
+    };
+    std::atomic<uint64_t>* keys;
+    std::atomic<Link*>* heads;
+    ChunkArena<IrradianceRecord> records;
+    ChunkArena<Link> links;
+
+    static float baseCell() { return 2.0f * GI.error * GI.minSpacing; }
+    static ivec3 cellIndex(const vec3& p, float cell) {
+        return ivec3(int(floorf(p.x / cell)), int(floorf(p.y / cell)), int(floorf(p.z / cell)));
+    }
+    //  4Ʈ + ึ 20Ʈ, 0  ĭ ǥ÷ Ƿ 1 
+    static uint64_t packKey(int level, const ivec3& c) {
+        uint64_t key = uint64_t(level);
+        for (int a = 0; a < 3; ++a)
+            key = (key << 20) | (uint64_t(c[a] + (1 << 19)) & 0xFFFFF);
+        return key + 1;
+    }
+    static uint64_t cellKey(int level, const vec3& p, float cell) { return packKey(level, cellIndex(p, cell)); }
+
+    //  ּҹ, create  ĭ CAS , ǥ   -1
+    int findSlot(uint64_t key, bool create) {
+        uint64_t h = hashBytes(&key, sizeof(key));
+        for (int probe = 0; probe < 64; ++probe) {
+            int slot = int((h + probe) & (TableSize - 1));
+            uint64_t cur = keys[slot].load(std::memory_order_acquire);
+            if (cur == key) return slot;
+            if (cur == 0) {
+                if (!create) return -1;
+                if (keys[slot].compare_exchange_strong(cur, key, std::memory_order_acq_rel) || cur == key)
+                    return slot;
+            }
+        }
+        return -1;
+    }
+
+    // Ward ġ  ŭ  迡 0 ̾ , ڵ尡 p տ  0
+    static float weight(const IrradianceRecord& r, const vec3& p, const vec3& n) {
+        float cosN = dot(n, r.normal);
+        if (cosN <= 0.0f) return 0.0f;
+        vec3 dp = p - r.position;
+        if (dot(dp, (n + r.normal) * 0.5f) < -0.01f * r.radius) return 0.0f;
+        float e = length(dp) / r.radius + sqrtf(std::max(0.0f, 1.0f - cosN));
+        if (e >= GI.error) return 0.0f;
+        return 1.0f / std::max(e, 1e-6f) - 1.0f / GI.error;
+    }
+};
+
+// ǥ 2 MB Ƿ GI ĳø ó   renderGI() ,  ӿ ٽ 
+IrradianceCache* IrrCache = nullptr;
+
+// ݱ ray    : Ȯ ǥ  , ſ/    (   ƨ)
+vec3 secondaryRadiance(const Scene& sc, Ray ray, Pcg32& rng, float& distance) {
+    distance = FLT_MAX;
+    vec3 throughput(1.0f);
+    for (int depth = 0; depth < 4; ++depth) {
+        const Surface* hit;
+        float t = sc.findNearest(ray, &hit);
+        if (!hit) return vec3(0.0f);
+        if (depth == 0) distance = t;
+        vec3 p = ray.origin + ray.direction * t;
+        vec3 n = hit->normal(p);
+        const Material& m = hit->material;
+        if (!m.specular()) {
+            if (dot(n, ray.direction) > 0.0f) n = -n;
+            return throughput * directLight(sc, p, n, m.color);
+        }
+        if (m.type == Material::MIRROR) throughput *= m.color;
+        ray = Ray(p, scatterSpecular(m, ray.direction, n, rng.nextFloat()));
+    }
+    return vec3(0.0f);
+}
+
+// computeIrradiance(): M x N ȭ cos  ÷  irradiance gradient, ȭ  Ÿ 
+IrradianceRecord computeIrradiance(const Scene& sc, const vec3& p, const vec3& n) {
+    int M = std::max(2, int(sqrtf(GI.samples * 0.5f)));
+    int N = std::max(4, GI.samples / M);
+    vec3 b1, b2;
+    orthonormalBasis(n, b1, b2);
+    Pcg32 rng(hashBytes(&p, sizeof(p)), hashBytes(&n, sizeof(n)));
+    std::vector<vec3> L(M * N);
+    std::vector<float> R(M * N), sinTheta(M * N);
+    vec3 origin = p + n * 1e-3f;
+    float invDist = 0.0f;
+    for (int j = 0; j < M; ++j) {
+        for (int k = 0; k < N; ++k) {
+            float u1 = (j + rng.nextFloat()) / M;
+            float phi = 2.0f * pi<float>() * (k + rng.nextFloat()) / N;
+            float st = sqrtf(u1), ct = sqrtf(1.0f - u1);
+            vec3 dir = (st * cosf(phi)) * b1 + (st * sinf(phi)) * b2 + ct * n;
+            float d;
+            L[j * N + k] = secondaryRadiance(sc, Ray(origin, dir), rng, d);
+            R[j * N + k] = d;
+            sinTheta[j * N + k] = std::max(st, 1e-3f);
+            if (d < FLT_MAX) invDist += 1.0f / d;
+        }
+    }
+
+    IrradianceRecord r;
+    r.position = p;
+    r.normal = n;
+    r.irradiance = vec3(0.0f);
+    for (int c = 0; c < 3; ++c) r.rotGrad[c] = r.transGrad[c] = vec3(0.0f);
+    float scale = pi<float>() / float(M * N);
+    for (int k = 0; k < N; ++k) {
+        float phiK = 2.0f * pi<float>() * (k + 0.5f) / N;   //   
+        float phiKm = 2.0f * pi<float>() * k / N;           //   
+        vec3 uK = cosf(phiK) * b1 + sinf(phiK) * b2;
+        vec3 vK = -sinf(phiK) * b1 + cosf(phiK) * b2;
+        vec3 vKm = -sinf(phiKm) * b1 + cosf(phiKm) * b2;
+        int km = (k + N - 1) % N;
+        vec3 rotSum(0.0f);
+        for (int j = 0; j < M; ++j) {
+            const vec3& Ljk = L[j * N + k];
+            r.irradiance += Ljk * scale;
+            float st = sinTheta[j * N + k];
+            rotSum -= Ljk * (st / sqrtf(std::max(1.0f - st * st, 1e-6f)));
+            float sm = sqrtf(float(j) / M), sp = sqrtf(float(j + 1) / M);  // sin(theta_j-), sin(theta_j+)
+            float cm = sqrtf(1.0f - sm * sm), cp = sqrtf(1.0f - sp * sp);
+            // ̵ gradient: /Ʒ       踦   ȭ
+            if (j > 0) {
+                float rmin = std::min(R[j * N + k], R[(j - 1) * N + k]);
+                vec3 diff = Ljk - L[(j - 1) * N + k];
+                float f = 2.0f * pi<float>() / N * sm * cm * cm / rmin;
+                for (int c = 0; c < 3; ++c) r.transGrad[c] += uK * (f * diff[c]);
+            }
+            float rmin = std::min(R[j * N + k], R[j * N + km]);
+            vec3 diff = Ljk - L[j * N + km];
+            float f = (cm - cp) / (st * rmin);
+            for (int c = 0; c < 3; ++c) r.transGrad[c] += vKm * (f * diff[c]);
+        }
+        for (int c = 0; c < 3; ++c) r.rotGrad[c] += vK * (rotSum[c] * scale);
+    }
+
+    float harmonic = (invDist > 0.0f) ? float(M * N) / invDist : GI.maxSpacing;
+    // Ⱑ  ϴ  gradient ݰ  (Tabellion & Lamorlette)
+    float e = r.irradiance.r + r.irradiance.g + r.irradiance.b;
+    float g = length(r.transGrad[0] + r.transGrad[1] + r.transGrad[2]);
+    if (g > 0.0f) harmonic = std::min(harmonic, e / g);
+    r.radius = clamp(harmonic, GI.minSpacing, GI.maxSpacing);
+    return r;
+}
+
+// Ȯ ǥ   irradiance, ĳÿ ϰų  ؼ ߰
+vec3 indirectIrradiance(const Scene& sc, const vec3& p, const vec3& n) {
+    vec3 e;
+    if (GI.cache && IrrCache && IrrCache->lookup(p, n, e)) return e;
+    IrradianceRecord r = computeIrradiance(sc, p, n);
+    if (GI.cache && IrrCache) IrrCache->insert(r);
+    return r.irradiance;
+}
+
+// giRadiance():   +  Ȯ , ſ/ ݻ   
+vec3 giRadiance(const Scene& sc, const Ray& ray, int depth) {
+    const Surface* hit;
+    float t = sc.findNearest(ray, &hit);
+    if (!hit) return vec3(0.0f);
+    vec3 p = ray.origin + ray.direction * t;
+    vec3 n = hit->normal(p);
+    const Material& m = hit->material;
+    if (!m.specular()) {
+        if (dot(n, ray.direction) > 0.0f) n = -n;
+        return directLight(sc, p, n, m.color) + m.color / pi<float>() * indirectIrradiance(sc, p, n);
+    }
+    if (depth >= 6) return vec3(0.0f);
+    vec3 reflected = giRadiance(sc, Ray(p, reflect(ray.direction, n)), depth + 1);
+    if (m.type == Material::MIRROR) return m.color * reflected;
+    vec3 refracted;
+    float f = glassInterface(m, ray.direction, n, refracted);
+    vec3 result = f * reflected;
+    if (f < 1.0f) result += (1.0f - f) * giRadiance(sc, Ray(p, refracted), depth + 1);
+    return result;
+}
+
+// ī޶    ؽ,    ڵ带 ״ 
+uint64_t giSceneKey(const Scene& sc) {
+    std::ostringstream text;
+    writeScene(text, Camera(vec3(0.0f), -0.1f, 0.1f, -0.1f, 0.1f, 0.1f), sc);
+    text << "gi " << GI.samples << ' ' << GI.error << ' ' << GI.minSpacing << ' ' << GI.maxSpacing << '\n';
+    std::string s = text.str();
+    return hashBytes(s.data(), s.size());
+}
+
+// renderGI(): Ÿ  , ڵ ϸ鼭 ʿ  
+//   尡  ڵ带 ٸ 尡  Ƿ      ٸ  
+void renderGI(const Camera& cam, const Scene& sc, int nx, int ny, float* image, const Tile* crop = nullptr) {
+    IrradianceCache* cache = nullptr;
+    size_t before = 0;
+    if (GI.cache) {
+        if (!IrrCache) IrrCache = new IrradianceCache;
+        cache = IrrCache;
+        uint64_t key = giSceneKey(sc);
+        if (key != cache->sceneKey) {
+            cache->clear();
+            cache->sceneKey = key;
+        }
+        before = cache->size();
+        cache->lookups = 0;
+        cache->hits = 0;
+    }
+    std::vector<Tile> tiles = makeTiles(nx, ny, crop);
+    parallelFor(int(tiles.size()), [&](int k) {
+        const Tile& tile = tiles[k];
+        for (int j = tile.y0; j < tile.y1; ++j) {
+            for (int i = tile.x0; i < tile.x1; ++i) {
+                vec3 color = giRadiance(sc, cam.generateRay(i, j, nx, ny), 0);
+                float* dst = image + (j * nx + i) * 3;
+                dst[0] = color.r;
+                dst[1] = color.g;
+                dst[2] = color.b;
+            }
+        }
+    });
+    if (cache) {
+        size_t lookups = cache->lookups, hits = cache->hits;
+        std::cout << "irradiance cache: " << cache->size() << " records (" << cache->size() - before
+                  << " new, " << cache->bytes() << " B), " << (lookups ? 100.0 * hits / lookups : 0.0)
+                  << "% interpolated" << std::endl;
+    }
+}
+
+// --------------------------
+//  ߿䵵 ø (MIS)
+// --------------------------
+
+// MIS: Ȯ/ ǥ    ø BSDF ø Բ ϰ ޸ƽ 
+// LIGHT_ONLY, BSDF_ONLY     񱳿
+struct MISSettings {
+    enum Heuristic { BALANCE, POWER, LIGHT_ONLY, BSDF_ONLY };
+    bool enabled = false;
+    int samples = 4;              // ȼ  , ø   ϳ BSDF  ϳ
+    Heuristic heuristic = POWER;
+};
+MISSettings MIS;
+
+// pdf a    ġ (ٸ  pdf b)
+float misWeight(float a, float b) {
+    if (MIS.heuristic == MISSettings::BALANCE) return a / (a + b);
+    if (MIS.heuristic == MISSettings::POWER) return (a * a) / (a * a + b * b);
+    return 1.0f;
+}
+
+//  m BSDF  sampleBsdf() wi  ü pdf, wo wi ǥ鿡  
+// GLOSSY ȭ Phong ݻ ((e + 2) / 2pi cos^e),  Ȯ
+vec3 evalBsdf(const Material& m, const vec3& n, const vec3& wo, const vec3& wi, float& pdf) {
+    float cosTheta = dot(n, wi);
+    pdf = 0.0f;
+    if (cosTheta <= 0.0f) return vec3(0.0f);
+    if (m.type == Material::GLOSSY) {
+        float cosAlpha = std::max(dot(reflect(-wo, n), wi), 0.0f);
+        float lobe = powf(cosAlpha, m.exponent);
+        pdf = (m.exponent + 1.0f) / (2.0f * pi<float>()) * lobe;
+        return m.color * ((m.exponent + 2.0f) / (2.0f * pi<float>()) * lobe);
+    }
+    pdf = cosTheta / pi<float>();
+    return m.color / pi<float>();
+}
+
+// Ȯ cos  ݱ,  ݻ  ֺ cos^e κ (ǥ Ʒ    ׶ pdf 0)
+vec3 sampleBsdf(const Material& m, const vec3& n, const vec3& wo, float u1, float u2) {
+    if (m.type != Material::GLOSSY) return cosineHemisphere(n, u1, u2);
+    vec3 r = reflect(-wo, n), b1, b2;
+    orthonormalBasis(r, b1, b2);
+    float cosAlpha = powf(1.0f - u1, 1.0f / (m.exponent + 1.0f));
+    float sinAlpha = sqrtf(std::max(0.0f, 1.0f - cosAlpha * cosAlpha));
+    float phi = 2.0f * pi<float>() * u2;
+    return (sinAlpha * cosf(phi)) * b1 + (sinAlpha * sinf(phi)) * b2 + cosAlpha * r;
+}
+
+// p       ø pdf (ü), p  ̸ 0
+float sphereLightPdf(const SphereLight& light, const vec3& p) {
+    vec3 d = light.center - p;
+    float dist2 = dot(d, d), r2 = light.radius * light.radius;
+    if (dist2 <= r2) return 0.0f;
+    float sin2Max = r2 / dist2;
+    float oneMinusCos = sin2Max / (1.0f + sqrtf(1.0f - sin2Max));  //   е 
+    return 1.0f / (2.0f * pi<float>() * oneMinusCos);
+}
+
+vec3 sampleSphereLight(const SphereLight& light, const vec3& p, float u1, float u2) {
+    vec3 axis = normalize(light.center - p), b1, b2;
+    orthonormalBasis(axis, b1, b2);
+    vec3 d = light.center - p;
+    float sin2Max = light.radius * light.radius / dot(d, d);
+    float oneMinusCos = u1 * sin2Max / (1.0f + sqrtf(std::max(0.0f, 1.0f - sin2Max)));
+    float cosTheta = 1.0f - oneMinusCos;
+    float sinTheta = sqrtf(std::max(0.0f, oneMinusCos * (2.0f - oneMinusCos)));
+    float phi = 2.0f * pi<float>() * u2;
+    return (sinTheta * cosf(phi)) * b1 + (sinTheta * sinf(phi)) * b2 + cosTheta * axis;
+}
+
+// ray      t ȣ ( )
+float nearestSphereLight(const Scene& sc, const Ray& ray, int& index) {
+    float best = -1.0f;
+    index = -1;
+    for (int l = 0; l < int(sc.sphereLights.size()); ++l) {
+        float t = sc.sphereLights[l].intersect(ray);
+        if (t > 0.0f && (best < 0.0f || t < best)) {
+            best = t;
+            index = l;
+        }
+    }
+    return best;
+}
+
+// ShadowBatch:   ׸ ray  BVH::MaxPacket   ˻ϰ   ⿩ 
+struct ShadowBatch {
+    const Scene& sc;
+    std::vector<Ray> rays;
+    float tMax[BVH::MaxPacket];
+    vec3 contrib[BVH::MaxPacket];
+    vec3 sum;
+    size_t submitted = 0;  // occludedPacket() ȣ 
+    ShadowBatch(const Scene& s) : sc(s), sum(0.0f) { rays.reserve(BVH::MaxPacket); }
+    void add(const Ray& ray, float t, const vec3& c) {
+        if (c.r <= 0.0f && c.g <= 0.0f && c.b <= 0.0f) return;
+        if (rays.size() == size_t(BVH::MaxPacket)) flush();
+        tMax[rays.size()] = t;
+        contrib[rays.size()] = c;
+        rays.push_back(ray);
+    }
+    void flush() {
+        if (rays.empty()) return;
+        uint32_t blocked = sc.occludedPacket(&rays[0], tMax, int(rays.size()));
+        for (size_t k = 0; k < rays.size(); ++k)
+            if (!(blocked & (1u << k))) sum += contrib[k];
+        rays.clear();
+        ++submitted;
+    }
+};
+
+// Ȯ/ ǥ  p  ϳ,     ϳ, BSDF  ϳ batch ߰
+//  BSDF ÷   Ƿ ġ 1
+void addLightSamples(const Scene& sc, const vec3& p, const vec3& n, const vec3& wo, const Material& m,
+                     const vec3& throughput, Pcg32& rng, ShadowBatch& batch) {
+    vec3 origin = p + n * 1e-3f;
+    float pdf;
+    for (const auto& light : sc.lights) {
+        vec3 toLight = light.position - origin;
+        float dist2 = dot(toLight, toLight), dist = sqrtf(dist2);
+        vec3 wi = toLight / dist;
+        vec3 f = evalBsdf(m, n, wo, wi, pdf);
+        batch.add(Ray(origin, wi), dist - 1e-3f, throughput * f * light.power * (dot(n, wi) / (4.0f * pi<float>() * dist2)));
+    }
+    int count = int(sc.sphereLights.size());
+    if (count == 0) return;
+    float select = 1.0f / count;
+    if (MIS.heuristic != MISSettings::BSDF_ONLY) {
+        const SphereLight& light = sc.sphereLights[std::min(int(rng.nextFloat() * count), count - 1)];
+        float lightPdf = sphereLightPdf(light, origin) * select;
+        float u1 = rng.nextFloat(), u2 = rng.nextFloat();
+        if (lightPdf > 0.0f) {
+            Ray ray(origin, sampleSphereLight(light, origin, u1, u2));
+            float t = light.intersect(ray);
+            vec3 f = evalBsdf(m, n, wo, ray.direction, pdf);
+            if (t > 0.0f && pdf > 0.0f)
+                batch.add(ray, t - 1e-3f, throughput * f * light.radiance
+                          * (dot(n, ray.direction) / lightPdf * misWeight(lightPdf, pdf)));
+        }
+    }
+    if (MIS.heuristic != MISSettings::LIGHT_ONLY) {
+        float u1 = rng.nextFloat(), u2 = rng.nextFloat();
+        Ray ray(origin, sampleBsdf(m, n, wo, u1, u2));
+        vec3 f = evalBsdf(m, n, wo, ray.direction, pdf);
+        int index;
+        float t = nearestSphereLight(sc, ray, index);
+        if (pdf > 0.0f && t > 0.0f) {
+            const SphereLight& light = sc.sphereLights[index];
+            float lightPdf = sphereLightPdf(light, origin) * select;
+            batch.add(ray, t - 1e-3f, throughput * f * light.radiance
+                      * (dot(n, ray.direction) / pdf * misWeight(pdf, lightPdf)));
+        }
+    }
+}
+
+// ī޶ ray ϳ  : ſ/    󰡰,   ٷ   radiance
+// Ȯ/ ǥ  batch ߰Ǿ ߿ 
+vec3 misSample(const Scene& sc, Ray ray, Pcg32& rng, vec3 throughput, ShadowBatch& batch) {
+    for (int depth = 0; depth < 6; ++depth) {
+        const Surface* hit;
+        float t = sc.findNearest(ray, &hit);
+        int index;
+        float tl = nearestSphereLight(sc, ray, index);
+        if (tl > 0.0f && (!hit || tl < t)) return throughput * sc.sphereLights[index].radiance;
+        if (!hit) return vec3(0.0f);
+        vec3 p = ray.origin + ray.direction * t;
+        vec3 n = hit->normal(p);
+        const Material& m = hit->material;
+        if (m.specular()) {
+            if (m.type == Material::MIRROR) throughput *= m.color;
+            ray = Ray(p, scatterSpecular(m, ray.direction, n, rng.nextFloat()));
+            continue;
+        }
+        if (dot(n, ray.direction) > 0.0f) n = -n;
+        addLightSamples(sc, p, n, -ray.direction, m, throughput, rng, batch);
+        return vec3(0.0f);
+    }
+    return vec3(0.0f);
+}
+
+// renderMIS(): ȼ MIS.samples  ġ ,  ȼ ׸ ray    batch ˻
+//  Ʈ ȼ ȣ Ƿ     
+void renderMIS(const Camera& cam, const Scene& sc, int nx, int ny, float* image, const Tile* crop = nullptr) {
+    std::vector<Tile> tiles = makeTiles(nx, ny, crop);
+    std::atomic<size_t> submitted(0);
+    parallelFor(int(tiles.size()), [&](int k) {
+        const Tile& tile = tiles[k];
+        ShadowBatch batch(sc);
+        vec3 scale(1.0f / std::max(MIS.samples, 1));
+        for (int j = tile.y0; j < tile.y1; ++j) {
+            for (int i = tile.x0; i < tile.x1; ++i) {
+                Pcg32 rng(0, uint64_t(j) * nx + i);
+                vec3 color(0.0f);
+                for (int s = 0; s < MIS.samples; ++s) {
+                    float x = i + rng.nextFloat(), y = j + rng.nextFloat();
+                    color += misSample(sc, cam.generateRay(x, y, nx, ny), rng, scale, batch);
+                }
+                batch.flush();
+                color += batch.sum;
+                batch.sum = vec3(0.0f);
+                float* dst = image + (j * nx + i) * 3;
+                dst[0] = color.r;
+                dst[1] = color.g;
+                dst[2] = color.b;
+            }
+        }
+        submitted += batch.submitted;
+    });
+    std::cout << "mis: " << submitted << " shadow ray batches" << std::endl;
+}
+
+// --------------------------
+//     ø (ReSTIR)
+// --------------------------
+
+// ReSTIR:    ̸, ȼ  ĺ (reservoir) ϳ øϰ
+//  (ð) ֺ ȼ() Ҹ ļ ȼ ׸ ray     
+//  뿡 ̿  ü ٽ Ȯ Ƿ ణ 
+struct ReSTIRSettings {
+    bool enabled = false;
+    int candidates = 32;      // Ӹ ȼ  ̴  ĺ 
+    bool temporal = true;     //   Ҹ ؼ ħ
+    int neighbors = 4;        //  뿡  ̿ ȼ 
+    float radius = 16.0f;     // ̿  ݰ (ȼ)
+};
+ReSTIRSettings ReSTIR;
+
+// Reservoir: ȼ ϳ  (36Ʈ)
+// light  ȣ,     + ȣ, õ   -1
+// depth normal   ǥ ( ӿ  ȼ  ǥ Ǵ)
+struct Reservoir {
+    vec3 y;            // õ    (̸ ġ)
+    int32_t light;
+    float wSum;
+    float W;           // õ  ⿩ ġ wSum / (M p(y))
+    uint32_t M;
+    float depth;       //  ǥ Ÿ, ǥ  
+    uint32_t normal;   // packSnorm4x8  ǥ 
+
+    void clear() {
+        light = -1;
+        wSum = W = 0.0f;
+        M = 0;
+    }
+    // ġ w ĺ ϳ , u [0, 1) 
+    void update(int l, const vec3& p, float w, uint32_t count, float u) {
+        wSum += w;
+        M += count;
+        if (w > 0.0f && u * wSum < w) {
+            light = l;
+            y = p;
+        }
+    }
+    // õ  ǥ е pHat W 
+    void finalize(float pHat) {
+        W = (pHat > 0.0f && M > 0) ? wSum / (float(M) * pHat) : 0.0f;
+    }
+};
+typedef std::vector<Reservoir, TrackedAllocator<Reservoir, MEM_FRAMEBUFFER> > ReservoirBuffer;
+
+// OutputImage  ũ ȼ ,   ð 뿡 
+ReservoirBuffer Reservoirs;
+
+//  ̿ ϴ , ػ󵵳   ٲ Ҹ 
+struct ReSTIRHistory {
+    int nx = 0, ny = 0;
+    size_t lightCount = 0;
+    uint32_t frame = 0;
+    bool valid = false;
+    Camera camera = Camera(vec3(0.0f), -0.1f, 0.1f, -0.1f, 0.1f, 0.1f);
+};
+ReSTIRHistory ReSTIRState;
+
+//   ȸ  ȼ ǥ 
+struct ShadingPoint {
+    vec3 p, n, wo;
+    vec3 throughput;   // ī޶󿡼 ǥ ſ/ ݻ
+    vec3 emitted;      //   ٷ   radiance
+    const Material* material;  // Ȯ/ ǥ  nullptr
+    float depth;
+};
+
+//  l   y ǥ s ִ ׸ڸ  ⿩ (  power / 4pi)
+vec3 lightContribution(const Scene& sc, const ShadingPoint& s, int l, const vec3& y) {
+    vec3 toLight = y - s.p;
+    float dist2 = dot(toLight, toLight);
+    if (dist2 <= 0.0f) return vec3(0.0f);
+    vec3 wi = toLight / sqrtf(dist2);
+    float pdf;
+    vec3 f = evalBsdf(*s.material, s.n, s.wo, wi, pdf);
+    if (pdf <= 0.0f) return vec3(0.0f);
+    int points = int(sc.lights.size());
+    if (l < points) return f * sc.lights[l].power * (dot(s.n, wi) / (4.0f * pi<float>() * dist2));
+    const SphereLight& light = sc.sphereLights[l - points];
+    float cosLight = dot((y - light.center) / light.radius, -wi);
+    if (cosLight <= 0.0f) return vec3(0.0f);
+    return f * light.radiance * (dot(s.n, wi) * cosLight / dist2);
+}
+
+// ø ǥ е: ׸ڸ  ⿩ ֵ
+float targetPdf(const Scene& sc, const ShadingPoint& s, int l, const vec3& y) {
+    if (l < 0) return 0.0f;
+    vec3 c = lightContribution(sc, s, l, y);
+    return dot(c, vec3(0.2126f, 0.7152f, 0.0722f));
+}
+
+//  ϳ ϰ     ,   s  ݱ   (pdf  )
+float sampleLightPoint(const Scene& sc, const ShadingPoint& s, Pcg32& rng, int& l, vec3& y) {
+    int points = int(sc.lights.size());
+    int count = points + int(sc.sphereLights.size());
+    l = std::min(int(rng.nextFloat() * count), count - 1);
+    float u1 = rng.nextFloat(), u2 = rng.nextFloat();
+    if (l < points) {
+        y = sc.lights[l].position;
+        return 1.0f / count;
+    }
+    const SphereLight& light = sc.sphereLights[l - points];
+    vec3 axis = s.p - light.center, b1, b2;
+    axis = (dot(axis, axis) > 0.0f) ? normalize(axis) : vec3(0.0f, 1.0f, 0.0f);
+    orthonormalBasis(axis, b1, b2);
+    float z = u1, r = sqrtf(std::max(0.0f, 1.0f - z * z));
+    float phi = 2.0f * pi<float>() * u2;
+    y = light.center + light.radius * ((r * cosf(phi)) * b1 + (r * sinf(phi)) * b2 + z * axis);
+    return 1.0f / (count * 2.0f * pi<float>() * light.radius * light.radius);
+}
+
+// ȼ ߽ ray  ù Ȯ/ ǥ ã (ſ/    )
+ShadingPoint primarySurface(const Scene& sc, Ray ray, Pcg32& rng) {
+    ShadingPoint s;
+    s.material = nullptr;
+    s.throughput = vec3(1.0f);
+    s.emitted = vec3(0.0f);
+    s.depth = -1.0f;
+    float travelled = 0.0f;
+    for (int depth = 0; depth < 6; ++depth) {
+        const Surface* hit;
+        float t = sc.findNearest(ray, &hit);
+        int index;
+        float tl = nearestSphereLight(sc, ray, index);
+        if (tl > 0.0f && (!hit || tl < t)) {
+            s.emitted = s.throughput * sc.sphereLights[index].radiance;
+            return s;
+        }
+        if (!hit) return s;
+        travelled += t;
+        vec3 p = ray.origin + ray.direction * t;
+        vec3 n = hit->normal(p);
+        const Material& m = hit->material;
+        if (m.specular()) {
+            if (m.type == Material::MIRROR) s.throughput *= m.color;
+            ray = Ray(p, scatterSpecular(m, ray.direction, n, rng.nextFloat()));
+            continue;
+        }
+        if (dot(n, ray.direction) > 0.0f) n = -n;
+        s.p = p + n * 1e-3f;
+        s.n = n;
+        s.wo = -ray.direction;
+        s.material = &m;
+        s.depth = (depth == 0) ? travelled : -1.0f;  // ݻ/  ǥ  
+        return s;
+    }
+    return s;
+}
+
+//  p ī޶ cam  ȼ ̴ (generateRay() ), ȭ ̸ false
+bool projectToPixel(const Camera& cam, const vec3& p, int nx, int ny, int& i, int& j) {
+    vec3 dir = p - cam.eye;
+    float w = -dot(dir, cam.axisW);
+    if (w <= 0.0f) return false;
+    float u = dot(dir, cam.axisU) * cam.d / w;
+    float v = dot(dir, cam.axisV) * cam.d / w;
+    float x = (u - cam.l) / (cam.r - cam.l) * nx;
+    float y = (v - cam.b) / (cam.t - cam.b) * ny;
+    if (x < 0.0f || y < 0.0f || x >= nx || y >= ny) return false;
+    i = int(x);
+    j = int(y);
+    return true;
+}
+
+//  ǥ (, ) ϴ ̿  n ǥ ٰ  ŭ 
+bool similarSurface(const vec3& n, float expected, float depth, uint32_t normal) {
+    if (expected < 0.0f || depth < 0.0f) return false;
+    if (fabsf(depth - expected) > 0.1f * expected) return false;
+    return dot(vec3(unpackSnorm4x8(normal)), n) > 0.9f;
+}
+
+// ׸ ray õ  ̴ Ȯ
+bool lightVisible(const Scene& sc, const ShadingPoint& s, const vec3& y) {
+    vec3 toLight = y - s.p;
+    float dist = length(toLight);
+    return !sc.occluded(Ray(s.p, toLight), dist * (1.0f - 1e-3f));
+}
+
+// renderReSTIR(): 1) ȼ ĺ ø +    ġ, ü Ȯ (׸ ray 1)
+// 2) ̿ Ҹ ġ  ÷  (׸ ray 2), 1) Ҵ  ӿ 
+void renderReSTIR(const Camera& cam, const Scene& sc, int nx, int ny, float* image, const Tile* crop = nullptr) {
+    size_t lightCount = sc.lights.size() + sc.sphereLights.size();
+    ReSTIRHistory& history = ReSTIRState;
+    if (history.nx != nx || history.ny != ny || history.lightCount != lightCount) {
+        Reservoirs.assign(size_t(nx) * ny, Reservoir());
+        for (auto& r : Reservoirs) {
+            r.clear();
+            r.depth = -1.0f;
+        }
+        history.nx = nx;
+        history.ny = ny;
+        history.lightCount = lightCount;
+        history.valid = false;
+    }
+    bool temporal = ReSTIR.temporal && history.valid;
+    uint32_t frame = history.frame++;
+    int x0 = 0, y0 = 0, x1 = nx, y1 = ny;
+    if (crop) {
+        x0 = std::max(crop->x0, 0);
+        y0 = std::max(crop->y0, 0);
+        x1 = std::min(crop->x1, nx);
+        y1 = std::min(crop->y1, ny);
+    }
+
+    std::vector<ShadingPoint, TrackedAllocator<ShadingPoint, MEM_SCRATCH> > points(size_t(nx) * ny);
+    std::vector<Reservoir, TrackedAllocator<Reservoir, MEM_SCRATCH> > initial(size_t(nx) * ny);
+    std::vector<Tile> tiles = makeTiles(nx, ny, crop);
+    parallelFor(int(tiles.size()), [&](int k) {
+        const Tile& tile = tiles[k];
+        for (int j = tile.y0; j < tile.y1; ++j) {
+            for (int i = tile.x0; i < tile.x1; ++i) {
+                size_t p = size_t(j) * nx + i;
+                Pcg32 rng(frame, p);
+                ShadingPoint& s = points[p];
+                s = primarySurface(sc, cam.generateRay(i, j, nx, ny), rng);
+                Reservoir& r = initial[p];
+                r.clear();
+                r.depth = s.depth;
+                r.normal = s.material ? packSnorm4x8(vec4(s.n, 0.0f)) : 0;
+                if (!s.material || lightCount == 0) continue;
+                for (int c = 0; c < ReSTIR.candidates; ++c) {
+                    int l;
+                    vec3 y;
+                    float pdf = sampleLightPoint(sc, s, rng, l, y);
+                    r.update(l, y, targetPdf(sc, s, l, y) / pdf, 1, rng.nextFloat());
+                }
+                r.finalize(targetPdf(sc, s, r.light, r.y));
+                int ti, tj;
+                if (temporal && s.depth > 0.0f && projectToPixel(history.camera, s.p, nx, ny, ti, tj)) {
+                    //  ī޶󿡼  Ÿ  ȼ  Ÿ ƾ  ǥ
+                    const Reservoir& prev = Reservoirs[size_t(tj) * nx + ti];
+                    if (prev.light >= 0 && similarSurface(s.n, length(s.p - history.camera.eye), prev.depth, prev.normal)) {
+                        //   ʹ ū   ʵ M 
+                        uint32_t m = std::min(prev.M, uint32_t(20 * ReSTIR.candidates));
+                        r.update(prev.light, prev.y, targetPdf(sc, s, prev.light, prev.y) * prev.W * m, m, rng.nextFloat());
+                        r.finalize(targetPdf(sc, s, r.light, r.y));
+                    }
+                }
+                if (r.light >= 0 && !lightVisible(sc, s, r.y)) r.W = 0.0f;
+            }
+        }
+    });
+
+    parallelFor(int(tiles.size()), [&](int k) {
+        const Tile& tile = tiles[k];
+        for (int j = tile.y0; j < tile.y1; ++j) {
+            for (int i = tile.x0; i < tile.x1; ++i) {
+                size_t p = size_t(j) * nx + i;
+                const ShadingPoint& s = points[p];
+                const Reservoir& r = initial[p];
+                vec3 color = s.emitted;
+                if (s.material && lightCount > 0) {
+                    Pcg32 rng(frame, p + size_t(nx) * ny);
+                    // ڱ Ҹ   ٽ ־ ̿ ϰ ħ
+                    Reservoir merged;
+                    merged.clear();
+                    merged.update(r.light, r.y, targetPdf(sc, s, r.light, r.y) * r.W * r.M, r.M, rng.nextFloat());
+                    for (int n = 0; n < ReSTIR.neighbors; ++n) {
+                        float angle = 2.0f * pi<float>() * rng.nextFloat();
+                        float dist = ReSTIR.radius * sqrtf(rng.nextFloat());
+                        int qi = i + int(dist * cosf(angle)), qj = j + int(dist * sinf(angle));
+                        if (qi < x0 || qj < y0 || qi >= x1 || qj >= y1 || (qi == i && qj == j)) continue;
+                        const Reservoir& q = initial[size_t(qj) * nx + qi];
+                        if (q.light < 0 || !similarSurface(s.n, s.depth, q.depth, q.normal)) continue;
+                        merged.update(q.light, q.y, targetPdf(sc, s, q.light, q.y) * q.W * q.M, q.M, rng.nextFloat());
+                    }
+                    merged.finalize(targetPdf(sc, s, merged.light, merged.y));
+                    if (merged.light >= 0 && merged.W > 0.0f && lightVisible(sc, s, merged.y))
+                        color += s.throughput * lightContribution(sc, s, merged.light, merged.y) * merged.W;
+                }
+                //    Ҹ  (ģ   ӿ ѱ  Ӹ )
+                Reservoirs[p] = r;
+                float* dst = image + p * 3;
+                dst[0] = color.r;
+                dst[1] = color.g;
+                dst[2] = color.b;
+            }
+        }
+    });
+    history.camera = cam;
+    history.valid = true;
+}
+
+// --------------------------
+//    ȳ (path guiding)
+// --------------------------
+
+// Path: Ȯ/ ǥ  ̾   (    ø,   MIS ħ)
+//  Ÿ  浹 Ÿ ̰ ׸ ray    
+// guide > 0̸ ݺ - Ʈ(SD-tree) нؼ   Ϻθ Ʈ  (Muller et al.)
+struct PathSettings {
+    bool enabled = false;
+    int samples = 16;                //  ̹ ȼ  
+    int maxDepth = 8;
+    int guide = 0;                   // н ݺ , ݺ k ȼ 2^k 
+    float guideFraction = 0.5f;      // н Ʈ   Ȯ ( BSDF)
+    size_t guideBudget = 32u << 20;  // Ʈ ü ޸  (Ʈ)
+};
+PathSettings Path;
+
+// std::atomic<float> fetch_add Ƿ CAS 
+inline void atomicAdd(std::atomic<float>& a, float v) {
+    float cur = a.load(std::memory_order_relaxed);
+    while (!a.compare_exchange_weak(cur, cur + v, std::memory_order_relaxed)) {}
+}
+
+// DTreeNode:   Ʈ , и麰  հ ڽ ȣ (0̸ ڽ )
+//  ߿ ո  ٲ  ݺ ̿ ٲ
+struct DTreeNode {
+    std::atomic<float> sum[4];
+    uint32_t child[4];
+    DTreeNode() {
+        for (int q = 0; q < 4; ++q) {
+            sum[q].store(0.0f, std::memory_order_relaxed);
+            child[q] = 0;
+        }
+    }
+    DTreeNode(const DTreeNode& o) { *this = o; }
+    DTreeNode& operator=(const DTreeNode& o) {
+        for (int q = 0; q < 4; ++q) {
+            sum[q].store(o.sum[q].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            child[q] = o.child[q];
+        }
+        return *this;
+    }
+    float total() const {
+        return sum[0].load(std::memory_order_relaxed) + sum[1].load(std::memory_order_relaxed)
+             + sum[2].load(std::memory_order_relaxed) + sum[3].load(std::memory_order_relaxed);
+    }
+};
+
+// DTree:  ,  (cos theta, phi) [0, 1]^2 ű   ǥ ( ü)
+class DTree {
+public:
+    std::vector<DTreeNode, TrackedAllocator<DTreeNode, MEM_ACCEL> > nodes;
+    DTree() : nodes(1) { }
+
+    static vec2 toSquare(const vec3& d) {
+        float phi = atan2f(d.y, d.x);
+        if (phi < 0.0f) phi += 2.0f * pi<float>();
+        return vec2(clamp((d.z + 1.0f) * 0.5f, 0.0f, 0.99999f), clamp(phi / (2.0f * pi<float>()), 0.0f, 0.99999f));
+    }
+    static vec3 fromSquare(const vec2& s) {
+        float z = 2.0f * s.x - 1.0f, r = sqrtf(std::max(0.0f, 1.0f - z * z));
+        float phi = 2.0f * pi<float>() * s.y;
+        return vec3(r * cosf(phi), r * sinf(phi), z);
+    }
+
+    float total() const { return nodes[0].total(); }
+
+    void record(const vec3& d, float value) {
+        vec2 s = toSquare(d);
+        for (uint32_t idx = 0;;) {
+            int q = quadrant(s);
+            atomicAdd(nodes[idx].sum[q], value);
+            if (!nodes[idx].child[q]) return;
+            idx = nodes[idx].child[q];
+        }
+    }
+
+    // ü  pdf
+    float pdf(const vec3& d) const {
+        vec2 s = toSquare(d);
+        float p = 1.0f;
+        for (uint32_t idx = 0;;) {
+            const DTreeNode& node = nodes[idx];
+            float t = node.total();
+            if (t <= 0.0f) break;
+            int q = quadrant(s);
+            p *= 4.0f * node.sum[q].load(std::memory_order_relaxed) / t;
+            if (!node.child[q]) break;
+            idx = node.child[q];
+        }
+        return p / (4.0f * pi<float>());
+    }
+
+    //  տ ϰ и  ,  и ȿ 
+    vec3 sample(Pcg32& rng) const {
+        vec2 origin(0.0f);
+        float size = 1.0f;
+        for (uint32_t idx = 0;;) {
+            const DTreeNode& node = nodes[idx];
+            float t = node.total();
+            if (t <= 0.0f) break;
+            float u = rng.nextFloat() * t;
+            int q = 0;
+            while (q < 3 && u >= node.sum[q].load(std::memory_order_relaxed)) u -= node.sum[q++].load(std::memory_order_relaxed);
+            size *= 0.5f;
+            origin += vec2(float(q & 1), float(q >> 1)) * size;
+            if (!node.child[q]) break;
+            idx = node.child[q];
+        }
+        float u1 = rng.nextFloat(), u2 = rng.nextFloat();
+        return fromSquare(origin + vec2(u1, u2) * size);
+    }
+
+    // stats       0 
+    // ü rho ū и ,   nodeBudget    
+    void rebuild(const DTree& stats, float rho, size_t& nodeBudget) {
+        nodes.assign(1, DTreeNode());
+        float total = stats.total();
+        if (total <= 0.0f) return;
+        struct Item { int statsIdx; float value; uint32_t idx; int depth; };  // statsIdx < 0̸ value 4  
+        std::vector<Item> stack(1, Item{ 0, total, 0, 0 });
+        while (!stack.empty()) {
+            Item it = stack.back();
+            stack.pop_back();
+            for (int q = 0; q < 4; ++q) {
+                float value = it.statsIdx >= 0 ? stats.nodes[it.statsIdx].sum[q].load(std::memory_order_relaxed) : it.value * 0.25f;
+                if (value <= rho * total || it.depth >= 20 || nodeBudget == 0) continue;
+                --nodeBudget;
+                uint32_t c = uint32_t(nodes.size());
+                nodes.push_back(DTreeNode());
+                nodes[it.idx].child[q] = c;
+                int statsChild = it.statsIdx >= 0 ? int(stats.nodes[it.statsIdx].child[q]) : 0;
+                stack.push_back(Item{ statsChild ? statsChild : -1, value, c, it.depth + 1 });
+            }
+        }
+    }
+
+private:
+    static int quadrant(vec2& s) {
+        int q = 0;
+        if (s.x >= 0.5f) { q |= 1; s.x -= 0.5f; }
+        if (s.y >= 0.5f) { q |= 2; s.y -= 0.5f; }
+        s *= 2.0f;
+        return q;
+    }
+};
+
+// DTreeWrapper:  Ʈ  ϳ  , ̹ ݺ ϴ Ʈ  ݺ н ø Ʈ
+struct DTreeWrapper {
+    DTree building, sampling;
+    std::atomic<uint32_t> records;
+    DTreeWrapper() : records(0) { }
+    DTreeWrapper(const DTreeWrapper& o) : building(o.building), sampling(o.sampling), records(o.records.load()) { }
+    DTreeWrapper& operator=(const DTreeWrapper& o) {
+        building = o.building;
+        sampling = o.sampling;
+        records = o.records.load();
+        return *this;
+    }
+};
+
+// SDTree:  (ü)       Ʈ,  DTreeWrapper
+class SDTree {
+public:
+    struct Node {
+        uint32_t child[2];  // 0̸ 
+        uint32_t tree;      //  DTreeWrapper ȣ
+        int axis;
+    };
+    std::vector<Node, TrackedAllocator<Node, MEM_ACCEL> > nodes;
+    std::vector<DTreeWrapper, TrackedAllocator<DTreeWrapper, MEM_ACCEL> > trees;
+    vec3 lo;
+    float size = 1.0f;
+
+    void reset(const vec3& lo_, const vec3& hi_) {
+        vec3 ext = hi_ - lo_;
+        size = std::max(std::max(ext.x, ext.y), std::max(ext.z, 1e-3f));
+        lo = (lo_ + hi_) * 0.5f - vec3(size * 0.5f);
+        nodes.assign(1, Node{ { 0, 0 }, 0, 0 });
+        trees.assign(1, DTreeWrapper());
+    }
+
+    // p     (     )
+    DTreeWrapper& leaf(const vec3& p) {
+        vec3 t = clamp((p - lo) / size, vec3(0.0f), vec3(0.99999f));
+        uint32_t idx = 0;
+        while (nodes[idx].child[0]) {
+            int a = nodes[idx].axis;
+            int side = t[a] >= 0.5f ? 1 : 0;
+            t[a] = t[a] * 2.0f - float(side);
+            idx = nodes[idx].child[side];
+        }
+        return trees[nodes[idx].tree];
+    }
+
+    size_t directionalNodes() const {
+        size_t n = 0;
+        for (const auto& t : trees) n += t.building.nodes.size() + t.sampling.nodes.size();
+        return n;
+    }
+    size_t bytes() const {
+        return nodes.size() * sizeof(Node) + trees.size() * sizeof(DTreeWrapper) + directionalNodes() * sizeof(DTreeNode);
+    }
+
+    // ݺ iteration  :    ,  Ʈ ø Ʈ ٲ    Ʈ 
+    // 带   budget Ѵ   
+    void refine(int iteration, size_t budget) {
+        const uint32_t threshold = uint32_t(12000.0f * sqrtf(float(1 << iteration)));
+        for (size_t idx = 0; idx < nodes.size(); ++idx) {
+            if (nodes[idx].child[0] || trees[nodes[idx].tree].records.load() <= threshold) continue;
+            const DTreeWrapper& parent = trees[nodes[idx].tree];
+            size_t growth = 2 * sizeof(Node) + sizeof(DTreeWrapper) + parent.building.nodes.size() * 2 * sizeof(DTreeNode);
+            if (bytes() + growth > budget || !memTracker.fits(growth)) continue;
+            uint32_t second = uint32_t(trees.size());
+            DTreeWrapper copy = parent;
+            copy.records = copy.records.load() / 2;
+            trees[nodes[idx].tree] = copy;
+            trees.push_back(copy);
+            uint32_t c = uint32_t(nodes.size());
+            int axis = nodes[idx].axis;
+            nodes.push_back(Node{ { 0, 0 }, nodes[idx].tree, (axis + 1) % 3 });
+            nodes.push_back(Node{ { 0, 0 }, second, (axis + 1) % 3 });
+            nodes[idx].child[0] = c;
+            nodes[idx].child[1] = c + 1;
+            //     ݺ  ٽ ˻
+        }
+        size_t fixed = nodes.size() * sizeof(Node) + trees.size() * sizeof(DTreeWrapper);
+        size_t nodeBudget = budget > fixed ? (budget - fixed) / sizeof(DTreeNode) : 0;
+        nodeBudget = nodeBudget > 2 * trees.size() ? nodeBudget - 2 * trees.size() : 0;  // Ʈ Ʈ  
+        for (auto& t : trees) {
+            t.sampling = t.building;
+            nodeBudget = nodeBudget > t.sampling.nodes.size() ? nodeBudget - t.sampling.nodes.size() : 0;
+        }
+        for (auto& t : trees) {
+            t.building.rebuild(t.sampling, 0.01f, nodeBudget);
+            t.records = 0;
+        }
+    }
+};
+
+//   ϳ: н ,  ,    radiance 
+struct GuideVertex {
+    DTreeWrapper* tree;
+    vec3 direction;
+    vec3 throughput;  // ī޶󿡼     ġ
+    vec3 radiance;
+    float pdf;
+};
+
+// power ޸ƽ
+float powerHeuristic(float a, float b) {
+    return (a * a) / (a * a + b * b);
+}
+
+// ׸ ray :  0, ƴϸ    ( )
+float shadowTransmittance(const Scene& sc, const Ray& ray, float tMax, Pcg32& rng) {
+    if (sc.occluded(ray, tMax)) return 0.0f;
+    float T = 1.0f;
+    for (const auto med : sc.media) {
+        T *= med->transmittance(ray, tMax, rng);
+        if (T <= 0.0f) break;
+    }
+    return T;
+}
+
+// pathRadiance():  ϳ radiance, guide  н  BSDF    train̸ 
+vec3 pathRadiance(const Scene& sc, Ray ray, Pcg32& rng, SDTree* guide, bool train) {
+    const int MaxVertices = 16;
+    GuideVertex verts[MaxVertices];
+    int nv = 0;
+    vec3 L(0.0f), throughput(1.0f);
+    float prevPdf = 0.0f;
+    bool specularBounce = true;
+    int lightCount = int(sc.sphereLights.size());
+    // ⿩ c ϰ, ռ     radiance 
+    auto add = [&](const vec3& c) {
+        L += c;
+        for (int v = 0; v < nv; ++v)
+            verts[v].radiance += c / max(verts[v].throughput, vec3(1e-6f));
+    };
+    for (int depth = 0; depth < Path.maxDepth; ++depth) {
+        const Surface* hit;
+        float t = sc.findNearest(ray, &hit);
+        int index;
+        float tl = nearestSphereLight(sc, ray, index);
+        bool lightFirst = tl > 0.0f && (!hit || tl < t);
+        //  ȿ ǥ̳    浹 Ͼ   漺 
+        float tMedium = lightFirst ? tl : (hit ? t : FLT_MAX);
+        const Medium* medium = nullptr;
+        for (const auto med : sc.media) {
+            float tc;
+            if (med->sampleCollision(ray, tMedium, rng, tc)) {
+                tMedium = tc;
+                medium = med;
+            }
+        }
+        if (medium) {
+            vec3 p = ray.origin + ray.direction * tMedium;
+            const float phase = 1.0f / (4.0f * pi<float>());
+            throughput *= medium->albedo;
+            for (const auto& light : sc.lights) {
+                vec3 toLight = light.position - p;
+                float dist2 = dot(toLight, toLight), dist = sqrtf(dist2);
+                float Tr = shadowTransmittance(sc, Ray(p, toLight), dist - 1e-3f, rng);
+                if (Tr > 0.0f) add(throughput * light.power * (phase * Tr / (4.0f * pi<float>() * dist2)));
+            }
+            if (lightCount > 0) {
+                const SphereLight& light = sc.sphereLights[std::min(int(rng.nextFloat() * lightCount), lightCount - 1)];
+                float lightPdf = sphereLightPdf(light, p) / lightCount;
+                float u1 = rng.nextFloat(), u2 = rng.nextFloat();
+                if (lightPdf > 0.0f) {
+                    Ray shadow(p, sampleSphereLight(light, p, u1, u2));
+                    float tLight = light.intersect(shadow);
+                    float Tr = tLight > 0.0f ? shadowTransmittance(sc, shadow, tLight - 1e-3f, rng) : 0.0f;
+                    if (Tr > 0.0f) add(throughput * light.radiance * (phase * Tr / lightPdf * powerHeuristic(lightPdf, phase)));
+                }
+            }
+            float u1 = rng.nextFloat(), u2 = rng.nextFloat();
+            ray = Ray(p, DTree::fromSquare(vec2(u1, u2)));  //    ,  Լ / pdf = 1
+            prevPdf = phase;
+            specularBounce = false;
+            if (depth >= 3) {
+                float q = std::min(std::max(throughput.r, std::max(throughput.g, throughput.b)), 0.95f);
+                if (rng.nextFloat() >= q) break;
+                throughput /= q;
+            }
+            continue;
+        }
+        if (lightFirst) {
+            const SphereLight& light = sc.sphereLights[index];
+            if (specularBounce) add(throughput * light.radiance);
+            else add(throughput * light.radiance * powerHeuristic(prevPdf, sphereLightPdf(light, ray.origin) / lightCount));
+            break;
+        }
+        if (!hit) break;
+        vec3 p = ray.origin + ray.direction * t;
+        vec3 n = hit->normal(p);
+        const Material& m = hit->material;
+        if (m.specular()) {
+            if (m.type == Material::MIRROR) throughput *= m.color;
+            ray = Ray(p, scatterSpecular(m, ray.direction, n, rng.nextFloat()));
+            specularBounce = true;
+            continue;
+        }
+        if (dot(n, ray.direction) > 0.0f) n = -n;
+        vec3 wo = -ray.direction, origin = p + n * 1e-3f;
+        DTreeWrapper* tree = guide ? &guide->leaf(p) : nullptr;
+        bool guided = tree && tree->sampling.total() > 0.0f;
+        float frac = guided ? Path.guideFraction : 0.0f;
+        float bsdfPdf;
+
+        //   
+        for (const auto& light : sc.lights) {
+            vec3 toLight = light.position - origin;
+            float dist2 = dot(toLight, toLight), dist = sqrtf(dist2);
+            vec3 wi = toLight / dist;
+            vec3 f = evalBsdf(m, n, wo, wi, bsdfPdf);
+            float Tr = bsdfPdf > 0.0f ? shadowTransmittance(sc, Ray(origin, wi), dist - 1e-3f, rng) : 0.0f;
+            if (Tr > 0.0f) add(throughput * f * light.power * (Tr * dot(n, wi) / (4.0f * pi<float>() * dist2)));
+        }
+        //   ϳ ø,   pdf(ȳ  BSDF ȥ) MIS
+        if (lightCount > 0) {
+            const SphereLight& light = sc.sphereLights[std::min(int(rng.nextFloat() * lightCount), lightCount - 1)];
+            float lightPdf = sphereLightPdf(light, origin) / lightCount;
+            float u1 = rng.nextFloat(), u2 = rng.nextFloat();
+            if (lightPdf > 0.0f) {
+                Ray shadow(origin, sampleSphereLight(light, origin, u1, u2));
+                float tLight = light.intersect(shadow);
+                vec3 f = evalBsdf(m, n, wo, shadow.direction, bsdfPdf);
+                float pathPdf = (1.0f - frac) * bsdfPdf + (guided ? frac * tree->sampling.pdf(shadow.direction) : 0.0f);
+                float Tr = (tLight > 0.0f && bsdfPdf > 0.0f) ? shadowTransmittance(sc, shadow, tLight - 1e-3f, rng) : 0.0f;
+                if (Tr > 0.0f)
+                    add(throughput * f * light.radiance * (Tr * dot(n, shadow.direction) / lightPdf * powerHeuristic(lightPdf, pathPdf)));
+            }
+        }
+
+        //  
+        vec3 wi;
+        if (guided && rng.nextFloat() < frac) wi = tree->sampling.sample(rng);
+        else {
+            float u1 = rng.nextFloat(), u2 = rng.nextFloat();
+            wi = sampleBsdf(m, n, wo, u1, u2);
+        }
+        vec3 f = evalBsdf(m, n, wo, wi, bsdfPdf);
+        float pdf = (1.0f - frac) * bsdfPdf + (guided ? frac * tree->sampling.pdf(wi) : 0.0f);
+        if (bsdfPdf <= 0.0f || pdf <= 0.0f) break;
+        throughput *= f * (dot(n, wi) / pdf);
+        if (train && tree && nv < MaxVertices)
+            verts[nv++] = GuideVertex{ tree, wi, throughput, vec3(0.0f), pdf };
+        prevPdf = pdf;
+        specularBounce = false;
+        ray = Ray(origin, wi);
+        // þ 귿
+        if (depth >= 3) {
+            float q = std::min(std::max(throughput.r, std::max(throughput.g, throughput.b)), 0.95f);
+            if (rng.nextFloat() >= q) break;
+            throughput /= q;
+        }
+    }
+    // ⺰  radiance   pdf   (Ի radiance  )
+    for (int v = 0; v < nv; ++v) {
+        float value = dot(verts[v].radiance, vec3(0.2126f, 0.7152f, 0.0722f)) / verts[v].pdf;
+        if (value > 0.0f && value < FLT_MAX) verts[v].tree->building.record(verts[v].direction, value);
+        verts[v].tree->records.fetch_add(1, std::memory_order_relaxed);
+    }
+    return L;
+}
+
+// ȼ samples ,  Ʈ (ݺ, ȼ) 
+void renderPathPass(const Camera& cam, const Scene& sc, int nx, int ny, float* image, const Tile* crop,
+                    int samples, uint64_t seed, SDTree* guide, bool train) {
+    std::vector<Tile> tiles = makeTiles(nx, ny, crop);
+    parallelFor(int(tiles.size()), [&](int k) {
+        const Tile& tile = tiles[k];
+        for (int j = tile.y0; j < tile.y1; ++j) {
+            for (int i = tile.x0; i < tile.x1; ++i) {
+                Pcg32 rng(seed, uint64_t(j) * nx + i);
+                vec3 color(0.0f);
+                for (int s = 0; s < samples; ++s) {
+                    float x = i + rng.nextFloat(), y = j + rng.nextFloat();
+                    color += pathRadiance(sc, cam.generateRay(x, y, nx, ny), rng, guide, train);
+                }
+                color /= float(samples);
+                float* dst = image + (j * nx + i) * 3;
+                dst[0] = color.r;
+                dst[1] = color.g;
+                dst[2] = color.b;
+            }
+        }
+    });
+}
+
+// renderPath(): ȳ  ݺ k 2^k ÷ н , н  Ʈ   ̹ 
+// Ʈ   Ի radiance     нϰ   Բ 
+void renderPath(const std::vector<Camera>& cams, const Scene& sc, int nx, int ny, float* const* images,
+                const Tile* crop = nullptr) {
+    if (Path.guide <= 0) {
+        for (size_t v = 0; v < cams.size(); ++v)
+            renderPathPass(cams[v], sc, nx, ny, images[v], crop, Path.samples, 0, nullptr, false);
+        return;
+    }
+    SDTree guide;
+    vec3 lo = cams[0].eye, hi = cams[0].eye;
+    for (const Camera& cam : cams) {
+        lo = min(lo, cam.eye);
+        hi = max(hi, cam.eye);
+    }
+    if (sc.built && sc.bvh.mode != BVH::NONE) {
+        lo = min(lo, sc.bvh.sceneLo);
+        hi = max(hi, sc.bvh.sceneHi);
+    }
+    for (const auto& light : sc.sphereLights) {
+        lo = min(lo, light.center - vec3(light.radius));
+        hi = max(hi, light.center + vec3(light.radius));
+    }
+    for (const auto med : sc.media) {
+        lo = min(lo, med->lo);
+        hi = max(hi, med->hi);
+    }
+    guide.reset(lo - vec3(1.0f), hi + vec3(1.0f));
+    size_t center = cams.size() / 2;
+    for (int it = 0; it < Path.guide; ++it) {
+        renderPathPass(cams[center], sc, nx, ny, images[center], crop, 1 << it, uint64_t(it) + 1, &guide, true);
+        guide.refine(it, Path.guideBudget);
+        std::cout << "guiding: iteration " << it << ", " << guide.trees.size() << " spatial leaves, "
+                  << guide.directionalNodes() << " directional nodes, " << guide.bytes() << " B" << std::endl;
+    }
+    for (size_t v = 0; v < cams.size(); ++v)
+        renderPathPass(cams[v], sc, nx, ny, images[v], crop, Path.samples, 0, &guide, false);
+}
+
+bool renderDistributed(const Camera& cam, const Scene& sc, const std::vector<Tile>& tiles, int nx, int ny, float* image);
+extern int TotalSamples;
+void renderProgressive(const Camera& cam, const Scene& sc, int nx, int ny, int totalSamples, float* image,
+                       const Tile* crop = nullptr);
+
+// renderFrame(): Ÿ     Ǵ  Ŀ 
+// crop    image   ȼ ״ 
+// AO,  ,  , MIS, ReSTIR,    ÿ
+void renderFrame(const Camera& cam, const Scene& sc, int nx, int ny, float* image, const Tile* crop = nullptr) {
+    if (AO.enabled) return renderAO(cam, sc, nx, ny, image, crop);
+    if (Photons.enabled) return renderPhotons(std::vector<Camera>(1, cam), sc, nx, ny, &image, crop);
+    if (GI.enabled) return renderGI(cam, sc, nx, ny, image, crop);
+    if (MIS.enabled) return renderMIS(cam, sc, nx, ny, image, crop);
+    if (ReSTIR.enabled) return renderReSTIR(cam, sc, nx, ny, image, crop);
+    if (Path.enabled) return renderPath(std::vector<Camera>(1, cam), sc, nx, ny, &image, crop);
+    std::vector<Tile> tiles = makeTiles(nx, ny, crop);
+    //  ġ  ٲ ̸̹Ƿ foveation ÿ
+    if (Foveation.enabled || !renderDistributed(cam, sc, tiles, nx, ny, image))
+        renderTilesLocal(cam, sc, tiles, nx, ny, image);
+}
+
+// renderImage():        (render()   Բ )
+//  (AO,  ,  , MIS, ReSTIR,  ) ڱ   Ƿ spp  renderFrame()
+//  ܿ spp > 0̸  , 0̸ ȼ ߽  
+void renderImage(const Camera& cam, const Scene& sc, int nx, int ny, int spp, float* image, const Tile* crop = nullptr) {
+    bool integrator = AO.enabled || Photons.enabled || GI.enabled || MIS.enabled || ReSTIR.enabled || Path.enabled;
+    if (spp > 0 && !integrator) renderProgressive(cam, sc, nx, ny, spp, image, crop);
+    else renderFrame(cam, sc, nx, ny, image, crop);
+}
+
+// --------------------------
+//    (׷, ī޶ )
+// --------------------------
+
+int ViewCount = 1;
+float ViewSpacing = 0.065f;           // ̿ ī޶  Ÿ (axisU )
+std::vector<FrameBuffer> ViewImages;  // 1   ̹ (0  OutputImage)
+
+//  ī޶ axisU  spacing   ġ (  ġ)
+std::vector<Camera> makeCameraRig(const Camera& center, int count, float spacing) {
+    std::vector<Camera> cams(count, center);
+    for (int k = 0; k < count; ++k)
+        cams[k].eye += center.axisU * ((k - (count - 1) * 0.5f) * spacing);
+    return cams;
+}
+
+extern std::vector<std::string> WorkerAddresses;
+
+// renderViews():  (cams[v] ̹ images[v])     
+// ī޶      Բ :  ʰ  ȳ Ʈ Ӹ  ,
+// irradiance cache(GI) ReSTIR Ҵ ̶    ڵ Ҹ   ̾ 
+// ȼ ߽       ϳ Ÿ Ǯ  Ÿϸ  ʷ ( BVH  ü ĳÿ )
+void renderViews(const std::vector<Camera>& cams, const Scene& sc, int nx, int ny, int spp, float* const* images,
+                 const Tile* crop = nullptr) {
+    auto eachView = [&]() {
+        for (size_t v = 0; v < cams.size(); ++v)
+            renderImage(cams[v], sc, nx, ny, spp, images[v], crop);
+    };
+    // renderFrame()  켱
+    if (AO.enabled) return eachView();
+    if (Photons.enabled) return renderPhotons(cams, sc, nx, ny, images, crop);
+    if (GI.enabled || MIS.enabled || ReSTIR.enabled) return eachView();
+    if (Path.enabled) return renderPath(cams, sc, nx, ny, images, crop);
+    if (spp > 0 || Foveation.enabled || !WorkerAddresses.empty()) return eachView();
+    std::vector<Tile> tiles = makeTiles(nx, ny, crop);
+    parallelFor(int(tiles.size()), [&](int k) {
+        const Tile& tile = tiles[k];
+        for (size_t v = 0; v < cams.size(); ++v)
+            renderTile(cams[v], sc, tile, nx, ny, images[v] + (tile.y0 * nx + tile.x0) * 3, nx);
+    });
+}
+
+// render():  ī޶  OutputImage 
+// CropWindow ְ  ̹    ٽ ؼ ռ
+void render() {
+    const int nx = 512, ny = 512;
+    const Tile* crop = nullptr;
+    if (hasCropWindow() && OutputImage.size() == size_t(nx * ny * 3))
+        crop = &CropWindow;
+    else {
+        OutputImage.clear();
+        OutputImage.resize(nx * ny * 3);
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (ViewCount > 1) {
+        //  :  ,  , foveation,  Ŀ    Ȱ 
+        ViewImages.resize(ViewCount - 1);
+        std::vector<float*> images(1, &OutputImage[0]);
+        for (auto& img : ViewImages) {
+            if (img.size() != OutputImage.size()) img.assign(OutputImage.size(), 0.0f);
+            images.push_back(&img[0]);
+        }
+        renderViews(makeCameraRig(*camera, ViewCount, ViewSpacing), *scene, nx, ny, TotalSamples, &images[0], crop);
+    }
+    else
+        renderImage(*camera, *scene, nx, ny, TotalSamples, &OutputImage[0], crop);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "render: " << makeTiles(nx, ny, crop).size() << " tiles in " << seconds << " s" << std::endl;
+    memTracker.report(std::cout);
+}
+
+// --------------------------
+//   üũƮ
+// --------------------------
+
+// ProgressiveRender: н ȼ     
+// ȼ   Ʈ  н 迡 ϹǷ
+// üũƮ ̾ ص ߴ   Ͱ Ʈ  
+class ProgressiveRender {
+public:
+    int nx = 0, ny = 0;
+    uint32_t pass = 0;
+    uint32_t samples = 0;    // ȼ    ( н SamplesPerPass   )
+    uint64_t sceneHash = 0;  // ٸ  üũƮ ҷ ʵ
+    std::vector<float, TrackedAllocator<float, MEM_FRAMEBUFFER> > accum;       // RGB 
+    std::vector<uint32_t, TrackedAllocator<uint32_t, MEM_FRAMEBUFFER> > counts;  // ȼ  
+    std::vector<uint64_t, TrackedAllocator<uint64_t, MEM_FRAMEBUFFER> > rngState;  // ȼ Pcg32  (stream = ȼ ȣ)
+
+    void reset(int nx_, int ny_, uint64_t hash) {
+        nx = nx_;
+        ny = ny_;
+        pass = 0;
+        samples = 0;
+        sceneHash = hash;
+        accum.assign(size_t(nx) * ny * 3, 0.0f);
+        counts.assign(size_t(nx) * ny, 0);
+        rngState.resize(size_t(nx) * ny);
+        for (size_t k = 0; k < rngState.size(); ++k)
+            rngState[k] = Pcg32(hash, k).state;
+    }
+
+    //  ȼ samples  ߰
+    void renderPass(const Camera& cam, const Scene& sc, int passSamples, const Tile* crop = nullptr) {
+        std::vector<Tile> tiles = makeTiles(nx, ny, crop);
+        parallelFor(int(tiles.size()), [&](int k) {
+            const Tile& tile = tiles[k];
+            for (int j = tile.y0; j < tile.y1; ++j) {
+                for (int i = tile.x0; i < tile.x1; ++i) {
+                    size_t p = size_t(j) * nx + i;
+                    Pcg32 rng;
+                    rng.state = rngState[p];
+                    rng.inc = (uint64_t(p) << 1u) | 1u;
+                    vec3 sum(0.0f);
+                    for (int n = 0; n < passSamples; ++n) {
+                        float x = i + rng.nextFloat();
+                        float y = j + rng.nextFloat();
+                        sum += trace(sc, cam.generateRay(x, y, nx, ny));
+                    }
+                    accum[p * 3] += sum.r;
+                    accum[p * 3 + 1] += sum.g;
+                    accum[p * 3 + 2] += sum.b;
+                    counts[p] += passSamples;
+                    rngState[p] = rng.state;
+                }
+            }
+        });
+        pass++;
+        samples += passSamples;
+    }
+
+    void resolve(float* image, const Tile* crop = nullptr) const {
+        for (const Tile& tile : makeTiles(nx, ny, crop)) {
+            for (int j = tile.y0; j < tile.y1; ++j) {
+                for (int i = tile.x0; i < tile.x1; ++i) {
+                    size_t p = size_t(j) * nx + i;
+                    float inv = counts[p] ? 1.0f / counts[p] : 0.0f;
+                    image[p * 3] = accum[p * 3] * inv;
+                    image[p * 3 + 1] = accum[p * 3 + 1] * inv;
+                    image[p * 3 + 2] = accum[p * 3 + 2] * inv;
+                }
+            }
+        }
+    }
+
+    // üũƮ : "EVCK", , nx, ny, pass, ȼ  ,  ؽ,  ,  ,   (ȣƮ Ʈ )
+    // ӽ Ͽ   ̸ ٲ㼭   Ǿ  üũƮ  
+    bool save(const std::string& path) const {
+        std::string tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp.c_str(), std::ios::binary);
+            if (!out) return false;
+            uint32_t header[6] = { 0x4B435645u, 2, uint32_t(nx), uint32_t(ny), pass, samples };
+            out.write(reinterpret_cast<const char*>(header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(&sceneHash), sizeof(sceneHash));
+            out.write(reinterpret_cast<const char*>(&accum[0]), accum.size() * sizeof(float));
+            out.write(reinterpret_cast<const char*>(&counts[0]), counts.size() * sizeof(uint32_t));
+            out.write(reinterpret_cast<const char*>(&rngState[0]), rngState.size() * sizeof(uint64_t));
+            if (!out) return false;
+        }
+#ifdef _WIN32
+        return MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        return std::rename(tmp.c_str(), path.c_str()) == 0;
+#endif
+    }
+
+    // ũ  ؽð   ҷ
+    bool load(const std::string& path, int nx_, int ny_, uint64_t hash) {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        if (!in) return false;
+        uint32_t header[6];
+        uint64_t fileHash;
+        in.read(reinterpret_cast<char*>(header), sizeof(header));
+        in.read(reinterpret_cast<char*>(&fileHash), sizeof(fileHash));
+        if (!in || header[0] != 0x4B435645u || header[1] != 2 || int(header[2]) != nx_ || int(header[3]) != ny_) {
+            std::cerr << "checkpoint: " << path << " has a different format or size, ignored" << std::endl;
+            return false;
+        }
+        if (fileHash != hash) {
+            std::cerr << "checkpoint: " << path << " belongs to a different scene, ignored" << std::endl;
+            return false;
+        }
+        reset(nx_, ny_, hash);
+        in.read(reinterpret_cast<char*>(&accum[0]), accum.size() * sizeof(float));
+        in.read(reinterpret_cast<char*>(&counts[0]), counts.size() * sizeof(uint32_t));
+        in.read(reinterpret_cast<char*>(&rngState[0]), rngState.size() * sizeof(uint64_t));
+        if (!in) {
+            std::cerr << "checkpoint: " << path << " is truncated, ignored" << std::endl;
+            reset(nx_, ny_, hash);
+            return false;
+        }
+        pass = header[4];
+        samples = header[5];
+        return true;
+    }
+};
+
+int TotalSamples = 0;              // 0̸ ȼ ߽   (   )
+std::string CheckpointPath;        //   üũƮ 
+double CheckpointInterval = 60.0;  // 
+int SamplesPerPass = 1;
+
+// , ػ, н  ,   ƾ üũƮ ̾   
+uint64_t progressiveHash(const Camera& cam, const Scene& sc, int nx, int ny, const Tile* crop) {
+    std::ostringstream text;
+    writeScene(text, cam, sc);
+    text << "image " << nx << ' ' << ny << " spp/pass " << SamplesPerPass << '\n';
+    if (crop) text << "crop " << crop->x0 << ' ' << crop->y0 << ' ' << crop->x1 << ' ' << crop->y1 << '\n';
+    std::string s = text.str();
+    return hashBytes(s.data(), s.size());
+}
+
+// ȼ totalSamples   н ݺ, CheckpointInterval ϰ   üũƮ  ̾ 
+void renderProgressive(const Camera& cam, const Scene& sc, int nx, int ny, int totalSamples, float* image,
+                       const Tile* crop) {
+    ProgressiveRender prog;
+    uint64_t hash = progressiveHash(cam, sc, nx, ny, crop);
+    uint32_t total = uint32_t(std::max(totalSamples, 0));
+    bool resumed = !CheckpointPath.empty() && prog.load(CheckpointPath, nx, ny, hash);
+    if (resumed && prog.samples > total) {
+        std::cerr << "checkpoint: " << CheckpointPath << " already has " << prog.samples
+                  << " samples per pixel, more than requested, ignored" << std::endl;
+        resumed = false;
+    }
+    if (resumed)
+        std::cout << "checkpoint: resumed at pass " << prog.pass << " (" << prog.samples << " spp)" << std::endl;
+    else
+        prog.reset(nx, ny, hash);
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point lastSave = Clock::now();
+    //  н  ø (--spp 10 --spp-per-pass 4 4, 4, 2)
+    while (prog.samples < total) {
+        prog.renderPass(cam, sc, int(std::min<uint32_t>(SamplesPerPass, total - prog.samples)), crop);
+        bool last = prog.samples == total;
+        if (!CheckpointPath.empty() &&
+            (last || std::chrono::duration<double>(Clock::now() - lastSave).count() >= CheckpointInterval)) {
+            if (!prog.save(CheckpointPath))
+                std::cerr << "checkpoint: cannot write " << CheckpointPath << std::endl;
+            lastSave = Clock::now();
+        }
+    }
+    prog.resolve(image, crop);
+}
+
+// --------------------------
+// л  (ڵ / Ŀ)
+// --------------------------
+
+#ifdef _WIN32
+typedef SOCKET NetSocket;
+const NetSocket BadSocket = INVALID_SOCKET;
+const int NetSendFlags = 0;
+void netClose(NetSocket s) { closesocket(s); }
+void netShutdown(NetSocket s) { shutdown(s, SD_BOTH); }
+#else
+typedef int NetSocket;
+const NetSocket BadSocket = -1;
+const int NetSendFlags = MSG_NOSIGNAL;  //  ῡ   SIGPIPE  ʵ
+void netClose(NetSocket s) { close(s); }
+void netShutdown(NetSocket s) { shutdown(s, SHUT_RDWR); }
+#endif
+
+bool netInit() {
+#ifdef _WIN32
+    static bool done = false;
+    if (!done) {
+        WSADATA wsa;
+        if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) return false;
+        done = true;
+    }
+#endif
+    return true;
+}
+
+NetSocket netConnect(const std::string& host, const std::string& port) {
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* res = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0) return BadSocket;
+    NetSocket s = BadSocket;
+    for (addrinfo* a = res; a; a = a->ai_next) {
+        s = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (s == BadSocket) continue;
+        if (connect(s, a->ai_addr, int(a->ai_addrlen)) == 0) break;
+        netClose(s);
+        s = BadSocket;
+    }
+    freeaddrinfo(res);
+    if (s != BadSocket) {
+        int one = 1;
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&one, sizeof(one));
+    }
+    return s;
+}
+
+// address(IPv4, "0.0.0.0"̸  ̽)  
+NetSocket netListen(int port, const std::string& address) {
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(uint16_t(port));
+    if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1) return BadSocket;
+    NetSocket s = socket(AF_INET, SOCK_STREAM, 0);
+    if (s == BadSocket) return BadSocket;
+    int one = 1;
+    setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char*)&one, sizeof(one));
+    if (bind(s, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(s, 8) != 0) {
+        netClose(s);
+        return BadSocket;
+    }
+    return s;
+}
+
+// /ޱ   seconds Ѱ ɸ ϰ  (    ٸ ʵ)
+void netSetTimeout(NetSocket s, int seconds) {
+#ifdef _WIN32
+    DWORD ms = DWORD(seconds) * 1000;
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, (const char*)&ms, sizeof(ms));
+    setsockopt(s, SOL_SOCKET, SO_SNDTIMEO, (const char*)&ms, sizeof(ms));
+#else
+    timeval tv = {};
+    tv.tv_sec = seconds;
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(s, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+#endif
+}
+
+bool netSendAll(NetSocket s, const void* data, size_t size) {
+    const char* p = static_cast<const char*>(data);
+    while (size > 0) {
+        int n = send(s, p, int(std::min(size, size_t(1 << 20))), NetSendFlags);
+        if (n <= 0) return false;
+        p += n;
+        size -= size_t(n);
+    }
+    return true;
+}
+
+bool netRecvAll(NetSocket s, void* data, size_t size) {
+    char* p = static_cast<char*>(data);
+    while (size > 0) {
+        int n = recv(s, p, int(std::min(size, size_t(1 << 20))), 0);
+        if (n <= 0) return false;
+        p += n;
+        size -= size_t(n);
+    }
+    return true;
+}
+
+// ޽: [ uint32][ uint32][],  μ  Ʈ  
+enum NetMessage {
+    MSG_SCENE_TEXT = 1,  // ڵ -> Ŀ: "image nx ny"  +   
+    MSG_SCENE_PATH,      // ڵ -> Ŀ: "image nx ny"  +    
+    MSG_HELLO,           // Ŀ -> ڵ: Ŀ   (int32)
+    MSG_TILES,           // ڵ -> Ŀ: Ÿ ȣ  (int32 x 5) 
+    MSG_PIXELS,          // Ŀ -> ڵ: Ÿ ȣ + RGB float, Ÿ ŭ ݺ
+    MSG_DONE             // ڵ -> Ŀ: ۾ 
+};
+
+bool netSendMessage(NetSocket s, uint32_t type, const void* data, uint32_t size) {
+    uint32_t header[2] = { type, size };
+    return netSendAll(s, header, sizeof(header)) && (size == 0 || netSendAll(s, data, size));
+}
+
+static const uint32_t MaxSceneMessage = 256u << 20;  //   
+static const uint32_t MaxPathMessage = 4096;          // "image nx ny"  +  
+static const uint32_t MaxTilesPerRequest = 65536;
+
+//  ִ : 밡  ̸ ״ Ҵ ʵ (MSG_PIXELS ޴   ũ⸦ )
+uint32_t netMessageLimit(uint32_t type) {
+    switch (type) {
+    case MSG_SCENE_TEXT: return MaxSceneMessage;
+    case MSG_SCENE_PATH: return MaxPathMessage;
+    case MSG_HELLO: return sizeof(int32_t);
+    case MSG_TILES: return MaxTilesPerRequest * 5 * sizeof(int32_t);
+    case MSG_PIXELS: return UINT32_MAX;
+    default: return 0;
+    }
+}
+
+// ̰  ѵ maxSize Ѱų ޸ 꿡     ʰ false
+bool netRecvMessage(NetSocket s, uint32_t& type, std::vector<char>& data, uint32_t maxSize = UINT32_MAX) {
+    uint32_t header[2];
+    if (!netRecvAll(s, header, sizeof(header))) return false;
+    type = header[0];
+    if (header[1] > std::min(maxSize, netMessageLimit(type)) || !memTracker.fits(header[1])) {
+        std::cerr << "net: rejected message type " << type << " of " << header[1] << " B" << std::endl;
+        return false;
+    }
+    data.resize(header[1]);
+    return header[1] == 0 || netRecvAll(s, &data[0], header[1]);
+}
+
+std::vector<std::string> WorkerAddresses;  // "host:port" ,    
+std::string SharedScenePath;               // Ǹ    θ 
+std::string WorkerBindAddress = "0.0.0.0";  // Ŀ   ּ
+std::string WorkerSceneDir;                // Ŀ η     ִ ͸ (   ź)
+
+// path( θ dir ) dir  ̸ ȭ , ƴϸ  ڿ (".." ɺ ũ Ǯ Ȯ)
+std::string resolveInside(const std::string& dir, const std::string& path) {
+#ifdef _WIN32
+    bool absolute = path.size() > 1 && (path[1] == ':' || path[0] == '\\' || path[0] == '/');
+    char base[_MAX_PATH], full[_MAX_PATH];
+    if (!_fullpath(base, dir.c_str(), sizeof(base)) ||
+        !_fullpath(full, (absolute ? path : dir + "\\" + path).c_str(), sizeof(full)))
+        return std::string();
+    const char sep = '\\';
+#else
+    bool absolute = !path.empty() && path[0] == '/';
+    char base[PATH_MAX], full[PATH_MAX];
+    if (!realpath(dir.c_str(), base) || !realpath((absolute ? path : dir + "/" + path).c_str(), full))
+        return std::string();
+    const char sep = '/';
+#endif
+    std::string prefix(base);
+    if (prefix.empty() || prefix.back() != sep) prefix += sep;
+    std::string result(full);
+    return result.compare(0, prefix.size(), prefix) == 0 ? result : std::string();
+}
+
+// ڵ  Ÿ 
+struct DistributedJob {
+    typedef std::chrono::steady_clock Clock;
+    std::mutex lock;
+    std::vector<int> state;          // 0 = , 1 =  , 2 = Ϸ
+    std::vector<int> copies;         //  Ÿ ó  Ŀ  (ä )
+    std::vector<Clock::time_point> started;
+    std::vector<NetSocket> sockets;  // Ŀ 
+    std::vector<char> busy;          // Ŀ  ٸ  (ó  ÿ)
+    size_t nextPending = 0;
+    int remaining = 0;
+    double avgLatency = 0.0;         // û ϳ  պ ð()
+
+    enum TakeResult { TAKE_OK, TAKE_WAIT, TAKE_DONE };
+
+    //   Ÿ  ְ,  պ ξ  ɸ Ÿ è
+    TakeResult take(int worker, int count, std::vector<int>& out) {
+        std::lock_guard<std::mutex> guard(lock);
+        out.clear();
+        if (remaining == 0) return TAKE_DONE;
+        Clock::time_point now = Clock::now();
+        while (int(out.size()) < count && nextPending < state.size()) {
+            int k = int(nextPending++);
+            if (state[k] != 0) continue;
+            state[k] = 1;
+            copies[k]++;
+            started[k] = now;
+            out.push_back(k);
+        }
+        if (out.empty() && avgLatency > 0.0) {
+            for (size_t k = 0; k < state.size() && int(out.size()) < count; ++k) {
+                double elapsed = std::chrono::duration<double>(now - started[k]).count();
+                if (state[k] == 1 && copies[k] == 1 && elapsed > 2.0 * avgLatency) {
+                    copies[k]++;
+                    out.push_back(int(k));
+                }
+            }
+        }
+        if (out.empty()) return TAKE_WAIT;
+        busy[worker] = 1;
+        return TAKE_OK;
+    }
+    //    ,  true
+    //  Ÿ    ٸ ٸ Ŀ   ٸ ʰ 
+    bool finish(int worker, int k) {
+        std::lock_guard<std::mutex> guard(lock);
+        copies[k]--;
+        if (state[k] == 2) return false;
+        state[k] = 2;
+        if (--remaining == 0) {
+            for (size_t w = 0; w < sockets.size(); ++w)
+                if (int(w) != worker && busy[w]) netShutdown(sockets[w]);
+        }
+        return true;
+    }
+    void requestDone(int worker, double seconds) {
+        std::lock_guard<std::mutex> guard(lock);
+        busy[worker] = 0;
+        avgLatency = (avgLatency == 0.0) ? seconds : 0.8 * avgLatency + 0.2 * seconds;
+    }
+    //   Ŀ Ÿ ٽ  ·
+    void release(int worker, const std::vector<int>& ks) {
+        std::lock_guard<std::mutex> guard(lock);
+        busy[worker] = 0;
+        for (int k : ks) {
+            copies[k]--;
+            if (state[k] == 1 && copies[k] == 0) {
+                state[k] = 0;
+                nextPending = std::min(nextPending, size_t(k));
+            }
+        }
+    }
+};
+
+// Ŀ ϳ ϴ ڵ 
+void coordinateWorker(int worker, const std::string& sceneMessage, uint32_t sceneType,
+                      DistributedJob& job, const std::vector<Tile>& tiles, int nx, float* image) {
+    NetSocket s = job.sockets[worker];
+    uint32_t type;
+    std::vector<char> data;
+    if (!netSendMessage(s, sceneType, sceneMessage.data(), uint32_t(sceneMessage.size())) ||
+        !netRecvMessage(s, type, data, sizeof(int32_t)) || type != MSG_HELLO || data.size() != sizeof(int32_t))
+        return;
+    int32_t workerThreads;
+    memcpy(&workerThreads, &data[0], sizeof(workerThreads));
+    int batch = std::max(1, int(workerThreads)) * 2;
+
+    std::vector<int> taken;
+    std::vector<int32_t> request;
+    while (true) {
+        DistributedJob::TakeResult r = job.take(worker, batch, taken);
+        if (r == DistributedJob::TAKE_DONE) break;
+        if (r == DistributedJob::TAKE_WAIT) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            continue;
+        }
+        DistributedJob::Clock::time_point begin = DistributedJob::Clock::now();
+        request.clear();
+        size_t expected = 0;
+        for (int k : taken) {
+            const Tile& tile = tiles[k];
+            int32_t rec[5] = { k, tile.x0, tile.y0, tile.x1, tile.y1 };
+            request.insert(request.end(), rec, rec + 5);
+            expected += sizeof(int32_t) + size_t(tile.width()) * tile.height() * 3 * sizeof(float);
+        }
+        if (!netSendMessage(s, MSG_TILES, &request[0], uint32_t(request.size() * sizeof(int32_t))) ||
+            !netRecvMessage(s, type, data, uint32_t(std::min<size_t>(expected, UINT32_MAX))) || type != MSG_PIXELS) {
+            job.release(worker, taken);
+            return;
+        }
+        size_t offset = 0;
+        for (size_t n = 0; n < taken.size(); ++n) {
+            int k = taken[n];
+            const Tile& tile = tiles[k];
+            size_t bytes = size_t(tile.width()) * tile.height() * 3 * sizeof(float);
+            int32_t id;
+            if (offset + sizeof(id) + bytes > data.size()) {
+                job.release(worker, std::vector<int>(taken.begin() + n, taken.end()));
+                return;
+            }
+            memcpy(&id, &data[offset], sizeof(id));
+            offset += sizeof(id);
+            if (id == k && job.finish(worker, k)) {
+                const float* src = reinterpret_cast<const float*>(&data[offset]);
+                for (int row = 0; row < tile.height(); ++row)
+                    memcpy(image + ((tile.y0 + row) * nx + tile.x0) * 3,
+                           src + row * tile.width() * 3, tile.width() * 3 * sizeof(float));
+            }
+            offset += bytes;
+        }
+        job.requestDone(worker, std::chrono::duration<double>(DistributedJob::Clock::now() - begin).count());
+    }
+    netSendMessage(s, MSG_DONE, nullptr, 0);
+}
+
+// Ŀ Ǿ  Ÿ    image 
+//  Ŀ  ϸ false (  ü), ߰  Ÿ ÿ 
+bool renderDistributed(const Camera& cam, const Scene& sc, const std::vector<Tile>& tiles, int nx, int ny, float* image) {
+    if (WorkerAddresses.empty() || !netInit()) return false;
+
+    std::ostringstream msg;
+    msg << "image " << nx << ' ' << ny << '\n';
+    uint32_t sceneType = MSG_SCENE_TEXT;
+    if (!SharedScenePath.empty()) {
+        msg << SharedScenePath;
+        sceneType = MSG_SCENE_PATH;
+    }
+    else writeScene(msg, cam, sc);
+    std::string sceneMessage = msg.str();
+
+    std::vector<NetSocket> sockets;
+    for (const auto& addr : WorkerAddresses) {
+        size_t colon = addr.rfind(':');
+        NetSocket s = (colon == std::string::npos) ? BadSocket
+            : netConnect(addr.substr(0, colon), addr.substr(colon + 1));
+        if (s == BadSocket) std::cerr << "distributed: cannot connect to " << addr << std::endl;
+        else sockets.push_back(s);
+    }
+    if (sockets.empty()) return false;
+
+    DistributedJob job;
+    job.state.assign(tiles.size(), 0);
+    job.copies.assign(tiles.size(), 0);
+    job.started.resize(tiles.size());
+    job.sockets = sockets;
+    job.busy.assign(sockets.size(), 1);
+    job.remaining = int(tiles.size());
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < sockets.size(); ++w)
+        threads.push_back(std::thread(coordinateWorker, int(w), std::cref(sceneMessage), sceneType,
+                                      std::ref(job), std::cref(tiles), nx, image));
+    for (auto& th : threads) th.join();
+    for (NetSocket s : sockets) netClose(s);
+
+    if (job.remaining > 0) {
+        std::vector<Tile> rest;
+        for (size_t k = 0; k < tiles.size(); ++k)
+            if (job.state[k] != 2) rest.push_back(tiles[k]);
+        std::cerr << "distributed: " << rest.size() << " tiles left, rendering locally" << std::endl;
+        renderTilesLocal(cam, sc, rest, nx, ny, image);
+    }
+    return true;
+}
+
+// Ŀ : WorkerBindAddress:port ڵ  ٸ  Ÿ  ( )
+// η   WorkerSceneDir  ϸ 
+int runWorker(int port) {
+    if (!netInit()) return -1;
+    NetSocket server = netListen(port, WorkerBindAddress);
+    if (server == BadSocket) {
+        std::cerr << "worker: cannot listen on " << WorkerBindAddress << ":" << port << std::endl;
+        return -1;
+    }
+    std::cout << "worker: listening on " << WorkerBindAddress << ":" << port << std::endl;
+    while (true) {
+        NetSocket s = accept(server, nullptr, nullptr);
+        if (s == BadSocket) continue;
+        int one = 1;
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&one, sizeof(one));
+
+        uint32_t type;
+        std::vector<char> data;
+        Camera* cam = nullptr;
+        Scene* sc = nullptr;
+        int nx = 0, ny = 0;
+        if (netRecvMessage(s, type, data) && (type == MSG_SCENE_TEXT || type == MSG_SCENE_PATH)) {
+            std::istringstream in(std::string(data.begin(), data.end()));
+            std::string word, rest;
+            in >> word >> nx >> ny;
+            std::getline(in, rest);
+            bool ok = word == "image" && nx > 0 && ny > 0 && nx <= 16384 && ny <= 16384;
+            if (ok && type == MSG_SCENE_PATH) {
+                std::getline(in, rest);
+                std::string path = WorkerSceneDir.empty() ? std::string() : resolveInside(WorkerSceneDir, rest);
+                if (path.empty()) std::cerr << "worker: scene path not inside --scene-dir: " << rest << std::endl;
+                ok = !path.empty() && loadSceneFile(path, cam, sc);
+            }
+            else if (ok) ok = readScene(in, cam, sc);
+            if (!ok) {
+                std::cerr << "worker: bad scene message" << std::endl;
+                delete cam;
+                delete sc;
+                cam = nullptr;
+                sc = nullptr;
+            }
+        }
+        if (cam && sc) {
+            int32_t threads = renderThreads();
+            netSendMessage(s, MSG_HELLO, &threads, sizeof(threads));
+            std::vector<char> reply;
+            while (netRecvMessage(s, type, data) && type == MSG_TILES) {
+                size_t count = data.size() / (5 * sizeof(int32_t));
+                std::vector<int32_t> rec(count * 5);
+                if (count) memcpy(&rec[0], &data[0], rec.size() * sizeof(int32_t));
+                bool valid = true;
+                for (size_t k = 0; k < count; ++k) {
+                    const int32_t* r = &rec[k * 5];
+                    valid = valid && r[1] >= 0 && r[2] >= 0 && r[1] < r[3] && r[2] < r[4] && r[3] <= nx && r[4] <= ny;
+                }
+                if (!valid) break;
+                std::vector<size_t> offsets(count);
+                size_t total = 0;
+                for (size_t k = 0; k < count; ++k) {
+                    offsets[k] = total;
+                    total += sizeof(int32_t) + size_t(rec[k * 5 + 3] - rec[k * 5 + 1]) * (rec[k * 5 + 4] - rec[k * 5 + 2]) * 3 * sizeof(float);
+                }
+                // ġ Ÿ    Ŀ 
+                if (total > UINT32_MAX || !memTracker.fits(total)) break;
+                reply.resize(total);
+                parallelFor(int(count), [&](int k) {
+                    Tile tile = { rec[k * 5 + 1], rec[k * 5 + 2], rec[k * 5 + 3], rec[k * 5 + 4] };
+                    memcpy(&reply[offsets[k]], &rec[k * 5], sizeof(int32_t));
+                    renderTile(*cam, *sc, tile, nx, ny,
+                               reinterpret_cast<float*>(&reply[offsets[k] + sizeof(int32_t)]), tile.width());
+                });
+                if (!netSendMessage(s, MSG_PIXELS, reply.empty() ? nullptr : &reply[0], uint32_t(reply.size())))
+                    break;
+            }
+        }
+        delete cam;
+        delete sc;
+        netClose(s);
+    }
+}
+
+// --------------------------
+//   ( HTTP)
+// --------------------------
+
+// SceneCache:    ؽø Ű, а BVH   ϴ LRU ĳ
+//  capacity Ѱų ޸        
+class SceneCache {
+public:
+    struct Entry {
+        uint64_t key;
+        Camera* camera;
+        Scene* scene;
+    };
+    size_t capacity;
+    size_t hits = 0, misses = 0;
+
+    SceneCache(size_t capacity_) : capacity(capacity_) { }
+    ~SceneCache() {
+        while (!entries.empty()) evictLast();
+    }
+    //    ű ȯ,  nullptr
+    Entry* find(uint64_t key) {
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->key == key) {
+                entries.splice(entries.begin(), entries, it);
+                hits++;
+                return &entries.front();
+            }
+        }
+        return nullptr;
+    }
+    Entry* insert(uint64_t key, Camera* cam, Scene* sc) {
+        misses++;
+        entries.push_front(Entry{ key, cam, sc });
+        while (entries.size() > 1 && (entries.size() > capacity || !memTracker.fits(0)))
+            evictLast();
+        return &entries.front();
+    }
+    size_t size() const { return entries.size(); }
+private:
+    std::list<Entry> entries;  //  ֱٿ  
+    void evictLast() {
+        delete entries.back().camera;
+        delete entries.back().scene;
+        entries.pop_back();
+    }
+};
+
+std::string hexKey(uint64_t key) {
+    char text[17];
+    snprintf(text, sizeof(text), "%016llx", (unsigned long long)key);
+    return text;
+}
+
+std::string urlDecode(const std::string& text) {
+    std::string out;
+    for (size_t k = 0; k < text.size(); ++k) {
+        if (text[k] == '+') out += ' ';
+        else if (text[k] == '%' && k + 2 < text.size()) {
+            out += char(strtol(text.substr(k + 1, 2).c_str(), nullptr, 16));
+            k += 2;
+        }
+        else out += text[k];
+    }
+    return out;
+}
+
+// "x,y,z" 
+bool parseVec3(const std::string& text, vec3& v) {
+    std::istringstream in(text);
+    char c1, c2;
+    return bool(in >> v.x >> c1 >> v.y >> c2 >> v.z) && c1 == ',' && c2 == ',';
+}
+
+struct HttpRequest {
+    std::string method, path;
+    std::vector<std::pair<std::string, std::string> > query;
+    std::string body;
+    std::string param(const std::string& name, const std::string& def = "") const {
+        for (const auto& q : query)
+            if (q.first == name) return q.second;
+        return def;
+    }
+};
+
+// û , (Content-Length ),  
+bool readHttpRequest(NetSocket s, HttpRequest& req) {
+    std::string head;
+    char c;
+    while (head.size() < 65536) {
+        if (recv(s, &c, 1, 0) != 1) return false;
+        head += c;
+        if (head.size() >= 4 && head.compare(head.size() - 4, 4, "\r\n\r\n") == 0) break;
+    }
+    std::istringstream in(head);
+    std::string target, line;
+    in >> req.method >> target;
+    std::getline(in, line);
+    size_t length = 0;
+    while (std::getline(in, line)) {
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        std::string name = line.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        if (name == "content-length") length = size_t(strtoull(line.c_str() + colon + 1, nullptr, 10));
+    }
+    if (length > (size_t(64) << 20)) return false;
+    size_t qmark = target.find('?');
+    req.path = target.substr(0, qmark);
+    if (qmark != std::string::npos) {
+        std::istringstream qs(target.substr(qmark + 1));
+        std::string pair;
+        while (std::getline(qs, pair, '&')) {
+            size_t eq = pair.find('=');
+            if (eq == std::string::npos) req.query.push_back(std::make_pair(urlDecode(pair), std::string()));
+            else req.query.push_back(std::make_pair(urlDecode(pair.substr(0, eq)), urlDecode(pair.substr(eq + 1))));
+        }
+    }
+    req.body.resize(length);
+    return length == 0 || netRecvAll(s, &req.body[0], length);
+}
+
+void sendHttpResponse(NetSocket s, int status, const char* reason, const std::string& contentType,
+                      const std::string& body, const std::string& extraHeaders = "") {
+    std::ostringstream head;
+    head << "HTTP/1.1 " << status << ' ' << reason << "\r\n"
+         << "Content-Type: " << contentType << "\r\n"
+         << "Content-Length: " << body.size() << "\r\n"
+         << extraHeaders
+         << "Connection: close\r\n\r\n";
+    std::string h = head.str();
+    netSendAll(s, h.data(), h.size()) && netSendAll(s, body.data(), body.size());
+}
+
+//  ۾ ϳ ó
+// POST /render?width=&height=&spp=&eye=x,y,z&target=x,y,z  :   (ĳÿ  scene=<id>   )
+// : PPM ̹, X-Scene-Id   id
+void serveRender(NetSocket s, const HttpRequest& req, SceneCache& cache) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    SceneCache::Entry* entry = nullptr;
+    bool hit = false;
+    if (!req.body.empty()) {
+        uint64_t key = hashBytes(req.body.data(), req.body.size());
+        entry = cache.find(key);
+        hit = entry != nullptr;
+        if (!entry) {
+            std::istringstream in(req.body);
+            Camera* cam;
+            Scene* sc;
+            if (!readScene(in, cam, sc)) {
+                sendHttpResponse(s, 400, "Bad Request", "text/plain", "cannot parse scene\n");
+                return;
+            }
+            entry = cache.insert(key, cam, sc);
+        }
+    }
+    else {
+        uint64_t key = strtoull(req.param("scene").c_str(), nullptr, 16);
+        entry = cache.find(key);
+        hit = entry != nullptr;
+        if (!entry) {
+            sendHttpResponse(s, 404, "Not Found", "text/plain", "scene not cached, send it in the body\n");
+            return;
+        }
+    }
+
+    int nx = atoi(req.param("width", "512").c_str());
+    int ny = atoi(req.param("height", "512").c_str());
+    int spp = atoi(req.param("spp", "0").c_str());
+    if (nx <= 0 || ny <= 0 || nx > 16384 || ny > 16384 || spp < 0) {
+        sendHttpResponse(s, 400, "Bad Request", "text/plain", "bad width/height/spp\n");
+        return;
+    }
+    Camera cam = *entry->camera;
+    vec3 eye, target;
+    if (parseVec3(req.param("eye"), eye)) cam.eye = eye;
+    if (parseVec3(req.param("target"), target)) cam.lookAt(target, vec3(0.0f, 1.0f, 0.0f));
+
+    double setup = std::chrono::duration<double>(Clock::now() - start).count();
+    FrameBuffer image(size_t(nx) * ny * 3);
+    renderImage(cam, *entry->scene, nx, ny, spp, &image[0]);
+    double total = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::ostringstream ppm;
+    writePPM(ppm, &image[0], nx, ny);
+    std::ostringstream headers;
+    headers << "X-Scene-Id: " << hexKey(entry->key) << "\r\n"
+            << "X-Cache: " << (hit ? "hit" : "miss") << "\r\n"
+            << "X-Setup-Seconds: " << setup << "\r\n"
+            << "X-Render-Seconds: " << total - setup << "\r\n";
+    sendHttpResponse(s, 200, "OK", "image/x-portable-pixmap", ppm.str(), headers.str());
+}
+
+//  : 127.0.0.1:port û ϳ ó ( ü   )
+// GET /stats  ĳÿ ޸ 뷮
+// û   Ŭ̾Ʈ    ʵ ϸ ð  
+static const int ServerTimeoutSeconds = 10;
+
+int runServer(int port, size_t cacheScenes) {
+    if (!netInit()) return -1;
+    NetSocket server = netListen(port, "127.0.0.1");
+    if (server == BadSocket) {
+        std::cerr << "server: cannot listen on port " << port << std::endl;
+        return -1;
+    }
+    std::cout << "server: listening on http://127.0.0.1:" << port << std::endl;
+    CheckpointPath.clear();  // ۾  ٸǷ üũƮ  
+    SceneCache cache(cacheScenes);
+    while (true) {
+        NetSocket s = accept(server, nullptr, nullptr);
+        if (s == BadSocket) continue;
+        netSetTimeout(s, ServerTimeoutSeconds);
+        HttpRequest req;
+        if (!readHttpRequest(s, req))
+            sendHttpResponse(s, 400, "Bad Request", "text/plain", "bad request\n");
+        else if (req.method == "POST" && req.path == "/render")
+            serveRender(s, req, cache);
+        else if (req.method == "GET" && req.path == "/stats") {
+            std::ostringstream text;
+            text << "scenes cached " << cache.size() << " / " << cache.capacity
+                 << ", hits " << cache.hits << ", misses " << cache.misses << "\n";
+            memTracker.report(text);
+            sendHttpResponse(s, 200, "OK", "text/plain", text.str());
+        }
+        else
+            sendHttpResponse(s, 404, "Not Found", "text/plain", "use POST /render or GET /stats\n");
+        netClose(s);
+    }
+}
+
+// --------------------------
+// ִϸ̼ ϰ 
+// --------------------------
+
+// FrameWriter:     忡 Ϸ 
+//    maxPending  push() ٸ (޸ )
+class FrameWriter {
+public:
+    int failures = 0;
+    FrameWriter(size_t maxPending_) : maxPending(maxPending_), closing(false) {
+        worker = std::thread([this]() { loop(); });
+    }
+    ~FrameWriter() { finish(); }
+    void push(const std::string& path, FrameBuffer& image, int nx, int ny) {
+        std::unique_lock<std::mutex> guard(lock);
+        changed.wait(guard, [this]() { return queue.size() < maxPending; });
+        queue.push_back(Job());
+        queue.back().path = path;
+        queue.back().image.swap(image);
+        queue.back().nx = nx;
+        queue.back().ny = ny;
+        changed.notify_all();
+    }
+    void finish() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            closing = true;
+            changed.notify_all();
+        }
+        if (worker.joinable()) worker.join();
+    }
+private:
+    struct Job {
+        std::string path;
+        FrameBuffer image;
+        int nx, ny;
+    };
+    size_t maxPending;
+    bool closing;
+    std::mutex lock;
+    std::condition_variable changed;
+    std::deque<Job> queue;
+    std::thread worker;
+
+    void loop() {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                changed.wait(guard, [this]() { return closing || !queue.empty(); });
+                if (queue.empty()) return;
+                job.path.swap(queue.front().path);
+                job.image.swap(queue.front().image);
+                job.nx = queue.front().nx;
+                job.ny = queue.front().ny;
+                queue.pop_front();
+                changed.notify_all();
+            }
+            if (!writePPM(job.path, &job.image[0], job.nx, job.ny)) {
+                std::cerr << "animation: cannot write " << job.path << std::endl;
+                failures++;
+            }
+        }
+    }
+};
+
+//  ̸  '#'  0 ä  ȣ ٲ ("frame_####.ppm" -> "frame_0007.ppm")
+// '#'  Ȯ տ "_ȣ" 
+std::string framePath(const std::string& pattern, int frame) {
+    size_t begin = pattern.find('#');
+    std::string number = std::to_string(frame);
+    if (begin == std::string::npos) {
+        size_t dot = pattern.rfind('.');
+        if (dot == std::string::npos) dot = pattern.size();
+        return pattern.substr(0, dot) + "_" + number + pattern.substr(dot);
+    }
+    size_t end = pattern.find_first_not_of('#', begin);
+    if (end == std::string::npos) end = pattern.size();
+    if (number.size() < end - begin)
+        number = std::string(end - begin - number.size(), '0') + number;
+    return pattern.substr(0, begin) + number + pattern.substr(end);
+}
+
+// first ~ last  ؼ pattern ̸ 
+//    ΰ,  N ϴ  ٸ 尡 N+1    غ
+int runAnimation(const Camera& cam, Scene& sc, const Animation& anim, int first, int last, const std::string& pattern) {
+    const int nx = 512, ny = 512;
+    Camera cams[2] = { cam, cam };
+    Scene* scenes[2] = { &sc, sc.clone() };
+    anim.apply(float(first), cams[0], *scenes[0]);
+
+    FrameWriter writer(2);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int frame = first; frame <= last; ++frame) {
+        int cur = (frame - first) & 1;
+        int next = cur ^ 1;
+        std::thread prepare;
+        if (frame < last)
+            prepare = std::thread([&]() { anim.apply(float(frame + 1), cams[next], *scenes[next]); });
+
+        FrameBuffer image(nx * ny * 3);
+        renderFrame(cams[cur], *scenes[cur], nx, ny, &image[0]);
+        if (prepare.joinable()) prepare.join();
+        writer.push(framePath(pattern, frame), image, nx, ny);
+    }
+    writer.finish();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "animation: " << (last - first + 1) << " frames in " << seconds << " s" << std::endl;
+    memTracker.report(std::cout);
+    delete scenes[1];
+    return writer.failures == 0 ? 0 : -1;
+}
+
+// --------------------------
+// ĳ  (ť , equirectangular)
+// --------------------------
+
+enum PanoramaMode { PANORAMA_NONE, PANORAMA_CUBE, PANORAMA_EQUIRECT };
+PanoramaMode Panorama = PANORAMA_NONE;
+int PanoramaSize = 1024;  // ť    , equirectangular (2 * PanoramaSize) x PanoramaSize
+
+//    GL_TEXTURE_CUBE_MAP_POSITIVE_X ~ NEGATIVE_Z  (include/GL/glh_cube_map.h )
+const char* const CubeFaceNames[6] = { "px", "nx", "py", "ny", "pz", "nz" };
+
+// cubeFaceDirection():  face ȼ ġ (x, y) ϴ  (ī޶  , ⺻ ī޶  )
+// y OutputImageó 0  Ʒ,  PPM   glh j  
+vec3 cubeFaceDirection(const Camera& cam, int face, float x, float y, int size) {
+    float half = size * 0.5f;
+    float s = x - half;  // glh: i*delta + offset - halfsize
+    float t = half - y;  // glh: j*delta + offset - halfsize
+    vec3 v;
+    switch (face) {
+    case 0: v = vec3(half, -t, -s); break;
+    case 1: v = vec3(-half, -t, s); break;
+    case 2: v = vec3(s, half, t); break;
+    case 3: v = vec3(s, -half, -t); break;
+    case 4: v = vec3(s, -t, half); break;
+    default: v = vec3(-s, -t, -half); break;
+    }
+    return v.x * cam.axisU + v.y * cam.axisV + v.z * cam.axisW;
+}
+
+// equirectDirection(): δ 浵 ( ī޶  -axisW,  axisU), δ 
+vec3 equirectDirection(const Camera& cam, float x, float y, int nx, int ny) {
+    float phi = (x / nx * 2.0f - 1.0f) * pi<float>();
+    float theta = (y / ny - 0.5f) * pi<float>();
+    return cos(theta) * sin(phi) * cam.axisU + sin(theta) * cam.axisV - cos(theta) * cos(phi) * cam.axisW;
+}
+
+// renderPanorama():   Ÿ ϳ ۾     
+// images 鸶 ϳ (ť  6, equirectangular 1)
+void renderPanorama(const Camera& cam, const Scene& sc, PanoramaMode mode, int size, float* const* images) {
+    int nx = (mode == PANORAMA_CUBE) ? size : size * 2;
+    int ny = size;
+    int faces = (mode == PANORAMA_CUBE) ? 6 : 1;
+    std::vector<Tile> tiles = makeTiles(nx, ny);
+    int perFace = int(tiles.size());
+    parallelFor(faces * perFace, [&](int k) {
+        int face = k / perFace;
+        const Tile& tile = tiles[k % perFace];
+        for (int j = tile.y0; j < tile.y1; ++j) {
+            for (int i = tile.x0; i < tile.x1; ++i) {
+                vec3 dir = (mode == PANORAMA_CUBE)
+                    ? cubeFaceDirection(cam, face, i + 0.5f, j + 0.5f, size)
+                    : equirectDirection(cam, i + 0.5f, j + 0.5f, nx, ny);
+                vec3 color = trace(sc, Ray(cam.eye, dir));
+                float* dst = images[face] + (j * nx + i) * 3;
+                dst[0] = color.r;
+                dst[1] = color.g;
+                dst[2] = color.b;
+            }
+        }
+    });
+}
+
+// ť    ̸: Ȯ տ "_px"  
+std::string cubeFacePath(const std::string& pattern, int face) {
+    size_t dot = pattern.rfind('.');
+    if (dot == std::string::npos) dot = pattern.size();
+    return pattern.substr(0, dot) + "_" + CubeFaceNames[face] + pattern.substr(dot);
+}
+
+// ĳ   (ť ̸  6) ؼ path ̸ 
+int runPanorama(const Camera& cam, const Scene& sc, PanoramaMode mode, int size, const std::string& path) {
+    int nx = (mode == PANORAMA_CUBE) ? size : size * 2;
+    int faces = (mode == PANORAMA_CUBE) ? 6 : 1;
+    size_t bytes = size_t(nx) * size * 3 * sizeof(float) * faces;
+    if (size <= 0 || !memTracker.fits(bytes)) {
+        std::cerr << "panorama: " << bytes << " bytes of framebuffer do not fit in the memory budget" << std::endl;
+        return -1;
+    }
+    std::vector<FrameBuffer> images(faces);
+    std::vector<float*> ptrs;
+    for (auto& img : images) {
+        img.resize(size_t(nx) * size * 3);
+        ptrs.push_back(&img[0]);
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    renderPanorama(cam, sc, mode, size, &ptrs[0]);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "panorama: " << faces * makeTiles(nx, size).size() << " tiles in " << seconds << " s" << std::endl;
+    memTracker.report(std::cout);
+
+    int result = 0;
+    for (int f = 0; f < faces; ++f) {
+        std::string out = (mode == PANORAMA_CUBE) ? cubeFacePath(path, f) : path;
+        if (!writePPM(out, ptrs[f], nx, size)) {
+            std::cerr << "cannot write " << out << std::endl;
+            result = -1;
+        }
+    }
+    return result;
+}
+
+// --------------------------
+// GLFW ݹ   Լ
+// --------------------------
+void resize_callback(GLFWwindow*, int nw, int nh) {
+    Width = nw;
+    Height = nh;
+    glViewport(0, 0, nw, nh);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(0.0, Width, 0.0, Height, 1.0, -1.0);
+    OutputImage.reserve(Width * Height * 3);
+    render();
+}
+
+// ⺻ :  ϳ ü  
+void makeDefaultScene(Camera*& cam, Scene*& sc) {
+    // ī޶: eye = (0, 0, 0),  : l = -0.1, r = 0.1, b = -0.1, t = 0.1, d = 0.1
+    cam = new Camera(vec3(0.0f, 0.0f, 0.0f), -0.1f, 0.1f, -0.1f, 0.1f, 0.1f);
+    sc = new Scene();
+
+    //   (      ,    ):
+    // : (-4, 4, -3)
+    sc->lights.push_back({ vec3(-4.0f, 4.0f, -3.0f), vec3(1200.0f) });
+    Material glass;
+    glass.type = Material::GLASS;
+    //  P: y = -2, ȸ Ȯ
+    sc->objects.push_back(new Plane(-2.0f));
+    sc->objects.back()->material.color = vec3(0.8f);
+    // Sphere S1: center (-4, 0, -7), radius 1, 
+    sc->objects.push_back(new Sphere(vec3(-4.0f, 0.0f, -7.0f), 1.0f));
+    sc->objects.back()->material = glass;
+    // Sphere S2: center (0, 0, -7), radius 2,  Ȯ
+    sc->objects.push_back(new Sphere(vec3(0.0f, 0.0f, -7.0f), 2.0f));
+    sc->objects.back()->material.color = vec3(0.8f, 0.1f, 0.1f);
+    // Sphere S3: center (4, 0, -7), radius 1, 
+    sc->objects.push_back(new Sphere(vec3(4.0f, 0.0f, -7.0f), 1.0f));
+    sc->objects.back()->material = glass;
+    sc->build();
+}
+
+int main(int argc, char* argv[]) {
+    //  ɼ (README )
+    std::string scenePath;
+    int workerPort = 0;
+    int serverPort = 0;
+    size_t cacheScenes = 8;
+    bool sharedScene = false;
+    std::string outputPath;
+    int animFirst = 0, animLast = -1;
+    for (int k = 1; k < argc; ++k) {
+        std::string opt = argv[k];
+        bool hasValue = k + 1 < argc;
+        if (opt == "--mem-budget" && hasValue)
+            memTracker.budget = size_t(atof(argv[++k]) * 1024.0 * 1024.0);
+        else if (opt == "--threads" && hasValue)
+            ThreadCount = atoi(argv[++k]);
+        else if (opt == "--simd" && hasValue) {
+            std::string level = argv[++k];
+            simdSetLevel(level == "avx512" ? SIMD_AVX512 : level == "avx2" ? SIMD_AVX2 : SIMD_SSE2);
+        }
+        else if (opt == "--scene" && hasValue)
+            scenePath = argv[++k];
+        else if (opt == "--worker" && hasValue)
+            workerPort = atoi(argv[++k]);
+        else if (opt == "--worker-bind" && hasValue)
+            WorkerBindAddress = argv[++k];
+        else if (opt == "--scene-dir" && hasValue)
+            WorkerSceneDir = argv[++k];
+        else if (opt == "--workers" && hasValue) {
+            std::istringstream list(argv[++k]);
+            std::string addr;
+            while (std::getline(list, addr, ','))
+                if (!addr.empty()) WorkerAddresses.push_back(addr);
+        }
+        else if (opt == "--server" && hasValue)
+            serverPort = atoi(argv[++k]);
+        else if (opt == "--cache-scenes" && hasValue)
+            cacheScenes = size_t(std::max(1, atoi(argv[++k])));
+        else if (opt == "--shared-scene")
+            sharedScene = true;
+        else if (opt == "--output" && hasValue)
+            outputPath = argv[++k];
+        else if (opt == "--spp" && hasValue)
+            TotalSamples = atoi(argv[++k]);
+        else if (opt == "--spp-per-pass" && hasValue)
+            SamplesPerPass = std::max(1, atoi(argv[++k]));
+        else if (opt == "--checkpoint" && hasValue)
+            CheckpointPath = argv[++k];
+        else if (opt == "--checkpoint-every" && hasValue)
+            CheckpointInterval = atof(argv[++k]);
+        else if (opt == "--foveated" && hasValue) {
+            Foveation.enabled = true;
+            Foveation.radius = float(atof(argv[++k]));
+        }
+        else if (opt == "--foveated-speedup" && hasValue) {
+            Foveation.enabled = true;
+            Foveation.speedup = float(atof(argv[++k]));
+        }
+        else if (opt == "--foveated-rate" && hasValue)
+            Foveation.maxRate = atoi(argv[++k]) <= 2 ? 2 : 4;
+        else if (opt == "--stereo" && hasValue) {
+            ViewCount = 2;
+            ViewSpacing = float(atof(argv[++k]));
+        }
+        else if (opt == "--views" && k + 2 < argc) {
+            ViewCount = std::max(1, atoi(argv[++k]));
+            ViewSpacing = float(atof(argv[++k]));
+        }
+        else if (opt == "--cube-map" && hasValue) {
+            Panorama = PANORAMA_CUBE;
+            PanoramaSize = atoi(argv[++k]);
+        }
+        else if (opt == "--equirect" && hasValue) {
+            Panorama = PANORAMA_EQUIRECT;
+            PanoramaSize = atoi(argv[++k]);
+        }
+        else if (opt == "--ao" && k + 2 < argc) {
+            AO.enabled = true;
+            AO.samples = std::max(1, atoi(argv[++k]));
+            AO.distance = float(atof(argv[++k]));
+        }
+        else if (opt == "--ao-guide" && hasValue)
+            AOGuidePath = argv[++k];
+        else if (opt == "--ao-cull")
+            AO.cullByLength = true;
+        else if (opt == "--photons" && hasValue) {
+            Photons.enabled = true;
+            Photons.count = std::max(1, atoi(argv[++k]));
+        }
+        else if (opt == "--photon-k" && hasValue)
+            Photons.k = std::max(1, atoi(argv[++k]));
+        else if (opt == "--photon-radius" && hasValue)
+            Photons.radius = float(atof(argv[++k]));
+        else if (opt == "--ppm" && hasValue)
+            Photons.passes = std::max(1, atoi(argv[++k]));
+        else if (opt == "--gi" && hasValue) {
+            GI.enabled = true;
+            GI.samples = std::max(8, atoi(argv[++k]));
+        }
+        else if (opt == "--gi-error" && hasValue)
+            GI.error = float(atof(argv[++k]));
+        else if (opt == "--gi-spacing" && k + 2 < argc) {
+            GI.minSpacing = float(atof(argv[++k]));
+            GI.maxSpacing = std::max(GI.minSpacing, float(atof(argv[++k])));
+        }
+        else if (opt == "--no-irradiance-cache")
+            GI.cache = false;
+        else if (opt == "--mis" && hasValue) {
+            MIS.enabled = true;
+            MIS.samples = std::max(1, atoi(argv[++k]));
+        }
+        else if (opt == "--mis-heuristic" && hasValue) {
+            std::string h = argv[++k];
+            MIS.heuristic = (h == "balance") ? MISSettings::BALANCE : (h == "light") ? MISSettings::LIGHT_ONLY
+                          : (h == "bsdf") ? MISSettings::BSDF_ONLY : MISSettings::POWER;
+        }
+        else if (opt == "--restir" && hasValue) {
+            ReSTIR.enabled = true;
+            ReSTIR.candidates = std::max(1, atoi(argv[++k]));
+        }
+        else if (opt == "--restir-spatial" && k + 2 < argc) {
+            ReSTIR.neighbors = std::max(0, atoi(argv[++k]));
+            ReSTIR.radius = float(atof(argv[++k]));
+        }
+        else if (opt == "--no-temporal-reuse")
+            ReSTIR.temporal = false;
+        else if (opt == "--path" && hasValue) {
+            Path.enabled = true;
+            Path.samples = std::max(1, atoi(argv[++k]));
+        }
+        else if (opt == "--path-depth" && hasValue)
+            Path.maxDepth = std::max(1, atoi(argv[++k]));
+        else if (opt == "--guide" && hasValue)
+            Path.guide = std::max(0, atoi(argv[++k]));
+        else if (opt == "--guide-budget" && hasValue)
+            Path.guideBudget = size_t(std::max(1, atoi(argv[++k]))) << 20;
+        else if (opt == "--crop" && k + 4 < argc) {
+            //    ȼ ǥ (ȭ, PPM ) -> OutputImage ǥ
+            int x0 = atoi(argv[++k]), y0 = atoi(argv[++k]), x1 = atoi(argv[++k]), y1 = atoi(argv[++k]);
+            CropWindow = { std::min(x0, x1), 512 - std::max(y0, y1), std::max(x0, x1), 512 - std::min(y0, y1) };
+        }
+        else if (opt == "--animate" && k + 2 < argc) {
+            animFirst = atoi(argv[++k]);
+            animLast = atoi(argv[++k]);
+        }
+        else
+            std::cerr << "unknown option: " << opt << std::endl;
+    }
+    // üũƮ ̹ ϳ, ִϸ̼ǰ ĳ󸶴 ī޶ ϳ ϹǷ   Բ   
+    if (ViewCount > 1 && (!CheckpointPath.empty() || animLast >= animFirst || Panorama != PANORAMA_NONE)) {
+        std::cerr << "--views/--stereo cannot be combined with --checkpoint, --animate, --cube-map or --equirect" << std::endl;
+        return -1;
+    }
+    if (workerPort > 0)
+        return runWorker(workerPort);
+    if (serverPort > 0)
+        return runServer(serverPort, cacheScenes);
+    if (sharedScene && !scenePath.empty())
+        SharedScenePath = scenePath;
+
+    // â  Ϸθ : --output ( ), --animate ( ), ĳ
+    if (!outputPath.empty() || animLast >= animFirst || Panorama != PANORAMA_NONE) {
+        Animation anim;
+        if (!scenePath.empty()) {
+            if (!loadSceneFile(scenePath, camera, scene, &anim)) return -1;
+        }
+        else makeDefaultScene(camera, scene);
+        int result = 0;
+        if (animLast >= animFirst) {
+            result = runAnimation(*camera, *scene, anim, animFirst, animLast,
+                                  outputPath.empty() ? "frame_####.ppm" : outputPath);
+        }
+        else if (Panorama != PANORAMA_NONE) {
+            result = runPanorama(*camera, *scene, Panorama, PanoramaSize,
+                                 outputPath.empty() ? "panorama.ppm" : outputPath);
+        }
+        else {
+            //  ٽ         ռ
+            if (hasCropWindow()) {
+                FrameBuffer previous(512 * 512 * 3);
+                if (readPPM(outputPath, &previous[0], 512, 512)) OutputImage.swap(previous);
+            }
+            render();
+            if (!writePPM(outputPath, &OutputImage[0], 512, 512)) {
+                std::cerr << "cannot write " << outputPath << std::endl;
+                result = -1;
+            }
+            // AO ̵ :  ϰ  ī޶( ̸ 0 ) AO  ؼ 
+            if (!AOGuidePath.empty()) {
+                FrameBuffer guide(512 * 512 * 3);
+                renderAO(makeCameraRig(*camera, ViewCount, ViewSpacing)[0], *scene, 512, 512, &guide[0]);
+                if (!writePPM(AOGuidePath, &guide[0], 512, 512)) {
+                    std::cerr << "cannot write " << AOGuidePath << std::endl;
+                    result = -1;
+                }
+            }
+            //  : 1    ̸  ȣ ٿ 
+            for (size_t v = 0; v < ViewImages.size(); ++v) {
+                std::string path = framePath(outputPath, int(v) + 1);
+                if (!writePPM(path, &ViewImages[v][0], 512, 512)) {
+                    std::cerr << "cannot write " << path << std::endl;
+                    result = -1;
+                }
+            }
+        }
+        delete camera;
+        delete scene;
+        return result;
+    }
+
+    GLFWwindow* window;
+    if (!glfwInit()) return -1;
+
+    window = glfwCreateWindow(Width, Height, "Simple Ray Tracer", NULL, NULL);
+    if (!window) {
+        glfwTerminate();
+        return -1;
+    }
+
+    glfwMakeContextCurrent(window);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glfwSetFramebufferSizeCallback(window, resize_callback);
+
+    if (!scenePath.empty()) {
+        if (!loadSceneFile(scenePath, camera, scene)) {
+            glfwTerminate();
+            return -1;
+        }
+    }
+    else makeDefaultScene(camera, scene);
+
+    resize_callback(NULL, Width, Height);
+
+    bool reloadHeld = false;
+    while (!glfwWindowShouldClose(window)) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        glDrawPixels(Width, Height, GL_RGB, GL_FLOAT, &OutputImage[0]);
+        glfwSwapBuffers(window);
         glfwPollEvents();
         if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
             glfwSetWindowShouldClose(window, GL_TRUE);
+        // R:   ٽ а  (--crop   )
+        bool reload = glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS;
+        if (reload && !reloadHeld) {
+            Camera* newCamera;
+            Scene* newScene;
+            if (!scenePath.empty() && loadSceneFile(scenePath, newCamera, newScene)) {
+                delete camera;
+                delete scene;
+                camera = newCamera;
+                scene = newScene;
+            }
+            render();
+        }
+        reloadHeld = reload;
+        // foveation: Ŀ Ÿ ϳ ̻ ̸ Ŀ ġ  ٽ 
+        if (Foveation.enabled) {
+            double cx, cy;
+            glfwGetCursorPos(window, &cx, &cy);
+            vec2 focus(float(cx) * 512.0f / Width, 512.0f - float(cy) * 512.0f / Height);
+            if (length(focus - Foveation.focus) >= float(TileSize)) {
+                Foveation.focus = focus;
+                render();
+            }
+        }
     }
 
     delete camera;
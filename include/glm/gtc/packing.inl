@@ -279,7 +279,7 @@ namespace detail
 	
 	GLM_FUNC_QUALIFIER float unpackSnorm1x8(uint8 p)
 	{
-		float Unpack(static_cast<float>(*const_cast<uint8*>(&p)));
+		float Unpack(static_cast<float>(*reinterpret_cast<int8 const *>(&p)));
 		return clamp(
 			Unpack * 0.00787401574803149606299212598425f, // 1.0f / 127.0f
 			-1.0f, 1.0f);
@@ -333,7 +333,7 @@ namespace detail
 
 	GLM_FUNC_QUALIFIER float unpackSnorm1x16(uint16 p)
 	{
-		float Unpack = static_cast<float>(*const_cast<uint16*>(&p));
+		float Unpack = static_cast<float>(*reinterpret_cast<int16 const *>(&p));
 		return clamp(
 			Unpack * 3.0518509475997192297128208258309e-5f, //1.0f / 32767.0f, 
 			-1.0f, 1.0f);
@@ -457,7 +457,7 @@ namespace detail
 
 	GLM_FUNC_QUALIFIER uint32 packUnorm3x10_1x2(vec4 const & v)
 	{
-		detail::i10i10i10i2 Result;
+		detail::u10u10u10u2 Result;
 		Result.data.x = int(round(clamp(v.x, 0.0f, 1.0f) * 1023.f));
 		Result.data.y = int(round(clamp(v.y, 0.0f, 1.0f) * 1023.f));
 		Result.data.z = int(round(clamp(v.z, 0.0f, 1.0f) * 1023.f));
@@ -467,7 +467,7 @@ namespace detail
 
 	GLM_FUNC_QUALIFIER vec4 unpackUnorm3x10_1x2(uint32 v)
 	{
-		detail::i10i10i10i2 Unpack;
+		detail::u10u10u10u2 Unpack;
 		Unpack.pack = v;
 		vec4 Result;
 		Result.x = float(Unpack.data.x) / 1023.f;
@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// OpenGL Mathematics (glm.g-truc.net)
+///
+/// Copyright (c) 2005 - 2014 G-Truc Creation (www.g-truc.net)
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+/// @ref gtx_simd_packing
+/// @file glm/gtx/simd_packing.hpp
+/// @date 2026-10-17 / 2026-10-17
+///
+/// @see core (dependence)
+/// @see gtc_packing (dependence)
+/// @see gtx_simd_wide (dependence)
+///
+/// @defgroup gtx_simd_packing GLM_GTX_simd_packing
+/// @ingroup gtx
+///
+/// @brief Array forms of the gtc_packing conversions: count values in, count packed values out.
+///
+/// Each function converts a whole array with SSE2 or AVX2 registers, picked at run time
+/// like simdDispatch, and gives the same bits as calling the scalar function on every
+/// element (for non-NaN inputs of the normalized formats, whose scalar result is undefined).
+/// Arrays need no alignment and may have any length. Half-float packing reproduces the
+/// "round 0.5 up" rounding of the scalar conversion with integer instructions, since the
+/// F16C conversion rounds ties to even; unpacking uses F16C on AVX2.
+///
+/// <glm/gtx/simd_packing.hpp> need to be included to use these functionalities.
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef GLM_GTX_simd_packing
+#define GLM_GTX_simd_packing
+
+// Dependency:
+#include "../glm.hpp"
+#include "../gtc/packing.hpp"
+#include "simd_wide.hpp"
+#include <cstddef>
+
+#if(GLM_ARCH != GLM_ARCH_PURE)
+
+#if(defined(GLM_MESSAGES) && !defined(GLM_EXT_INCLUDED))
+#	pragma message("GLM: GLM_GTX_simd_packing extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_simd_packing
+	/// @{
+
+	//! p[i] = packUnorm1x8(v[i]) for i < count.
+	/// @see gtx_simd_packing
+	void packUnorm1x8(float const * v, std::size_t count, uint8 * p);
+	//! v[i] = unpackUnorm1x8(p[i]) for i < count.
+	/// @see gtx_simd_packing
+	void unpackUnorm1x8(uint8 const * p, std::size_t count, float * v);
+
+	//! p[i] = packSnorm1x8(v[i]) for i < count.
+	/// @see gtx_simd_packing
+	void packSnorm1x8(float const * v, std::size_t count, uint8 * p);
+	//! v[i] = unpackSnorm1x8(p[i]) for i < count.
+	/// @see gtx_simd_packing
+	void unpackSnorm1x8(uint8 const * p, std::size_t count, float * v);
+
+	//! p[i] = packUnorm1x16(v[i]) for i < count.
+	/// @see gtx_simd_packing
+	void packUnorm1x16(float const * v, std::size_t count, uint16 * p);
+	//! v[i] = unpackUnorm1x16(p[i]) for i < count.
+	/// @see gtx_simd_packing
+	void unpackUnorm1x16(uint16 const * p, std::size_t count, float * v);
+
+	//! p[i] = packSnorm1x16(v[i]) for i < count.
+	/// @see gtx_simd_packing
+	void packSnorm1x16(float const * v, std::size_t count, uint16 * p);
+	//! v[i] = unpackSnorm1x16(p[i]) for i < count.
+	/// @see gtx_simd_packing
+	void unpackSnorm1x16(uint16 const * p, std::size_t count, float * v);
+
+	//! p[i] = packHalf1x16(v[i]) for i < count.
+	/// @see gtx_simd_packing
+	void packHalf1x16(float const * v, std::size_t count, uint16 * p);
+	//! v[i] = unpackHalf1x16(p[i]) for i < count.
+	/// @see gtx_simd_packing
+	void unpackHalf1x16(uint16 const * p, std::size_t count, float * v);
+
+	//! Vector forms: the components are packed one after the other, so these are the
+	//! 1x8 / 1x16 forms over count * components values.
+	/// @see gtx_simd_packing
+	void packUnorm2x8(vec2 const * v, std::size_t count, uint16 * p);
+	void unpackUnorm2x8(uint16 const * p, std::size_t count, vec2 * v);
+	void packSnorm2x8(vec2 const * v, std::size_t count, uint16 * p);
+	void unpackSnorm2x8(uint16 const * p, std::size_t count, vec2 * v);
+	void packUnorm4x8(vec4 const * v, std::size_t count, uint32 * p);
+	void unpackUnorm4x8(uint32 const * p, std::size_t count, vec4 * v);
+	void packSnorm4x8(vec4 const * v, std::size_t count, uint32 * p);
+	void unpackSnorm4x8(uint32 const * p, std::size_t count, vec4 * v);
+	void packUnorm4x16(vec4 const * v, std::size_t count, uint64 * p);
+	void unpackUnorm4x16(uint64 const * p, std::size_t count, vec4 * v);
+	void packSnorm4x16(vec4 const * v, std::size_t count, uint64 * p);
+	void unpackSnorm4x16(uint64 const * p, std::size_t count, vec4 * v);
+	void packHalf2x16(vec2 const * v, std::size_t count, uint32 * p);
+	void unpackHalf2x16(uint32 const * p, std::size_t count, vec2 * v);
+	void packHalf4x16(vec4 const * v, std::size_t count, uint64 * p);
+	void unpackHalf4x16(uint64 const * p, std::size_t count, vec4 * v);
+
+	//! p[i] = packSnorm3x10_1x2(v[i]) for i < count.
+	/// @see gtx_simd_packing
+	void packSnorm3x10_1x2(vec4 const * v, std::size_t count, uint32 * p);
+	//! v[i] = unpackSnorm3x10_1x2(p[i]) for i < count.
+	/// @see gtx_simd_packing
+	void unpackSnorm3x10_1x2(uint32 const * p, std::size_t count, vec4 * v);
+
+	//! p[i] = packUnorm3x10_1x2(v[i]) for i < count.
+	/// @see gtx_simd_packing
+	void packUnorm3x10_1x2(vec4 const * v, std::size_t count, uint32 * p);
+	//! v[i] = unpackUnorm3x10_1x2(p[i]) for i < count.
+	/// @see gtx_simd_packing
+	void unpackUnorm3x10_1x2(uint32 const * p, std::size_t count, vec4 * v);
+
+	/// @}
+}//namespace glm
+
+#include "simd_packing.inl"
+
+#endif//(GLM_ARCH != GLM_ARCH_PURE)
+
+#endif//GLM_GTX_simd_packing
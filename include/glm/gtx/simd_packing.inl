@@ -0,0 +1,641 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OpenGL Mathematics Copyright (c) 2005 - 2014 G-Truc Creation (www.g-truc.net)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Created : 2026-10-17
+// Updated : 2026-10-17
+// Licence : This source is under MIT License
+// File    : glm/gtx/simd_packing.inl
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+namespace glm{
+namespace detail{
+
+//////////////////////////////////////
+// Registers
+
+/// Float and integer registers of an instruction set, with the conversions the packing kernels need.
+template <typename isa>
+struct simd_pack_reg;
+
+template <>
+struct simd_pack_reg<simd_sse2>
+{
+	typedef __m128 ps;
+	typedef __m128i si;
+	enum{width = 4};
+
+	static GLM_SIMD_INLINE ps load(float const * p){return _mm_loadu_ps(p);}
+	static GLM_SIMD_INLINE void store(float * p, ps v){_mm_storeu_ps(p, v);}
+	static GLM_SIMD_INLINE ps set1(float s){return _mm_set1_ps(s);}
+	static GLM_SIMD_INLINE ps add(ps a, ps b){return _mm_add_ps(a, b);}
+	static GLM_SIMD_INLINE ps mul(ps a, ps b){return _mm_mul_ps(a, b);}
+	static GLM_SIMD_INLINE ps div(ps a, ps b){return _mm_div_ps(a, b);}
+	static GLM_SIMD_INLINE ps min(ps a, ps b){return _mm_min_ps(a, b);}
+	static GLM_SIMD_INLINE ps max(ps a, ps b){return _mm_max_ps(a, b);}
+	static GLM_SIMD_INLINE ps and_(ps a, ps b){return _mm_and_ps(a, b);}
+	static GLM_SIMD_INLINE ps or_(ps a, ps b){return _mm_or_ps(a, b);}
+	static GLM_SIMD_INLINE si cvtt(ps a){return _mm_cvttps_epi32(a);}
+	static GLM_SIMD_INLINE ps cvt(si a){return _mm_cvtepi32_ps(a);}
+	static GLM_SIMD_INLINE si castsi(ps a){return _mm_castps_si128(a);}
+	static GLM_SIMD_INLINE ps castps(si a){return _mm_castsi128_ps(a);}
+
+	static GLM_SIMD_INLINE si set1i(int s){return _mm_set1_epi32(s);}
+	static GLM_SIMD_INLINE si addi(si a, si b){return _mm_add_epi32(a, b);}
+	static GLM_SIMD_INLINE si subi(si a, si b){return _mm_sub_epi32(a, b);}
+	static GLM_SIMD_INLINE si andi(si a, si b){return _mm_and_si128(a, b);}
+	static GLM_SIMD_INLINE si ori(si a, si b){return _mm_or_si128(a, b);}
+	static GLM_SIMD_INLINE si cmpgti(si a, si b){return _mm_cmpgt_epi32(a, b);}
+	static GLM_SIMD_INLINE si cmpeqi(si a, si b){return _mm_cmpeq_epi32(a, b);}
+	// mask ? a : b
+	static GLM_SIMD_INLINE si blendi(si m, si a, si b){return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));}
+	static GLM_SIMD_INLINE bool any(si m){return _mm_movemask_epi8(m) != 0;}
+	template <int n> static GLM_SIMD_INLINE si slli(si a){return _mm_slli_epi32(a, n);}
+	template <int n> static GLM_SIMD_INLINE si srli(si a){return _mm_srli_epi32(a, n);}
+	template <int n> static GLM_SIMD_INLINE si srai(si a){return _mm_srai_epi32(a, n);}
+
+#	if(GLM_COMPILER & GLM_COMPILER_VC)
+	static GLM_SIMD_INLINE void opaque(ps &){}
+#	else
+	// Keeps a product rounded before the following add (GCC contracts vector code to FMA)
+	static GLM_SIMD_INLINE void opaque(ps & a){__asm__("" : "+x"(a));}
+#	endif
+
+	static GLM_SIMD_INLINE si load32(void const * p){return _mm_loadu_si128(static_cast<__m128i const *>(p));}
+	static GLM_SIMD_INLINE void store32(void * p, si a){_mm_storeu_si128(static_cast<__m128i *>(p), a);}
+
+	static GLM_SIMD_INLINE si loadu8(uint8 const * p)
+	{
+		int b;
+		std::memcpy(&b, p, sizeof(b));
+		si z = _mm_setzero_si128();
+		return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(b), z), z);
+	}
+
+	static GLM_SIMD_INLINE si loads8(uint8 const * p)
+	{
+		int b;
+		std::memcpy(&b, p, sizeof(b));
+		si x = _mm_cvtsi32_si128(b);
+		x = _mm_unpacklo_epi8(x, x);
+		return _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 24);
+	}
+
+	static GLM_SIMD_INLINE si loadu16(uint16 const * p)
+	{
+		return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(p)), _mm_setzero_si128());
+	}
+
+	static GLM_SIMD_INLINE si loads16(uint16 const * p)
+	{
+		si x = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(p));
+		return _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+	}
+
+	// Low 8 bits of the lanes of a, b, c and d
+	static GLM_SIMD_INLINE void store8(uint8 * p, si a, si b, si c, si d)
+	{
+		si m = _mm_set1_epi32(0xff);
+		si ab = _mm_packs_epi32(_mm_and_si128(a, m), _mm_and_si128(b, m));
+		si cd = _mm_packs_epi32(_mm_and_si128(c, m), _mm_and_si128(d, m));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm_packus_epi16(ab, cd));
+	}
+
+	// Low 16 bits of the lanes of a and b (sign extended first, so that the saturating pack keeps them)
+	static GLM_SIMD_INLINE void store16(uint16 * p, si a, si b)
+	{
+		a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+		b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm_packs_epi32(a, b));
+	}
+
+	// Half to float with integer instructions; NaN keep their significand like toFloat32
+	static GLM_SIMD_INLINE ps loadHalf(uint16 const * p)
+	{
+		si h = loadu16(p);
+		si e = andi(h, set1i(0x7c00));
+		si hm = andi(h, set1i(0x7fff));
+		si f = addi(slli<13>(hm), set1i(0x38000000));
+		f = blendi(cmpeqi(e, set1i(0x7c00)), ori(slli<13>(hm), set1i(0x7f800000)), f);
+		// Zero and denormals: m * 2^-24 is exact
+		f = blendi(cmpeqi(e, _mm_setzero_si128()), castsi(mul(cvt(hm), set1(5.9604644775390625e-8f))), f);
+		return castps(ori(f, slli<16>(andi(h, set1i(0x8000)))));
+	}
+
+	// Rows of a 4x4 block become columns
+	static GLM_SIMD_INLINE void transpose(ps & a, ps & b, ps & c, ps & d){_MM_TRANSPOSE4_PS(a, b, c, d);}
+	// width vec4, laid out so that transpose() gives their x, y, z and w
+	static GLM_SIMD_INLINE void load4(float const * p, ps & a, ps & b, ps & c, ps & d)
+	{
+		a = load(p); b = load(p + 4); c = load(p + 8); d = load(p + 12);
+	}
+	// Inverse of load4, after transpose()
+	static GLM_SIMD_INLINE void store4(float * p, ps a, ps b, ps c, ps d)
+	{
+		store(p, a); store(p + 4, b); store(p + 8, c); store(p + 12, d);
+	}
+};
+
+template <>
+struct simd_pack_reg<simd_avx2>
+{
+	typedef __m256 ps;
+	typedef __m256i si;
+	enum{width = 8};
+
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE ps load(float const * p){return _mm256_loadu_ps(p);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void store(float * p, ps v){_mm256_storeu_ps(p, v);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE ps set1(float s){return _mm256_set1_ps(s);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE ps add(ps a, ps b){return _mm256_add_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE ps mul(ps a, ps b){return _mm256_mul_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE ps div(ps a, ps b){return _mm256_div_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE ps min(ps a, ps b){return _mm256_min_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE ps max(ps a, ps b){return _mm256_max_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE ps and_(ps a, ps b){return _mm256_and_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE ps or_(ps a, ps b){return _mm256_or_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si cvtt(ps a){return _mm256_cvttps_epi32(a);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE ps cvt(si a){return _mm256_cvtepi32_ps(a);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si castsi(ps a){return _mm256_castps_si256(a);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE ps castps(si a){return _mm256_castsi256_ps(a);}
+
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si set1i(int s){return _mm256_set1_epi32(s);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si addi(si a, si b){return _mm256_add_epi32(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si subi(si a, si b){return _mm256_sub_epi32(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si andi(si a, si b){return _mm256_and_si256(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si ori(si a, si b){return _mm256_or_si256(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si cmpgti(si a, si b){return _mm256_cmpgt_epi32(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si cmpeqi(si a, si b){return _mm256_cmpeq_epi32(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si blendi(si m, si a, si b){return _mm256_blendv_epi8(b, a, m);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE bool any(si m){return !_mm256_testz_si256(m, m);}
+	template <int n> static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si slli(si a){return _mm256_slli_epi32(a, n);}
+	template <int n> static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si srli(si a){return _mm256_srli_epi32(a, n);}
+	template <int n> static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si srai(si a){return _mm256_srai_epi32(a, n);}
+
+#	if(GLM_COMPILER & GLM_COMPILER_VC)
+	static GLM_SIMD_INLINE void opaque(ps &){}
+#	else
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void opaque(ps & a){__asm__("" : "+x"(a));}
+#	endif
+
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si load32(void const * p){return _mm256_loadu_si256(static_cast<__m256i const *>(p));}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void store32(void * p, si a){_mm256_storeu_si256(static_cast<__m256i *>(p), a);}
+
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si loadu8(uint8 const * p){return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(p)));}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si loads8(uint8 const * p){return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(p)));}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si loadu16(uint16 const * p){return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const *>(p)));}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE si loads16(uint16 const * p){return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const *>(p)));}
+
+	// The packs work within 128-bit lanes, the permutes put the 32-bit (64-bit) groups back in order
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void store8(uint8 * p, si a, si b, si c, si d)
+	{
+		si m = _mm256_set1_epi32(0xff);
+		si ab = _mm256_packs_epi32(_mm256_and_si256(a, m), _mm256_and_si256(b, m));
+		si cd = _mm256_packs_epi32(_mm256_and_si256(c, m), _mm256_and_si256(d, m));
+		si r = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(ab, cd), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(p), r);
+	}
+
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void store16(uint16 * p, si a, si b)
+	{
+		si m = _mm256_set1_epi32(0xffff);
+		si r = _mm256_packus_epi32(_mm256_and_si256(a, m), _mm256_and_si256(b, m));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(p), _mm256_permute4x64_epi64(r, 0xD8));
+	}
+
+	// F16C, except that toFloat32 keeps signaling NaN signaling
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE ps loadHalf(uint16 const * p)
+	{
+		__m128i x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p));
+		ps f = _mm256_cvtph_ps(x);
+		si h = _mm256_cvtepu16_epi32(x);
+		si nan = cmpgti(andi(h, set1i(0x7fff)), set1i(0x7c00));
+		if(any(nan))
+		{
+			si n = ori(slli<16>(andi(h, set1i(0x8000))), ori(slli<13>(andi(h, set1i(0x3ff))), set1i(0x7f800000)));
+			f = castps(blendi(nan, n, castsi(f)));
+		}
+		return f;
+	}
+
+	// Transposes the 4x4 block in each 128-bit lane
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void transpose(ps & a, ps & b, ps & c, ps & d)
+	{
+		ps t0 = _mm256_unpacklo_ps(a, b);
+		ps t1 = _mm256_unpackhi_ps(a, b);
+		ps t2 = _mm256_unpacklo_ps(c, d);
+		ps t3 = _mm256_unpackhi_ps(c, d);
+		a = _mm256_shuffle_ps(t0, t2, 0x44);
+		b = _mm256_shuffle_ps(t0, t2, 0xEE);
+		c = _mm256_shuffle_ps(t1, t3, 0x44);
+		d = _mm256_shuffle_ps(t1, t3, 0xEE);
+	}
+
+	// Register k holds vec4 k and k + 4
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE ps load2(float const * p)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 16), 1);
+	}
+
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void store2(float * p, ps a)
+	{
+		_mm_storeu_ps(p, _mm256_castps256_ps128(a));
+		_mm_storeu_ps(p + 16, _mm256_extractf128_ps(a, 1));
+	}
+
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void load4(float const * p, ps & a, ps & b, ps & c, ps & d)
+	{
+		a = load2(p); b = load2(p + 4); c = load2(p + 8); d = load2(p + 12);
+	}
+
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void store4(float * p, ps a, ps b, ps c, ps d)
+	{
+		store2(p, a); store2(p + 4, b); store2(p + 8, c); store2(p + 12, d);
+	}
+};
+
+// The conversions gain nothing from 16 lanes; AVX-512 CPUs run the AVX2 kernels.
+template <>
+struct simd_pack_reg<simd_avx512> : public simd_pack_reg<simd_avx2>
+{};
+
+//////////////////////////////////////
+// Formats: block is the number of registers of input (pack) or output (unpack) per step
+
+struct simd_pack_unorm8{enum{block = 4};};
+struct simd_unpack_unorm8{enum{block = 1};};
+struct simd_pack_snorm8{enum{block = 4};};
+struct simd_unpack_snorm8{enum{block = 1};};
+struct simd_pack_unorm16{enum{block = 2};};
+struct simd_unpack_unorm16{enum{block = 1};};
+struct simd_pack_snorm16{enum{block = 2};};
+struct simd_unpack_snorm16{enum{block = 1};};
+struct simd_pack_half{enum{block = 2};};
+struct simd_unpack_half{enum{block = 1};};
+struct simd_pack_unorm3x10_1x2{enum{block = 1};};
+struct simd_unpack_unorm3x10_1x2{enum{block = 1};};
+struct simd_pack_snorm3x10_1x2{enum{block = 1};};
+struct simd_unpack_snorm3x10_1x2{enum{block = 1};};
+
+//////////////////////////////////////
+// Kernels
+
+/// Conversion of one block per format, apply(format, in, out); stamped out per instruction set
+/// so that every function touching registers carries the target attribute.
+///
+/// unorm / snorm: round(clamp(x) * scale) of the scalar functions, x < 0 ? x - 0.5 : x + 0.5
+/// truncated; the product is kept rounded on its own (opaque) since GCC would contract it
+/// with the add into an FMA on AVX2.
+/// half: toFloat16 lane by lane. A normalized half rounds "0.5" up by adding 0x1000 to the
+/// float bits, a carry out of the significand moving into the exponent; a denormalized half
+/// is |f| * 2^24 rounded the same way (exact, zero below 2^-25); overflow gives infinity and
+/// NaN keeps its 10 leftmost significand bits, at least one of them set.
+template <typename isa>
+struct simd_pack_kernel;
+
+#define GLM_SIMD_PACK_KERNEL(ISA, TARGET) \
+template <> \
+struct simd_pack_kernel<ISA> \
+{ \
+	typedef simd_pack_reg<ISA> R; \
+	typedef R::ps ps; \
+	typedef R::si si; \
+	enum{W = R::width}; \
+	static TARGET GLM_SIMD_INLINE void unorm(si & r, ps v, float scale) \
+	{ \
+		ps x = R::mul(R::min(R::max(v, R::set1(0.0f)), R::set1(1.0f)), R::set1(scale)); \
+		R::opaque(x); \
+		r = R::cvtt(R::add(x, R::set1(0.5f))); \
+	} \
+	static TARGET GLM_SIMD_INLINE void snorm(si & r, ps v, float scale) \
+	{ \
+		ps x = R::mul(R::min(R::max(v, R::set1(-1.0f)), R::set1(1.0f)), R::set1(scale)); \
+		R::opaque(x); \
+		r = R::cvtt(R::add(x, R::or_(R::and_(x, R::set1(-0.0f)), R::set1(0.5f)))); \
+	} \
+	static TARGET GLM_SIMD_INLINE void half(si & r, ps x) \
+	{ \
+		si i = R::castsi(x); \
+		si s = R::andi(R::srli<16>(i), R::set1i(0x8000)); \
+		si a = R::andi(i, R::set1i(0x7fffffff)); \
+		si h = R::srli<13>(R::subi(R::addi(a, R::set1i(0x1000)), R::set1i(0x38000000))); \
+		si small = R::cmpgti(R::set1i(0x38800000), a); \
+		if(R::any(small)) \
+		{ \
+			si d = R::cvtt(R::add(R::mul(R::castps(a), R::set1(16777216.0f)), R::set1(0.5f))); \
+			d = R::andi(d, R::cmpgti(a, R::set1i(0x32ffffff))); \
+			h = R::blendi(small, d, h); \
+		} \
+		h = R::blendi(R::cmpgti(a, R::set1i(0x477fefff)), R::set1i(0x7c00), h); \
+		si nan = R::cmpgti(a, R::set1i(0x7f800000)); \
+		if(R::any(nan)) \
+		{ \
+			si m = R::andi(R::srli<13>(a), R::set1i(0x3ff)); \
+			m = R::ori(m, R::andi(R::cmpeqi(m, R::set1i(0)), R::set1i(1))); \
+			h = R::blendi(nan, R::ori(m, R::set1i(0x7c00)), h); \
+		} \
+		r = R::ori(h, s); \
+	} \
+	static TARGET GLM_SIMD_INLINE void storeSnorm(float * v, si i, float scale) \
+	{ \
+		R::store(v, R::min(R::max(R::mul(R::cvt(i), R::set1(scale)), R::set1(-1.0f)), R::set1(1.0f))); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_pack_unorm8, float const * v, uint8 * p) \
+	{ \
+		si a, b, c, d; \
+		unorm(a, R::load(v), 255.0f); \
+		unorm(b, R::load(v + W), 255.0f); \
+		unorm(c, R::load(v + 2 * W), 255.0f); \
+		unorm(d, R::load(v + 3 * W), 255.0f); \
+		R::store8(p, a, b, c, d); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_unpack_unorm8, uint8 const * p, float * v) \
+	{ \
+		R::store(v, R::mul(R::cvt(R::loadu8(p)), R::set1(static_cast<float>(0.0039215686274509803921568627451)))); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_pack_snorm8, float const * v, uint8 * p) \
+	{ \
+		si a, b, c, d; \
+		snorm(a, R::load(v), 127.0f); \
+		snorm(b, R::load(v + W), 127.0f); \
+		snorm(c, R::load(v + 2 * W), 127.0f); \
+		snorm(d, R::load(v + 3 * W), 127.0f); \
+		R::store8(p, a, b, c, d); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_unpack_snorm8, uint8 const * p, float * v) \
+	{ \
+		storeSnorm(v, R::loads8(p), 0.00787401574803149606299212598425f); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_pack_unorm16, float const * v, uint16 * p) \
+	{ \
+		si a, b; \
+		unorm(a, R::load(v), 65535.0f); \
+		unorm(b, R::load(v + W), 65535.0f); \
+		R::store16(p, a, b); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_unpack_unorm16, uint16 const * p, float * v) \
+	{ \
+		R::store(v, R::mul(R::cvt(R::loadu16(p)), R::set1(1.5259021896696421759365224689097e-5f))); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_pack_snorm16, float const * v, uint16 * p) \
+	{ \
+		si a, b; \
+		snorm(a, R::load(v), 32767.0f); \
+		snorm(b, R::load(v + W), 32767.0f); \
+		R::store16(p, a, b); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_unpack_snorm16, uint16 const * p, float * v) \
+	{ \
+		storeSnorm(v, R::loads16(p), 3.0518509475997192297128208258309e-5f); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_pack_half, float const * v, uint16 * p) \
+	{ \
+		si a, b; \
+		half(a, R::load(v)); \
+		half(b, R::load(v + W)); \
+		R::store16(p, a, b); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_unpack_half, uint16 const * p, float * v) \
+	{ \
+		R::store(v, R::loadHalf(p)); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_pack_unorm3x10_1x2, vec4 const * v, uint32 * p) \
+	{ \
+		ps x, y, z, w; \
+		R::load4(reinterpret_cast<float const *>(v), x, y, z, w); \
+		R::transpose(x, y, z, w); \
+		si a, b, c, d; \
+		unorm(a, x, 1023.0f); \
+		unorm(b, y, 1023.0f); \
+		unorm(c, z, 1023.0f); \
+		unorm(d, w, 3.0f); \
+		a = R::ori(a, R::slli<10>(b)); \
+		a = R::ori(a, R::slli<20>(c)); \
+		R::store32(p, R::ori(a, R::slli<30>(d))); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_unpack_unorm3x10_1x2, uint32 const * p, vec4 * v) \
+	{ \
+		si i = R::load32(p); \
+		si m = R::set1i(0x3ff); \
+		ps x = R::div(R::cvt(R::andi(i, m)), R::set1(1023.f)); \
+		ps y = R::div(R::cvt(R::andi(R::srli<10>(i), m)), R::set1(1023.f)); \
+		ps z = R::div(R::cvt(R::andi(R::srli<20>(i), m)), R::set1(1023.f)); \
+		ps w = R::div(R::cvt(R::srli<30>(i)), R::set1(3.f)); \
+		R::transpose(x, y, z, w); \
+		R::store4(reinterpret_cast<float *>(v), x, y, z, w); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_pack_snorm3x10_1x2, vec4 const * v, uint32 * p) \
+	{ \
+		ps x, y, z, w; \
+		R::load4(reinterpret_cast<float const *>(v), x, y, z, w); \
+		R::transpose(x, y, z, w); \
+		si a, b, c, d; \
+		snorm(a, x, 511.0f); \
+		snorm(b, y, 511.0f); \
+		snorm(c, z, 511.0f); \
+		snorm(d, w, 1.0f); \
+		si m = R::set1i(0x3ff); \
+		a = R::andi(a, m); \
+		a = R::ori(a, R::slli<10>(R::andi(b, m))); \
+		a = R::ori(a, R::slli<20>(R::andi(c, m))); \
+		R::store32(p, R::ori(a, R::slli<30>(d))); \
+	} \
+	static TARGET GLM_SIMD_INLINE void apply(simd_unpack_snorm3x10_1x2, uint32 const * p, vec4 * v) \
+	{ \
+		si i = R::load32(p); \
+		ps lo = R::set1(-1.0f), hi = R::set1(1.0f); \
+		ps x = R::min(R::max(R::div(R::cvt(R::srai<22>(R::slli<22>(i))), R::set1(511.f)), lo), hi); \
+		ps y = R::min(R::max(R::div(R::cvt(R::srai<22>(R::slli<12>(i))), R::set1(511.f)), lo), hi); \
+		ps z = R::min(R::max(R::div(R::cvt(R::srai<22>(R::slli<2>(i))), R::set1(511.f)), lo), hi); \
+		ps w = R::min(R::max(R::cvt(R::srai<30>(i)), lo), hi); \
+		R::transpose(x, y, z, w); \
+		R::store4(reinterpret_cast<float *>(v), x, y, z, w); \
+	} \
+};
+
+GLM_SIMD_PACK_KERNEL(simd_sse2, )
+GLM_SIMD_PACK_KERNEL(simd_avx2, GLM_SIMD_TARGET_AVX2)
+GLM_SIMD_PACK_KERNEL(simd_avx512, GLM_SIMD_TARGET_AVX512)
+
+#undef GLM_SIMD_PACK_KERNEL
+
+/// simdDispatch kernel: run(format, in, count, out).
+template <typename isa>
+struct simd_packing
+{
+	typedef simd_pack_kernel<isa> K;
+
+	template <typename format, typename T, typename U>
+	static GLM_SIMD_INLINE void run(format f, T const * in, std::size_t n, U * out)
+	{
+		enum{B = format::block * K::W};
+
+		std::size_t i = 0;
+		for(; i + B <= n; i += B)
+			K::apply(f, in + i, out + i);
+
+		// The tail goes through a zero padded block, so it converts exactly like the rest
+		if(i < n)
+		{
+			T tin[B] = {};
+			U tout[B];
+			std::copy(in + i, in + n, tin);
+			K::apply(f, tin, tout);
+			std::copy(tout, tout + (n - i), out + i);
+		}
+	}
+};
+
+}//namespace detail
+
+inline void packUnorm1x8(float const * v, std::size_t count, uint8 * p)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_pack_unorm8(), v, count, p);
+}
+
+inline void unpackUnorm1x8(uint8 const * p, std::size_t count, float * v)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_unpack_unorm8(), p, count, v);
+}
+
+inline void packSnorm1x8(float const * v, std::size_t count, uint8 * p)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_pack_snorm8(), v, count, p);
+}
+
+inline void unpackSnorm1x8(uint8 const * p, std::size_t count, float * v)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_unpack_snorm8(), p, count, v);
+}
+
+inline void packUnorm1x16(float const * v, std::size_t count, uint16 * p)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_pack_unorm16(), v, count, p);
+}
+
+inline void unpackUnorm1x16(uint16 const * p, std::size_t count, float * v)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_unpack_unorm16(), p, count, v);
+}
+
+inline void packSnorm1x16(float const * v, std::size_t count, uint16 * p)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_pack_snorm16(), v, count, p);
+}
+
+inline void unpackSnorm1x16(uint16 const * p, std::size_t count, float * v)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_unpack_snorm16(), p, count, v);
+}
+
+inline void packHalf1x16(float const * v, std::size_t count, uint16 * p)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_pack_half(), v, count, p);
+}
+
+inline void unpackHalf1x16(uint16 const * p, std::size_t count, float * v)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_unpack_half(), p, count, v);
+}
+
+inline void packUnorm2x8(vec2 const * v, std::size_t count, uint16 * p)
+{
+	packUnorm1x8(reinterpret_cast<float const *>(v), count * 2, reinterpret_cast<uint8 *>(p));
+}
+
+inline void unpackUnorm2x8(uint16 const * p, std::size_t count, vec2 * v)
+{
+	unpackUnorm1x8(reinterpret_cast<uint8 const *>(p), count * 2, reinterpret_cast<float *>(v));
+}
+
+inline void packSnorm2x8(vec2 const * v, std::size_t count, uint16 * p)
+{
+	packSnorm1x8(reinterpret_cast<float const *>(v), count * 2, reinterpret_cast<uint8 *>(p));
+}
+
+inline void unpackSnorm2x8(uint16 const * p, std::size_t count, vec2 * v)
+{
+	unpackSnorm1x8(reinterpret_cast<uint8 const *>(p), count * 2, reinterpret_cast<float *>(v));
+}
+
+inline void packUnorm4x8(vec4 const * v, std::size_t count, uint32 * p)
+{
+	packUnorm1x8(reinterpret_cast<float const *>(v), count * 4, reinterpret_cast<uint8 *>(p));
+}
+
+inline void unpackUnorm4x8(uint32 const * p, std::size_t count, vec4 * v)
+{
+	unpackUnorm1x8(reinterpret_cast<uint8 const *>(p), count * 4, reinterpret_cast<float *>(v));
+}
+
+inline void packSnorm4x8(vec4 const * v, std::size_t count, uint32 * p)
+{
+	packSnorm1x8(reinterpret_cast<float const *>(v), count * 4, reinterpret_cast<uint8 *>(p));
+}
+
+inline void unpackSnorm4x8(uint32 const * p, std::size_t count, vec4 * v)
+{
+	unpackSnorm1x8(reinterpret_cast<uint8 const *>(p), count * 4, reinterpret_cast<float *>(v));
+}
+
+inline void packUnorm4x16(vec4 const * v, std::size_t count, uint64 * p)
+{
+	packUnorm1x16(reinterpret_cast<float const *>(v), count * 4, reinterpret_cast<uint16 *>(p));
+}
+
+inline void unpackUnorm4x16(uint64 const * p, std::size_t count, vec4 * v)
+{
+	unpackUnorm1x16(reinterpret_cast<uint16 const *>(p), count * 4, reinterpret_cast<float *>(v));
+}
+
+inline void packSnorm4x16(vec4 const * v, std::size_t count, uint64 * p)
+{
+	packSnorm1x16(reinterpret_cast<float const *>(v), count * 4, reinterpret_cast<uint16 *>(p));
+}
+
+inline void unpackSnorm4x16(uint64 const * p, std::size_t count, vec4 * v)
+{
+	unpackSnorm1x16(reinterpret_cast<uint16 const *>(p), count * 4, reinterpret_cast<float *>(v));
+}
+
+inline void packHalf2x16(vec2 const * v, std::size_t count, uint32 * p)
+{
+	packHalf1x16(reinterpret_cast<float const *>(v), count * 2, reinterpret_cast<uint16 *>(p));
+}
+
+inline void unpackHalf2x16(uint32 const * p, std::size_t count, vec2 * v)
+{
+	unpackHalf1x16(reinterpret_cast<uint16 const *>(p), count * 2, reinterpret_cast<float *>(v));
+}
+
+inline void packHalf4x16(vec4 const * v, std::size_t count, uint64 * p)
+{
+	packHalf1x16(reinterpret_cast<float const *>(v), count * 4, reinterpret_cast<uint16 *>(p));
+}
+
+inline void unpackHalf4x16(uint64 const * p, std::size_t count, vec4 * v)
+{
+	unpackHalf1x16(reinterpret_cast<uint16 const *>(p), count * 4, reinterpret_cast<float *>(v));
+}
+
+inline void packSnorm3x10_1x2(vec4 const * v, std::size_t count, uint32 * p)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_pack_snorm3x10_1x2(), v, count, p);
+}
+
+inline void unpackSnorm3x10_1x2(uint32 const * p, std::size_t count, vec4 * v)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_unpack_snorm3x10_1x2(), p, count, v);
+}
+
+inline void packUnorm3x10_1x2(vec4 const * v, std::size_t count, uint32 * p)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_pack_unorm3x10_1x2(), v, count, p);
+}
+
+inline void unpackUnorm3x10_1x2(uint32 const * p, std::size_t count, vec4 * v)
+{
+	simdDispatch<detail::simd_packing>(detail::simd_unpack_unorm3x10_1x2(), p, count, v);
+}
+
+}//namespace glm
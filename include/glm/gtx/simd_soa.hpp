@@ -0,0 +1,223 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// OpenGL Mathematics (glm.g-truc.net)
+///
+/// Copyright (c) 2005 - 2014 G-Truc Creation (www.g-truc.net)
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+/// @ref gtx_simd_soa
+/// @file glm/gtx/simd_soa.hpp
+/// @date 2026-10-17 / 2026-10-17
+///
+/// @see core (dependence)
+/// @see gtx_simd_wide (dependence)
+///
+/// @defgroup gtx_simd_soa GLM_GTX_simd_soa
+/// @ingroup gtx
+///
+/// @brief Structure-of-arrays vec3, vec4 and mat4 packets: N vectors, one SIMD vector per component.
+///
+/// tvec3_soa<isa, N> holds N vec3 as three fvecNSIMD (x, y and z of every lane), so that
+/// packet code reads like the scalar code: dot(d, oc), cross(a, b), normalize(n), m * p.
+/// The geometric functions mirror core_func_geometric lane by lane. N is 4, 8 or 16 and isa
+/// is the instruction set of the kernel (see gtx_simd_wide, simdDispatch).
+///
+/// <glm/gtx/simd_soa.hpp> need to be included to use these functionalities.
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef GLM_GTX_simd_soa
+#define GLM_GTX_simd_soa
+
+// Dependency:
+#include "../glm.hpp"
+#include "simd_wide.hpp"
+
+#if(GLM_ARCH != GLM_ARCH_PURE)
+
+#if(defined(GLM_MESSAGES) && !defined(GLM_EXT_INCLUDED))
+#	pragma message("GLM: GLM_GTX_simd_soa extension included")
+#endif
+
+namespace glm{
+namespace detail
+{
+	/// N vec3 in structure-of-arrays form.
+	/// \ingroup gtx_simd_soa
+	template <typename isa, int N>
+	struct tvec3_soa
+	{
+		typedef fvecNSIMD<isa, N> value_type;
+		enum{size = N};
+
+		value_type x, y, z;
+
+		//////////////////////////////////////
+		// Constructors (uninitialized by default)
+
+		tvec3_soa(){}
+		tvec3_soa(value_type const & x, value_type const & y, value_type const & z);
+		/// Same vector in every lane.
+		explicit tvec3_soa(tvec3<float, defaultp> const & v);
+		explicit tvec3_soa(float s);
+
+		//////////////////////////////////////
+		// Lane access
+
+		tvec3<float, defaultp> lane(int i) const;
+		void setLane(int i, tvec3<float, defaultp> const & v);
+
+		//////////////////////////////////////
+		// Unary arithmetic operators
+
+		tvec3_soa & operator+=(tvec3_soa const & v);
+		tvec3_soa & operator-=(tvec3_soa const & v);
+		tvec3_soa & operator*=(value_type const & s);
+		tvec3_soa & operator*=(float s);
+	};
+
+	/// N vec4 in structure-of-arrays form.
+	/// \ingroup gtx_simd_soa
+	template <typename isa, int N>
+	struct tvec4_soa
+	{
+		typedef fvecNSIMD<isa, N> value_type;
+		enum{size = N};
+
+		value_type x, y, z, w;
+
+		tvec4_soa(){}
+		tvec4_soa(value_type const & x, value_type const & y, value_type const & z, value_type const & w);
+		tvec4_soa(tvec3_soa<isa, N> const & v, value_type const & w);
+		explicit tvec4_soa(tvec4<float, defaultp> const & v);
+
+		tvec4<float, defaultp> lane(int i) const;
+		void setLane(int i, tvec4<float, defaultp> const & v);
+	};
+
+	/// N mat4 in structure-of-arrays form (four columns of tvec4_soa).
+	/// \ingroup gtx_simd_soa
+	template <typename isa, int N>
+	struct tmat4_soa
+	{
+		typedef tvec4_soa<isa, N> col_type;
+
+		col_type value[4];
+
+		tmat4_soa(){}
+		/// Same matrix in every lane, the usual case of one transform for a packet.
+		explicit tmat4_soa(tmat4x4<float, defaultp> const & m);
+
+		col_type & operator[](int i){return value[i];}
+		col_type const & operator[](int i) const{return value[i];}
+
+		void setLane(int i, tmat4x4<float, defaultp> const & m);
+	};
+
+	template <typename isa, int N> tvec3_soa<isa, N> operator+(tvec3_soa<isa, N> const & a, tvec3_soa<isa, N> const & b);
+	template <typename isa, int N> tvec3_soa<isa, N> operator-(tvec3_soa<isa, N> const & a, tvec3_soa<isa, N> const & b);
+	template <typename isa, int N> tvec3_soa<isa, N> operator*(tvec3_soa<isa, N> const & a, tvec3_soa<isa, N> const & b);
+	template <typename isa, int N> tvec3_soa<isa, N> operator/(tvec3_soa<isa, N> const & a, tvec3_soa<isa, N> const & b);
+	template <typename isa, int N> tvec3_soa<isa, N> operator*(tvec3_soa<isa, N> const & a, fvecNSIMD<isa, N> const & s);
+	template <typename isa, int N> tvec3_soa<isa, N> operator*(fvecNSIMD<isa, N> const & s, tvec3_soa<isa, N> const & a);
+	template <typename isa, int N> tvec3_soa<isa, N> operator/(tvec3_soa<isa, N> const & a, fvecNSIMD<isa, N> const & s);
+	template <typename isa, int N> tvec3_soa<isa, N> operator*(tvec3_soa<isa, N> const & a, float s);
+	template <typename isa, int N> tvec3_soa<isa, N> operator*(float s, tvec3_soa<isa, N> const & a);
+	template <typename isa, int N> tvec3_soa<isa, N> operator/(tvec3_soa<isa, N> const & a, float s);
+	template <typename isa, int N> tvec3_soa<isa, N> operator-(tvec3_soa<isa, N> const & a);
+
+	template <typename isa, int N> tvec4_soa<isa, N> operator+(tvec4_soa<isa, N> const & a, tvec4_soa<isa, N> const & b);
+	template <typename isa, int N> tvec4_soa<isa, N> operator*(tvec4_soa<isa, N> const & a, fvecNSIMD<isa, N> const & s);
+
+	//! m * v for every lane.
+	template <typename isa, int N> tvec4_soa<isa, N> operator*(tmat4_soa<isa, N> const & m, tvec4_soa<isa, N> const & v);
+	//! m1 * m2 for every lane.
+	template <typename isa, int N> tmat4_soa<isa, N> operator*(tmat4_soa<isa, N> const & m1, tmat4_soa<isa, N> const & m2);
+}//namespace detail
+
+	template <typename isa, int N> using vec3_soa = detail::tvec3_soa<isa, N>;
+	template <typename isa, int N> using vec4_soa = detail::tvec4_soa<isa, N>;
+	template <typename isa, int N> using mat4_soa = detail::tmat4_soa<isa, N>;
+	template <typename isa> using vec3x4 = detail::tvec3_soa<isa, 4>;
+	template <typename isa> using vec3x8 = detail::tvec3_soa<isa, 8>;
+	template <typename isa> using vec3x16 = detail::tvec3_soa<isa, 16>;
+
+	/// @addtogroup gtx_simd_soa
+	/// @{
+
+	//! Lane-wise dot product.
+	/// @see gtx_simd_soa
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> dot(detail::tvec3_soa<isa, N> const & x, detail::tvec3_soa<isa, N> const & y);
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> dot(detail::tvec4_soa<isa, N> const & x, detail::tvec4_soa<isa, N> const & y);
+
+	//! Lane-wise cross product.
+	/// @see gtx_simd_soa
+	template <typename isa, int N>
+	detail::tvec3_soa<isa, N> cross(detail::tvec3_soa<isa, N> const & x, detail::tvec3_soa<isa, N> const & y);
+
+	//! Lane-wise squared length, dot(x, x).
+	/// @see gtx_simd_soa
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> length2(detail::tvec3_soa<isa, N> const & x);
+
+	//! Lane-wise length.
+	/// @see gtx_simd_soa
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> length(detail::tvec3_soa<isa, N> const & x);
+
+	//! Lane-wise distance, length(p0 - p1).
+	/// @see gtx_simd_soa
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> distance(detail::tvec3_soa<isa, N> const & p0, detail::tvec3_soa<isa, N> const & p1);
+
+	//! Lane-wise normalize: x / length(x) with a correctly rounded square root, like the scalar function.
+	/// @see gtx_simd_soa
+	template <typename isa, int N>
+	detail::tvec3_soa<isa, N> normalize(detail::tvec3_soa<isa, N> const & x);
+
+	//! Lane-wise reflection of I about Nn, I - 2 * dot(Nn, I) * Nn.
+	/// @see gtx_simd_soa
+	template <typename isa, int N>
+	detail::tvec3_soa<isa, N> reflect(detail::tvec3_soa<isa, N> const & I, detail::tvec3_soa<isa, N> const & Nn);
+
+	//! Lane-wise GLSL faceforward: Nn if dot(Nref, I) < 0, otherwise -Nn.
+	/// @see gtx_simd_soa
+	template <typename isa, int N>
+	detail::tvec3_soa<isa, N> faceforward(detail::tvec3_soa<isa, N> const & Nn, detail::tvec3_soa<isa, N> const & I, detail::tvec3_soa<isa, N> const & Nref);
+
+	//! Lane-wise minimum / maximum of each component.
+	/// @see gtx_simd_soa
+	template <typename isa, int N>
+	detail::tvec3_soa<isa, N> min(detail::tvec3_soa<isa, N> const & a, detail::tvec3_soa<isa, N> const & b);
+	template <typename isa, int N>
+	detail::tvec3_soa<isa, N> max(detail::tvec3_soa<isa, N> const & a, detail::tvec3_soa<isa, N> const & b);
+
+	//! Lanes of a where mask is set, otherwise lanes of b.
+	/// @see gtx_simd_soa
+	template <typename isa, int N>
+	detail::tvec3_soa<isa, N> select(detail::bvecNSIMD<isa, N> const & mask, detail::tvec3_soa<isa, N> const & a, detail::tvec3_soa<isa, N> const & b);
+
+	/// @}
+}//namespace glm
+
+#include "simd_soa.inl"
+
+#endif//(GLM_ARCH != GLM_ARCH_PURE)
+
+#endif//GLM_GTX_simd_soa
@@ -0,0 +1,305 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OpenGL Mathematics Copyright (c) 2005 - 2014 G-Truc Creation (www.g-truc.net)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Created : 2026-10-17
+// Updated : 2026-10-17
+// Licence : This source is under MIT License
+// File    : glm/gtx/simd_soa.inl
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace glm{
+namespace detail{
+
+//////////////////////////////////////
+// tvec3_soa
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N>::tvec3_soa(value_type const & x, value_type const & y, value_type const & z) :
+	x(x), y(y), z(z)
+{}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N>::tvec3_soa(tvec3<float, defaultp> const & v) :
+	x(v.x), y(v.y), z(v.z)
+{}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N>::tvec3_soa(float s) :
+	x(s), y(s), z(s)
+{}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3<float, defaultp> tvec3_soa<isa, N>::lane(int i) const
+{
+	return tvec3<float, defaultp>(x[i], y[i], z[i]);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE void tvec3_soa<isa, N>::setLane(int i, tvec3<float, defaultp> const & v)
+{
+	x[i] = v.x;
+	y[i] = v.y;
+	z[i] = v.z;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> & tvec3_soa<isa, N>::operator+=(tvec3_soa const & v)
+{
+	x += v.x;
+	y += v.y;
+	z += v.z;
+	return *this;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> & tvec3_soa<isa, N>::operator-=(tvec3_soa const & v)
+{
+	x -= v.x;
+	y -= v.y;
+	z -= v.z;
+	return *this;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> & tvec3_soa<isa, N>::operator*=(value_type const & s)
+{
+	x *= s;
+	y *= s;
+	z *= s;
+	return *this;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> & tvec3_soa<isa, N>::operator*=(float s)
+{
+	return *this *= value_type(s);
+}
+
+//////////////////////////////////////
+// tvec4_soa
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec4_soa<isa, N>::tvec4_soa(value_type const & x, value_type const & y, value_type const & z, value_type const & w) :
+	x(x), y(y), z(z), w(w)
+{}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec4_soa<isa, N>::tvec4_soa(tvec3_soa<isa, N> const & v, value_type const & w) :
+	x(v.x), y(v.y), z(v.z), w(w)
+{}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec4_soa<isa, N>::tvec4_soa(tvec4<float, defaultp> const & v) :
+	x(v.x), y(v.y), z(v.z), w(v.w)
+{}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec4<float, defaultp> tvec4_soa<isa, N>::lane(int i) const
+{
+	return tvec4<float, defaultp>(x[i], y[i], z[i], w[i]);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE void tvec4_soa<isa, N>::setLane(int i, tvec4<float, defaultp> const & v)
+{
+	x[i] = v.x;
+	y[i] = v.y;
+	z[i] = v.z;
+	w[i] = v.w;
+}
+
+//////////////////////////////////////
+// tmat4_soa
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tmat4_soa<isa, N>::tmat4_soa(tmat4x4<float, defaultp> const & m)
+{
+	for(int i = 0; i < 4; ++i)
+		value[i] = col_type(m[i]);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE void tmat4_soa<isa, N>::setLane(int i, tmat4x4<float, defaultp> const & m)
+{
+	for(int c = 0; c < 4; ++c)
+		value[c].setLane(i, m[c]);
+}
+
+//////////////////////////////////////
+// Operators
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> operator+(tvec3_soa<isa, N> const & a, tvec3_soa<isa, N> const & b)
+{
+	return tvec3_soa<isa, N>(a.x + b.x, a.y + b.y, a.z + b.z);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> operator-(tvec3_soa<isa, N> const & a, tvec3_soa<isa, N> const & b)
+{
+	return tvec3_soa<isa, N>(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> operator*(tvec3_soa<isa, N> const & a, tvec3_soa<isa, N> const & b)
+{
+	return tvec3_soa<isa, N>(a.x * b.x, a.y * b.y, a.z * b.z);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> operator/(tvec3_soa<isa, N> const & a, tvec3_soa<isa, N> const & b)
+{
+	return tvec3_soa<isa, N>(a.x / b.x, a.y / b.y, a.z / b.z);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> operator*(tvec3_soa<isa, N> const & a, fvecNSIMD<isa, N> const & s)
+{
+	return tvec3_soa<isa, N>(a.x * s, a.y * s, a.z * s);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> operator*(fvecNSIMD<isa, N> const & s, tvec3_soa<isa, N> const & a)
+{
+	return a * s;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> operator/(tvec3_soa<isa, N> const & a, fvecNSIMD<isa, N> const & s)
+{
+	return tvec3_soa<isa, N>(a.x / s, a.y / s, a.z / s);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> operator*(tvec3_soa<isa, N> const & a, float s)
+{
+	return a * fvecNSIMD<isa, N>(s);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> operator*(float s, tvec3_soa<isa, N> const & a)
+{
+	return a * fvecNSIMD<isa, N>(s);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> operator/(tvec3_soa<isa, N> const & a, float s)
+{
+	return a / fvecNSIMD<isa, N>(s);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec3_soa<isa, N> operator-(tvec3_soa<isa, N> const & a)
+{
+	return tvec3_soa<isa, N>(-a.x, -a.y, -a.z);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec4_soa<isa, N> operator+(tvec4_soa<isa, N> const & a, tvec4_soa<isa, N> const & b)
+{
+	return tvec4_soa<isa, N>(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec4_soa<isa, N> operator*(tvec4_soa<isa, N> const & a, fvecNSIMD<isa, N> const & s)
+{
+	return tvec4_soa<isa, N>(a.x * s, a.y * s, a.z * s, a.w * s);
+}
+
+// Same order of operations as the scalar mat4 * vec4 (column by column)
+template <typename isa, int N>
+GLM_SIMD_INLINE tvec4_soa<isa, N> operator*(tmat4_soa<isa, N> const & m, tvec4_soa<isa, N> const & v)
+{
+	return m[0] * v.x + m[1] * v.y + m[2] * v.z + m[3] * v.w;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE tmat4_soa<isa, N> operator*(tmat4_soa<isa, N> const & m1, tmat4_soa<isa, N> const & m2)
+{
+	tmat4_soa<isa, N> r;
+	for(int i = 0; i < 4; ++i)
+		r[i] = m1 * m2[i];
+	return r;
+}
+
+}//namespace detail
+
+//////////////////////////////////////
+// Functions
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> dot(detail::tvec3_soa<isa, N> const & x, detail::tvec3_soa<isa, N> const & y)
+{
+	return x.x * y.x + x.y * y.y + x.z * y.z;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> dot(detail::tvec4_soa<isa, N> const & x, detail::tvec4_soa<isa, N> const & y)
+{
+	return x.x * y.x + x.y * y.y + x.z * y.z + x.w * y.w;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::tvec3_soa<isa, N> cross(detail::tvec3_soa<isa, N> const & x, detail::tvec3_soa<isa, N> const & y)
+{
+	return detail::tvec3_soa<isa, N>(
+		x.y * y.z - y.y * x.z,
+		x.z * y.x - y.z * x.x,
+		x.x * y.y - y.x * x.y);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> length2(detail::tvec3_soa<isa, N> const & x)
+{
+	return dot(x, x);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> length(detail::tvec3_soa<isa, N> const & x)
+{
+	return sqrt(dot(x, x));
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> distance(detail::tvec3_soa<isa, N> const & p0, detail::tvec3_soa<isa, N> const & p1)
+{
+	return length(p1 - p0);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::tvec3_soa<isa, N> normalize(detail::tvec3_soa<isa, N> const & x)
+{
+	return x * (1.0f / sqrt(dot(x, x)));
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::tvec3_soa<isa, N> reflect(detail::tvec3_soa<isa, N> const & I, detail::tvec3_soa<isa, N> const & Nn)
+{
+	return I - Nn * dot(Nn, I) * 2.0f;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::tvec3_soa<isa, N> faceforward(detail::tvec3_soa<isa, N> const & Nn, detail::tvec3_soa<isa, N> const & I, detail::tvec3_soa<isa, N> const & Nref)
+{
+	return select(dot(Nref, I) < detail::fvecNSIMD<isa, N>(0.0f), Nn, -Nn);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::tvec3_soa<isa, N> min(detail::tvec3_soa<isa, N> const & a, detail::tvec3_soa<isa, N> const & b)
+{
+	return detail::tvec3_soa<isa, N>(min(a.x, b.x), min(a.y, b.y), min(a.z, b.z));
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::tvec3_soa<isa, N> max(detail::tvec3_soa<isa, N> const & a, detail::tvec3_soa<isa, N> const & b)
+{
+	return detail::tvec3_soa<isa, N>(max(a.x, b.x), max(a.y, b.y), max(a.z, b.z));
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::tvec3_soa<isa, N> select(detail::bvecNSIMD<isa, N> const & mask, detail::tvec3_soa<isa, N> const & a, detail::tvec3_soa<isa, N> const & b)
+{
+	return detail::tvec3_soa<isa, N>(select(mask, a.x, b.x), select(mask, a.y, b.y), select(mask, a.z, b.z));
+}
+
+}//namespace glm
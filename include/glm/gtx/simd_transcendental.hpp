@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// OpenGL Mathematics (glm.g-truc.net)
+///
+/// Copyright (c) 2005 - 2014 G-Truc Creation (www.g-truc.net)
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+/// @ref gtx_simd_transcendental
+/// @file glm/gtx/simd_transcendental.hpp
+/// @date 2026-10-17 / 2026-10-17
+///
+/// @see core (dependence)
+/// @see gtx_simd_wide (dependence)
+/// @see gtx_fast_trigonometry
+/// @see gtx_fast_exponential
+///
+/// @defgroup gtx_simd_transcendental GLM_GTX_simd_transcendental
+/// @ingroup gtx
+///
+/// @brief sin, cos, exp, exp2, log, log2 and pow on fvecNSIMD lanes, with two accuracy tiers.
+///
+/// Each function reduces its argument (quadrant of pi/2, power of two, mantissa and exponent)
+/// and evaluates a minimax polynomial with fma, without branches or tables.
+/// SIMD_ACCURATE uses the single precision Cephes polynomials; SIMD_FAST uses shorter
+/// polynomials fitted for about 16 bits. The tier is the first template argument:
+/// sin(x) is accurate, sin<SIMD_FAST>(x) (or fastSin(x)) is fast.
+///
+/// Maximum error in units in the last place against the exact result, measured on 2^24
+/// random arguments per range plus the range ends, on SSE2 / AVX2 (AVX-512 gives the same
+/// bits as AVX2). The fast sine and cosine are given as absolute error, since they lose
+/// the relative accuracy near their zeros. tools/test_transcendental.cpp reproduces the
+/// table and checks the special values below.
+///
+///   function  range                              SIMD_ACCURATE   SIMD_FAST       glibc
+///   sin, cos  [-pi, pi]                          1.6 / 1.6       1.2e-5 abs      0.56
+///   sin, cos  [-8192, 8192]                      2.4 / 2.4       1.3e-5 abs      0.56
+///   exp       [-87.3, 88.7]                      1.0 / 1.1       122 / 73        0.50
+///   exp       [-103, -87.3] (denormal result)    0.8 / 0.8       50 / 34         0.50
+///   exp2      [-126, 128]                        1.0 / 1.0       70 / 70         0.50
+///   log       normal x > 0                       0.9 / 0.9       141 / 141       0.82
+///   log       denormal x                         0.5 / 0.5       0.9 / 0.9       0.50
+///   log2      normal x > 0                       1.4 / 1.3       142 / 142       0.74
+///   pow       x in [1e-3, 1e3], |y| <= 4         3.7 / 3.1       218 / 218       0.50
+///   pow       x in [1e-3, 1e3], |y| <= 12        8.1 / 6.8       588 / 588       0.50
+///   pow       x in [0.5, 2], |y| <= 64           38 / 39         3108 / 3108     0.51
+///
+/// Special values follow C: sin and cos of inf or NaN are NaN; exp overflows to +inf and
+/// underflows through the denormals to 0; log of 0 is -inf and of a negative number NaN;
+/// pow(x, +-inf) is inf or 0, pow(x, 0) and pow(1, y) are 1. Unlike C, a negative base
+/// always gives NaN. The pi/2 reduction is exact for |x| <= 8192 only: above that the error
+/// of sin and cos grows with |x| (there is no Payne-Hanek reduction).
+///
+/// <glm/gtx/simd_transcendental.hpp> need to be included to use these functionalities.
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef GLM_GTX_simd_transcendental
+#define GLM_GTX_simd_transcendental
+
+// Dependency:
+#include "../glm.hpp"
+#include "simd_wide.hpp"
+
+#if(GLM_ARCH != GLM_ARCH_PURE)
+
+#if(defined(GLM_MESSAGES) && !defined(GLM_EXT_INCLUDED))
+#	pragma message("GLM: GLM_GTX_simd_transcendental extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_simd_transcendental
+	/// @{
+
+	/// Accuracy tiers.
+	enum simdAccuracy
+	{
+		SIMD_FAST,        //!< about 16 correct bits, shorter polynomials and reductions
+		SIMD_ACCURATE     //!< a few ulp, see the table above
+	};
+
+	//! Lane-wise sine and cosine of x in radians.
+	/// @see gtx_simd_transcendental
+	template <simdAccuracy A = SIMD_ACCURATE, typename isa, int N>
+	detail::fvecNSIMD<isa, N> sin(detail::fvecNSIMD<isa, N> const & x);
+	template <simdAccuracy A = SIMD_ACCURATE, typename isa, int N>
+	detail::fvecNSIMD<isa, N> cos(detail::fvecNSIMD<isa, N> const & x);
+
+	//! Sine and cosine sharing one argument reduction.
+	/// @see gtx_simd_transcendental
+	template <simdAccuracy A = SIMD_ACCURATE, typename isa, int N>
+	void sincos(detail::fvecNSIMD<isa, N> const & x, detail::fvecNSIMD<isa, N> & s, detail::fvecNSIMD<isa, N> & c);
+
+	//! Lane-wise e^x and 2^x.
+	/// @see gtx_simd_transcendental
+	template <simdAccuracy A = SIMD_ACCURATE, typename isa, int N>
+	detail::fvecNSIMD<isa, N> exp(detail::fvecNSIMD<isa, N> const & x);
+	template <simdAccuracy A = SIMD_ACCURATE, typename isa, int N>
+	detail::fvecNSIMD<isa, N> exp2(detail::fvecNSIMD<isa, N> const & x);
+
+	//! Lane-wise natural and base 2 logarithm.
+	/// @see gtx_simd_transcendental
+	template <simdAccuracy A = SIMD_ACCURATE, typename isa, int N>
+	detail::fvecNSIMD<isa, N> log(detail::fvecNSIMD<isa, N> const & x);
+	template <simdAccuracy A = SIMD_ACCURATE, typename isa, int N>
+	detail::fvecNSIMD<isa, N> log2(detail::fvecNSIMD<isa, N> const & x);
+
+	//! base^exponent for base >= 0, computed as exp2(exponent * log2(base)) with the integral
+	//! part of the product kept exact; the error grows with |exponent| (see the table above).
+	/// @see gtx_simd_transcendental
+	template <simdAccuracy A = SIMD_ACCURATE, typename isa, int N>
+	detail::fvecNSIMD<isa, N> pow(detail::fvecNSIMD<isa, N> const & base, detail::fvecNSIMD<isa, N> const & exponent);
+
+	//! SIMD_FAST forms under the names of gtx_fast_trigonometry and gtx_fast_exponential.
+	/// @see gtx_simd_transcendental
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> fastSin(detail::fvecNSIMD<isa, N> const & x);
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> fastCos(detail::fvecNSIMD<isa, N> const & x);
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> fastExp(detail::fvecNSIMD<isa, N> const & x);
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> fastExp2(detail::fvecNSIMD<isa, N> const & x);
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> fastLog(detail::fvecNSIMD<isa, N> const & x);
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> fastLog2(detail::fvecNSIMD<isa, N> const & x);
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> fastPow(detail::fvecNSIMD<isa, N> const & base, detail::fvecNSIMD<isa, N> const & exponent);
+
+	/// @}
+}//namespace glm
+
+#include "simd_transcendental.inl"
+
+#endif//(GLM_ARCH != GLM_ARCH_PURE)
+
+#endif//GLM_GTX_simd_transcendental
@@ -0,0 +1,337 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OpenGL Mathematics Copyright (c) 2005 - 2014 G-Truc Creation (www.g-truc.net)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Created : 2026-10-17
+// Updated : 2026-10-17
+// Licence : This source is under MIT License
+// File    : glm/gtx/simd_transcendental.inl
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <limits>
+
+namespace glm{
+namespace detail{
+
+// Polynomials and reductions of one tier. sin and cos are evaluated on r in [-pi/4, pi/4]
+// (z = r * r), exp on r in [-ln2/2, ln2/2], log1p returns log(1 + f) - f for f in
+// [sqrt(0.5) - 1, sqrt(2) - 1].
+template <simdAccuracy A>
+struct simd_transcendental;
+
+// Cephes sinf, cosf, expf and logf
+template <>
+struct simd_transcendental<SIMD_ACCURATE>
+{
+	// pi/2 in four parts. The first three have at most 11 bits, so for |x| <= 8192 their
+	// products with n are exact even without FMA and the steps only round relative to r.
+	template <typename isa, int N>
+	static GLM_SIMD_INLINE fvecNSIMD<isa, N> reducePi(fvecNSIMD<isa, N> const & x, fvecNSIMD<isa, N> const & n)
+	{
+		typedef fvecNSIMD<isa, N> F;
+		F r = fma(n, F(-1.5703125f), x);
+		r = fma(n, F(-4.837512969970703125e-4f), r);
+		r = fma(n, F(-7.5495336204767227173e-8f), r);
+		return fma(n, F(-2.563344068e-12f), r);
+	}
+
+	template <typename isa, int N>
+	static GLM_SIMD_INLINE fvecNSIMD<isa, N> sin(fvecNSIMD<isa, N> const & r, fvecNSIMD<isa, N> const & z)
+	{
+		typedef fvecNSIMD<isa, N> F;
+		F p = fma(z, F(-1.9515295891e-4f), F(8.3321608736e-3f));
+		p = fma(z, p, F(-1.6666654611e-1f));
+		return fma(r * z, p, r);
+	}
+
+	template <typename isa, int N>
+	static GLM_SIMD_INLINE fvecNSIMD<isa, N> cos(fvecNSIMD<isa, N> const & z)
+	{
+		typedef fvecNSIMD<isa, N> F;
+		F p = fma(z, F(2.443315711809948e-5f), F(-1.388731625493765e-3f));
+		p = fma(z, p, F(4.166664568298827e-2f));
+		return fma(z * z, p, fma(z, F(-0.5f), F(1.0f)));
+	}
+
+	// ln2 in two parts
+	template <typename isa, int N>
+	static GLM_SIMD_INLINE fvecNSIMD<isa, N> reduceLn2(fvecNSIMD<isa, N> const & x, fvecNSIMD<isa, N> const & n)
+	{
+		typedef fvecNSIMD<isa, N> F;
+		return fma(n, F(2.12194440e-4f), fma(n, F(-0.693359375f), x));
+	}
+
+	template <typename isa, int N>
+	static GLM_SIMD_INLINE fvecNSIMD<isa, N> exp(fvecNSIMD<isa, N> const & r)
+	{
+		typedef fvecNSIMD<isa, N> F;
+		F p = fma(r, F(1.9875691500e-4f), F(1.3981999507e-3f));
+		p = fma(r, p, F(8.3334519073e-3f));
+		p = fma(r, p, F(4.1665795894e-2f));
+		p = fma(r, p, F(1.6666665459e-1f));
+		p = fma(r, p, F(5.0000001201e-1f));
+		return fma(r * r, p, r) + F(1.0f);
+	}
+
+	template <typename isa, int N>
+	static GLM_SIMD_INLINE fvecNSIMD<isa, N> log1p(fvecNSIMD<isa, N> const & f)
+	{
+		typedef fvecNSIMD<isa, N> F;
+		F p = fma(f, F(7.0376836292e-2f), F(-1.1514610310e-1f));
+		p = fma(f, p, F(1.1676998740e-1f));
+		p = fma(f, p, F(-1.2420140846e-1f));
+		p = fma(f, p, F(1.4249322787e-1f));
+		p = fma(f, p, F(-1.6668057665e-1f));
+		p = fma(f, p, F(2.0000714765e-1f));
+		p = fma(f, p, F(-2.4999993993e-1f));
+		p = fma(f, p, F(3.3333331174e-1f));
+		F z = f * f;
+		return fma(z, F(-0.5f), f * z * p);
+	}
+};
+
+// Minimax fits for about 16 bits: degree 5 sine, degree 4 cosine, degree 4 exp and degree 6 log1p
+template <>
+struct simd_transcendental<SIMD_FAST>
+{
+	template <typename isa, int N>
+	static GLM_SIMD_INLINE fvecNSIMD<isa, N> reducePi(fvecNSIMD<isa, N> const & x, fvecNSIMD<isa, N> const & n)
+	{
+		typedef fvecNSIMD<isa, N> F;
+		return fma(n, F(-4.83826794e-4f), fma(n, F(-1.5703125f), x));
+	}
+
+	template <typename isa, int N>
+	static GLM_SIMD_INLINE fvecNSIMD<isa, N> sin(fvecNSIMD<isa, N> const & r, fvecNSIMD<isa, N> const & z)
+	{
+		typedef fvecNSIMD<isa, N> F;
+		return fma(r * z, fma(z, F(8.163281716e-3f), F(-1.666339040e-1f)), r);
+	}
+
+	template <typename isa, int N>
+	static GLM_SIMD_INLINE fvecNSIMD<isa, N> cos(fvecNSIMD<isa, N> const & z)
+	{
+		typedef fvecNSIMD<isa, N> F;
+		return fma(z, fma(z, F(4.048893601e-2f), F(-4.997763038e-1f)), F(1.0f));
+	}
+
+	template <typename isa, int N>
+	static GLM_SIMD_INLINE fvecNSIMD<isa, N> reduceLn2(fvecNSIMD<isa, N> const & x, fvecNSIMD<isa, N> const & n)
+	{
+		typedef fvecNSIMD<isa, N> F;
+		return fma(n, F(-0.693147182f), x);
+	}
+
+	template <typename isa, int N>
+	static GLM_SIMD_INLINE fvecNSIMD<isa, N> exp(fvecNSIMD<isa, N> const & r)
+	{
+		typedef fvecNSIMD<isa, N> F;
+		F p = fma(r, F(4.127774760e-2f), F(1.675351411e-1f));
+		p = fma(r, p, F(5.000511408e-1f));
+		return fma(r * r, p, r) + F(1.0f);
+	}
+
+	template <typename isa, int N>
+	static GLM_SIMD_INLINE fvecNSIMD<isa, N> log1p(fvecNSIMD<isa, N> const & f)
+	{
+		typedef fvecNSIMD<isa, N> F;
+		F p = fma(f, F(-1.421605051e-1f), F(2.192810476e-1f));
+		p = fma(f, p, F(-2.538796663e-1f));
+		p = fma(f, p, F(3.327403069e-1f));
+		p = fma(f, p, F(-4.999174178e-1f));
+		return f * f * p;
+	}
+};
+
+// x = (m + f) * 2^e with f in [sqrt(0.5) - 1, sqrt(2) - 1]
+template <typename isa, int N>
+GLM_SIMD_INLINE fvecNSIMD<isa, N> simd_log_reduce(fvecNSIMD<isa, N> const & x, fvecNSIMD<isa, N> & e)
+{
+	typedef fvecNSIMD<isa, N> F;
+	F m = frexp(x, e);
+	bvecNSIMD<isa, N> small = m < F(0.707106781186547524f);
+	e = e - select(small, F(1.0f), F(0.0f));
+	return select(small, m + m, m) - F(1.0f);
+}
+
+// log2(x) = e + L with L = log2(1 + f), Cephes log2f: (f + tail) * log2(e) with log2(e) - 1 as the multiplier
+template <simdAccuracy A, typename isa, int N>
+GLM_SIMD_INLINE fvecNSIMD<isa, N> simd_log2_reduce(fvecNSIMD<isa, N> const & x, fvecNSIMD<isa, N> & e)
+{
+	typedef fvecNSIMD<isa, N> F;
+	F f = simd_log_reduce(x, e);
+	F y = simd_transcendental<A>::log1p(f);
+	F z = fma(f, F(0.44269504088896340736f), y * F(0.44269504088896340736f));
+	return (z + y) + f;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE fvecNSIMD<isa, N> simd_and_bits(fvecNSIMD<isa, N> const & x, unsigned int bits)
+{
+	fvecNSIMD<isa, N> r;
+	simd_ops<isa, N>::and_(x.Data, fvecNSIMD<isa, N>(simd_float_bits(bits)).Data, r.Data);
+	return r;
+}
+
+// log(0) = -inf, log(x < 0) = NaN, log(inf) = inf; NaN stays NaN
+template <typename isa, int N>
+GLM_SIMD_INLINE fvecNSIMD<isa, N> simd_log_special(fvecNSIMD<isa, N> const & x, fvecNSIMD<isa, N> const & r)
+{
+	typedef fvecNSIMD<isa, N> F;
+	F const inf(std::numeric_limits<float>::infinity());
+	F v = select(x == F(0.0f), -inf, r);
+	v = select(x < F(0.0f), F(std::numeric_limits<float>::quiet_NaN()), v);
+	return select(x == inf, inf, v);
+}
+
+}//namespace detail
+
+template <simdAccuracy A, typename isa, int N>
+GLM_SIMD_INLINE void sincos(detail::fvecNSIMD<isa, N> const & x, detail::fvecNSIMD<isa, N> & s, detail::fvecNSIMD<isa, N> & c)
+{
+	typedef detail::fvecNSIMD<isa, N> F;
+	typedef detail::simd_transcendental<A> T;
+
+	F n = roundEven(x * F(0.636619772367581343f));
+	F r = T::reducePi(x, n);
+	F z = r * r;
+	F ps = T::sin(r, z);
+	F pc = T::cos(z);
+
+	// Quadrant n mod 4 (the fraction of n / 4 - 0.375 is never one half)
+	F q = n - F(4.0f) * roundEven(n * F(0.25f) - F(0.375f));
+	detail::bvecNSIMD<isa, N> odd = (q == F(1.0f)) | (q == F(3.0f));
+	F sv = select(odd, pc, ps);
+	F cv = select(odd, ps, pc);
+	s = select(q >= F(2.0f), -sv, sv);
+	c = select((q == F(1.0f)) | (q == F(2.0f)), -cv, cv);
+}
+
+template <simdAccuracy A, typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> sin(detail::fvecNSIMD<isa, N> const & x)
+{
+	detail::fvecNSIMD<isa, N> s, c;
+	sincos<A>(x, s, c);
+	return s;
+}
+
+template <simdAccuracy A, typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> cos(detail::fvecNSIMD<isa, N> const & x)
+{
+	detail::fvecNSIMD<isa, N> s, c;
+	sincos<A>(x, s, c);
+	return c;
+}
+
+// The clamps keep NaN (max and min return their second operand when one is NaN) and put
+// the exponent in the range of ldexp, which then overflows or underflows exactly like the
+// result should.
+template <simdAccuracy A, typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> exp(detail::fvecNSIMD<isa, N> const & x)
+{
+	typedef detail::fvecNSIMD<isa, N> F;
+	typedef detail::simd_transcendental<A> T;
+
+	F xc = min(F(89.0f), max(F(-104.0f), x));
+	F n = roundEven(xc * F(1.44269504088896341f));
+	return ldexp(T::exp(T::reduceLn2(xc, n)), n);
+}
+
+template <simdAccuracy A, typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> exp2(detail::fvecNSIMD<isa, N> const & x)
+{
+	typedef detail::fvecNSIMD<isa, N> F;
+	typedef detail::simd_transcendental<A> T;
+
+	F xc = min(F(129.0f), max(F(-151.0f), x));
+	F n = roundEven(xc);
+	return ldexp(T::exp((xc - n) * F(0.693147180559945309f)), n);
+}
+
+// Cephes logf: log(x) = e * ln2 + f + log1p tail, ln2 in two parts
+template <simdAccuracy A, typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> log(detail::fvecNSIMD<isa, N> const & x)
+{
+	typedef detail::fvecNSIMD<isa, N> F;
+
+	F e;
+	F f = detail::simd_log_reduce(x, e);
+	F y = fma(e, F(-2.12194440e-4f), detail::simd_transcendental<A>::log1p(f));
+	return detail::simd_log_special(x, fma(e, F(0.693359375f), f + y));
+}
+
+template <simdAccuracy A, typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> log2(detail::fvecNSIMD<isa, N> const & x)
+{
+	detail::fvecNSIMD<isa, N> e;
+	detail::fvecNSIMD<isa, N> l = detail::simd_log2_reduce<A>(x, e);
+	return detail::simd_log_special(x, l + e);
+}
+
+// exponent * log2(base) is carried as an integer and a fraction: with the exponent split in
+// two halves of 12 bits, both products with the integral e of log2 are exact, so only
+// exponent * log2(1 + f) is rounded and the error does not grow with e.
+template <simdAccuracy A, typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> pow(detail::fvecNSIMD<isa, N> const & base, detail::fvecNSIMD<isa, N> const & exponent)
+{
+	typedef detail::fvecNSIMD<isa, N> F;
+	F const inf(std::numeric_limits<float>::infinity());
+
+	F e;
+	F l = detail::simd_log2_reduce<A>(base, e);
+	F yh = detail::simd_and_bits(exponent, 0xfffff000u);
+	F p = yh * e;
+	F n = roundEven(p);
+	F t = fma(exponent - yh, e, p - n) + exponent * l;
+	F m = roundEven(t);
+	F r = ldexp(detail::simd_transcendental<A>::exp((t - m) * F(0.693147180559945309f)), min(F(129.0f), max(F(-151.0f), n + m)));
+
+	// 0 and inf bases, infinite exponents, negative bases, then x^0 = 1^y = 1
+	r = select((base == F(0.0f)) | (base == inf), select((base == inf) ^ (exponent < F(0.0f)), inf, F(0.0f)), r);
+	r = select(abs(exponent) == inf, select((base > F(1.0f)) ^ (exponent < F(0.0f)), inf, F(0.0f)), r);
+	r = select(base < F(0.0f), F(std::numeric_limits<float>::quiet_NaN()), r);
+	return select((exponent == F(0.0f)) | (base == F(1.0f)), F(1.0f), r);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> fastSin(detail::fvecNSIMD<isa, N> const & x)
+{
+	return sin<SIMD_FAST>(x);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> fastCos(detail::fvecNSIMD<isa, N> const & x)
+{
+	return cos<SIMD_FAST>(x);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> fastExp(detail::fvecNSIMD<isa, N> const & x)
+{
+	return exp<SIMD_FAST>(x);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> fastExp2(detail::fvecNSIMD<isa, N> const & x)
+{
+	return exp2<SIMD_FAST>(x);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> fastLog(detail::fvecNSIMD<isa, N> const & x)
+{
+	return log<SIMD_FAST>(x);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> fastLog2(detail::fvecNSIMD<isa, N> const & x)
+{
+	return log2<SIMD_FAST>(x);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> fastPow(detail::fvecNSIMD<isa, N> const & base, detail::fvecNSIMD<isa, N> const & exponent)
+{
+	return pow<SIMD_FAST>(base, exponent);
+}
+
+}//namespace glm
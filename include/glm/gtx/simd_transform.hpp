@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// OpenGL Mathematics (glm.g-truc.net)
+///
+/// Copyright (c) 2005 - 2014 G-Truc Creation (www.g-truc.net)
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+/// @ref gtx_simd_transform
+/// @file glm/gtx/simd_transform.hpp
+/// @date 2026-10-17 / 2026-10-17
+///
+/// @see core (dependence)
+/// @see gtx_simd_wide (dependence)
+/// @see gtx_simd_mat4
+///
+/// @defgroup gtx_simd_transform GLM_GTX_simd_transform
+/// @ingroup gtx
+///
+/// @brief Transforms of whole arrays of points, vectors, normals and bounding boxes by one mat4.
+///
+/// The arrays are either AoS, vec3 (or vec4) elements a fixed number of bytes apart so that
+/// positions or normals can be transformed in place inside interleaved vertex or particle
+/// records, or SoA, one float array per component. AoS elements are transposed into registers
+/// 8 at a time and SoA elements loaded 8 (16 on AVX-512) at a time, with the instruction set
+/// picked by simdDispatch; arrays of at least 2^16 elements are split over
+/// std::thread::hardware_concurrency() threads. Output may be the same array as the input.
+/// Results are those of the scalar expressions noted below up to the rounding of the
+/// multiply-adds (fused on AVX2 and AVX-512). A simdMat4 converts with mat4_cast.
+///
+/// <glm/gtx/simd_transform.hpp> need to be included to use these functionalities.
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef GLM_GTX_simd_transform
+#define GLM_GTX_simd_transform
+
+// Dependency:
+#include "../glm.hpp"
+#include "simd_wide.hpp"
+#include <cstddef>
+
+#if(GLM_ARCH != GLM_ARCH_PURE)
+
+#if(defined(GLM_MESSAGES) && !defined(GLM_EXT_INCLUDED))
+#	pragma message("GLM: GLM_GTX_simd_transform extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_simd_transform
+	/// @{
+
+	//! out[i] = vec3(m * vec4(in[i], 1)) for i < count, elements stride bytes apart
+	//! (the affine part of m: no division by w).
+	/// @see gtx_simd_transform
+	void transformPoints(mat4 const & m, vec3 const * in, std::size_t count, vec3 * out, std::size_t stride = sizeof(vec3));
+
+	//! out[i] = m * in[i] for i < count, elements stride bytes apart.
+	/// @see gtx_simd_transform
+	void transformPoints(mat4 const & m, vec4 const * in, std::size_t count, vec4 * out, std::size_t stride = sizeof(vec4));
+
+	//! out[i] = mat3(m) * in[i] for i < count, elements stride bytes apart.
+	/// @see gtx_simd_transform
+	void transformVectors(mat4 const & m, vec3 const * in, std::size_t count, vec3 * out, std::size_t stride = sizeof(vec3));
+
+	//! out[i] = normalize(transpose(inverse(mat3(m))) * in[i]) for i < count, elements stride
+	//! bytes apart. The inverse-transpose is computed once.
+	/// @see gtx_simd_transform
+	void transformNormals(mat4 const & m, vec3 const * in, std::size_t count, vec3 * out, std::size_t stride = sizeof(vec3));
+
+	//! [outLo[i], outHi[i]] contains the 8 transformed corners of [lo[i], hi[i]]: the center is
+	//! transformed as a point, the half extent by the absolute values of mat3(m), and the result
+	//! is widened by a relative 2^-20 so that rounding never leaves a corner outside.
+	/// @see gtx_simd_transform
+	void transformAABBs(mat4 const & m, vec3 const * lo, vec3 const * hi, std::size_t count, vec3 * outLo, vec3 * outHi, std::size_t stride = sizeof(vec3));
+
+	//! SoA forms: component arrays x, y, z in and ox, oy, oz out.
+	/// @see gtx_simd_transform
+	void transformPoints(mat4 const & m, float const * x, float const * y, float const * z, std::size_t count, float * ox, float * oy, float * oz);
+	void transformVectors(mat4 const & m, float const * x, float const * y, float const * z, std::size_t count, float * ox, float * oy, float * oz);
+	void transformNormals(mat4 const & m, float const * x, float const * y, float const * z, std::size_t count, float * ox, float * oy, float * oz);
+
+	/// @}
+}//namespace glm
+
+#include "simd_transform.inl"
+
+#endif//(GLM_ARCH != GLM_ARCH_PURE)
+
+#endif//GLM_GTX_simd_transform
@@ -0,0 +1,450 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OpenGL Mathematics Copyright (c) 2005 - 2014 G-Truc Creation (www.g-truc.net)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Created : 2026-10-17
+// Updated : 2026-10-17
+// Licence : This source is under MIT License
+// File    : glm/gtx/simd_transform.inl
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace glm{
+namespace detail{
+
+//////////////////////////////////////
+// AoS registers
+
+/// Transposes between width elements of C = 3 or 4 floats, stride bytes apart, and C arrays
+/// of width floats. With C = 3 every element but the last is read as 4 floats, the fourth
+/// being the next bytes of the same record or the next element; the last one is read with
+/// 12 bytes so that nothing past the elements is touched. Writes touch only the C floats.
+template <typename isa>
+struct simd_aos_reg;
+
+template <>
+struct simd_aos_reg<simd_sse2>
+{
+	enum{width = 4};
+
+	template <int C>
+	static GLM_SIMD_INLINE __m128 row(char const * p, bool last)
+	{
+		if(C == 3 && last)
+			return _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const *>(p))), _mm_load_ss(reinterpret_cast<float const *>(p) + 2));
+		return _mm_loadu_ps(reinterpret_cast<float const *>(p));
+	}
+
+	template <int C>
+	static GLM_SIMD_INLINE void row(char * p, __m128 v)
+	{
+		if(C == 4)
+			_mm_storeu_ps(reinterpret_cast<float *>(p), v);
+		else
+		{
+			_mm_storel_pi(reinterpret_cast<__m64 *>(p), v);
+			_mm_store_ss(reinterpret_cast<float *>(p) + 2, _mm_movehl_ps(v, v));
+		}
+	}
+
+	template <int C>
+	static GLM_SIMD_INLINE void load(char const * p, std::size_t stride, float * const * r)
+	{
+		__m128 a = row<C>(p, false), b = row<C>(p + stride, false), c = row<C>(p + 2 * stride, false), d = row<C>(p + 3 * stride, true);
+		_MM_TRANSPOSE4_PS(a, b, c, d);
+		_mm_storeu_ps(r[0], a);
+		_mm_storeu_ps(r[1], b);
+		_mm_storeu_ps(r[2], c);
+		if(C == 4)
+			_mm_storeu_ps(r[3], d);
+	}
+
+	template <int C>
+	static GLM_SIMD_INLINE void store(float const * const * r, char * p, std::size_t stride)
+	{
+		__m128 a = _mm_loadu_ps(r[0]), b = _mm_loadu_ps(r[1]), c = _mm_loadu_ps(r[2]), d = C == 4 ? _mm_loadu_ps(r[3]) : _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(a, b, c, d);
+		row<C>(p, a);
+		row<C>(p + stride, b);
+		row<C>(p + 2 * stride, c);
+		row<C>(p + 3 * stride, d);
+	}
+};
+
+// Elements k and k + 4 share a register, one per 128-bit half, and are transposed in place.
+template <>
+struct simd_aos_reg<simd_avx2>
+{
+	enum{width = 8};
+
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void transpose(__m256 & a, __m256 & b, __m256 & c, __m256 & d)
+	{
+		__m256 t0 = _mm256_unpacklo_ps(a, b), t1 = _mm256_unpackhi_ps(a, b);
+		__m256 t2 = _mm256_unpacklo_ps(c, d), t3 = _mm256_unpackhi_ps(c, d);
+		a = _mm256_shuffle_ps(t0, t2, 0x44);
+		b = _mm256_shuffle_ps(t0, t2, 0xee);
+		c = _mm256_shuffle_ps(t1, t3, 0x44);
+		d = _mm256_shuffle_ps(t1, t3, 0xee);
+	}
+
+	template <int C>
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE __m256 rows(char const * p, std::size_t stride, bool last)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(simd_aos_reg<simd_sse2>::row<C>(p, false)), simd_aos_reg<simd_sse2>::row<C>(p + 4 * stride, last), 1);
+	}
+
+	template <int C>
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void rows(char * p, std::size_t stride, __m256 v)
+	{
+		simd_aos_reg<simd_sse2>::row<C>(p, _mm256_castps256_ps128(v));
+		simd_aos_reg<simd_sse2>::row<C>(p + 4 * stride, _mm256_extractf128_ps(v, 1));
+	}
+
+	template <int C>
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void load(char const * p, std::size_t stride, float * const * r)
+	{
+		__m256 a = rows<C>(p, stride, false), b = rows<C>(p + stride, stride, false), c = rows<C>(p + 2 * stride, stride, false), d = rows<C>(p + 3 * stride, stride, true);
+		transpose(a, b, c, d);
+		_mm256_storeu_ps(r[0], a);
+		_mm256_storeu_ps(r[1], b);
+		_mm256_storeu_ps(r[2], c);
+		if(C == 4)
+			_mm256_storeu_ps(r[3], d);
+	}
+
+	template <int C>
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void store(float const * const * r, char * p, std::size_t stride)
+	{
+		__m256 a = _mm256_loadu_ps(r[0]), b = _mm256_loadu_ps(r[1]), c = _mm256_loadu_ps(r[2]), d = C == 4 ? _mm256_loadu_ps(r[3]) : _mm256_setzero_ps();
+		transpose(a, b, c, d);
+		rows<C>(p, stride, a);
+		rows<C>(p + stride, stride, b);
+		rows<C>(p + 2 * stride, stride, c);
+		rows<C>(p + 3 * stride, stride, d);
+	}
+};
+
+// The transposes gain nothing from 16 lanes; AVX-512 moves two groups of 8 elements.
+template <>
+struct simd_aos_reg<simd_avx512> : public simd_aos_reg<simd_avx2>
+{};
+
+//////////////////////////////////////
+// Arrays
+
+// Strided AoS array of C floats per element; the tail goes through a zero padded block.
+template <int C>
+struct simd_aos
+{
+	char const * src;
+	char * dst;
+	std::size_t stride;
+
+	template <typename isa, int N>
+	GLM_SIMD_INLINE void load(std::size_t i, std::size_t n, fvecNSIMD<isa, N> * v) const
+	{
+		typedef simd_aos_reg<isa> R;
+		if(n == std::size_t(N))
+		{
+			for(int k = 0; k < N; k += R::width)
+			{
+				float * r[4] = {v[0].Data + k, v[1].Data + k, v[2].Data + k, v[C - 1].Data + k};
+				R::template load<C>(src + (i + k) * stride, stride, r);
+			}
+			return;
+		}
+		alignas(64) float t[C][N] = {};
+		char const * p = src + i * stride;
+		for(std::size_t k = 0; k < n; ++k, p += stride)
+			for(int c = 0; c < C; ++c)
+				t[c][k] = reinterpret_cast<float const *>(p)[c];
+		for(int c = 0; c < C; ++c)
+			v[c] = fvecNSIMD<isa, N>(t[c]);
+	}
+
+	template <typename isa, int N>
+	GLM_SIMD_INLINE void store(std::size_t i, std::size_t n, fvecNSIMD<isa, N> const * v) const
+	{
+		typedef simd_aos_reg<isa> R;
+		if(n == std::size_t(N))
+		{
+			for(int k = 0; k < N; k += R::width)
+			{
+				float const * r[4] = {v[0].Data + k, v[1].Data + k, v[2].Data + k, v[C - 1].Data + k};
+				R::template store<C>(r, dst + (i + k) * stride, stride);
+			}
+			return;
+		}
+		alignas(64) float t[C][N];
+		for(int c = 0; c < C; ++c)
+			v[c].store(t[c]);
+		char * p = dst + i * stride;
+		for(std::size_t k = 0; k < n; ++k, p += stride)
+			for(int c = 0; c < C; ++c)
+				reinterpret_cast<float *>(p)[c] = t[c][k];
+	}
+};
+
+// SoA array of 3 components
+struct simd_soa3
+{
+	float const * src[3];
+	float * dst[3];
+
+	template <typename F>
+	GLM_SIMD_INLINE void load(std::size_t i, std::size_t n, F * v) const
+	{
+		if(n == std::size_t(F::size))
+		{
+			v[0] = F(src[0] + i);
+			v[1] = F(src[1] + i);
+			v[2] = F(src[2] + i);
+			return;
+		}
+		for(int c = 0; c < 3; ++c)
+		{
+			alignas(64) float t[F::size] = {};
+			std::copy(src[c] + i, src[c] + i + n, t);
+			v[c] = F(t);
+		}
+	}
+
+	template <typename F>
+	GLM_SIMD_INLINE void store(std::size_t i, std::size_t n, F const * v) const
+	{
+		if(n == std::size_t(F::size))
+		{
+			v[0].store(dst[0] + i);
+			v[1].store(dst[1] + i);
+			v[2].store(dst[2] + i);
+			return;
+		}
+		for(int c = 0; c < 3; ++c)
+		{
+			alignas(64) float t[F::size];
+			v[c].store(t);
+			std::copy(t, t + n, dst[c] + i);
+		}
+	}
+};
+
+struct simd_xform_point{};
+struct simd_xform_point4{};
+struct simd_xform_vector{};
+struct simd_xform_normal{};
+struct simd_xform_aabb{};
+
+/// Transform of one block of N elements per operation.
+template <typename isa, int N>
+struct simd_transform_block
+{
+	typedef fvecNSIMD<isa, N> F;
+
+	// Row j of the 4x4 matrix c times (v, 1) for points and (v, 0) for vectors
+	template <bool point>
+	static GLM_SIMD_INLINE F row(F const * c, int j, F const * v)
+	{
+		return fma(c[8 + j], v[2], fma(c[4 + j], v[1], point ? fma(c[j], v[0], c[12 + j]) : c[j] * v[0]));
+	}
+
+	static GLM_SIMD_INLINE void apply(simd_xform_point, F const * c, F const * v, F * r)
+	{
+		r[0] = row<true>(c, 0, v);
+		r[1] = row<true>(c, 1, v);
+		r[2] = row<true>(c, 2, v);
+	}
+
+	static GLM_SIMD_INLINE void apply(simd_xform_vector, F const * c, F const * v, F * r)
+	{
+		r[0] = row<false>(c, 0, v);
+		r[1] = row<false>(c, 1, v);
+		r[2] = row<false>(c, 2, v);
+	}
+
+	static GLM_SIMD_INLINE void apply(simd_xform_normal, F const * c, F const * v, F * r)
+	{
+		F x = row<false>(c, 0, v), y = row<false>(c, 1, v), z = row<false>(c, 2, v);
+		F s = F(1.0f) / sqrt(fma(z, z, fma(y, y, x * x)));
+		r[0] = x * s;
+		r[1] = y * s;
+		r[2] = z * s;
+	}
+
+	static GLM_SIMD_INLINE void apply(simd_xform_point4, F const * c, F const * v, F * r)
+	{
+		r[0] = fma(c[12], v[3], row<false>(c, 0, v));
+		r[1] = fma(c[13], v[3], row<false>(c, 1, v));
+		r[2] = fma(c[14], v[3], row<false>(c, 2, v));
+		r[3] = fma(c[15], v[3], row<false>(c, 3, v));
+	}
+
+	// Center p as a point, half extent e by |mat3(m)|, then widened by 2^-20 of the magnitude
+	// of the terms summed (about 16 units of rounding, more than the few roundings above and
+	// in computing p and e) so that the bounds stay conservative
+	static GLM_SIMD_INLINE void bounds(F const * c, int j, F const * p, F const * e, F & lo, F & hi)
+	{
+		F const slack(1.0f / 1048576.0f);
+		F pc = row<true>(c, j, p);
+		F ec = fma(abs(c[8 + j]), e[2], fma(abs(c[4 + j]), e[1], abs(c[j]) * e[0]));
+		F mag = fma(abs(c[8 + j]), abs(p[2]), fma(abs(c[4 + j]), abs(p[1]), fma(abs(c[j]), abs(p[0]), abs(c[12 + j])))) + ec;
+		ec = fma(mag, slack, ec);
+		lo = pc - ec;
+		hi = pc + ec;
+	}
+
+	template <typename op, typename arrays>
+	static GLM_SIMD_INLINE void run(op o, F const * c, arrays const & a, std::size_t i, std::size_t n)
+	{
+		F v[4], r[4];
+		a.load(i, n, v);
+		apply(o, c, v, r);
+		a.store(i, n, r);
+	}
+
+	template <typename arrays>
+	static GLM_SIMD_INLINE void run(simd_xform_aabb, F const * c, arrays const (& a)[2], std::size_t i, std::size_t n)
+	{
+		F const half(0.5f);
+		F lo[3], hi[3];
+		a[0].load(i, n, lo);
+		a[1].load(i, n, hi);
+		F p[3] = {(lo[0] + hi[0]) * half, (lo[1] + hi[1]) * half, (lo[2] + hi[2]) * half};
+		F e[3] = {(hi[0] - lo[0]) * half, (hi[1] - lo[1]) * half, (hi[2] - lo[2]) * half};
+		bounds(c, 0, p, e, lo[0], hi[0]);
+		bounds(c, 1, p, e, lo[1], hi[1]);
+		bounds(c, 2, p, e, lo[2], hi[2]);
+		a[0].store(i, n, lo);
+		a[1].store(i, n, hi);
+	}
+};
+
+// Elements per block: SoA arrays fill whole registers (16 lanes on AVX-512), AoS arrays
+// go through 8 lane transposes, whose stores a 16 lane register would read back stalled.
+template <typename isa, typename arrays>
+struct simd_transform_lanes{enum{value = simd_reg<isa>::width < 8 ? 8 : simd_reg<isa>::width};};
+template <typename isa, int C>
+struct simd_transform_lanes<isa, simd_aos<C> >{enum{value = 8};};
+template <typename isa, typename arrays>
+struct simd_transform_lanes<isa, arrays[2]> : public simd_transform_lanes<isa, arrays>{};
+
+/// simdDispatch kernel: run(op, matrix, arrays, first, last) transforms elements [first, last).
+template <typename isa>
+struct simd_transform
+{
+	template <typename op, typename arrays>
+	static GLM_SIMD_INLINE void run(op o, float const * m, arrays const & a, std::size_t first, std::size_t last)
+	{
+		enum{N = simd_transform_lanes<isa, arrays>::value};
+		typedef simd_transform_block<isa, N> B;
+		typename B::F c[16];
+		for(int k = 0; k < 16; ++k)
+			c[k] = typename B::F(m[k]);
+		std::size_t i = first;
+		for(; i + N <= last; i += N)
+			B::run(o, c, a, i, std::size_t(N));
+		if(i < last)
+			B::run(o, c, a, i, last - i);
+	}
+};
+
+// Runs fn(first, last) over [0, count), on several threads for large counts. The chunks are
+// multiples of 16 elements so that only the last one has a short block.
+template <typename function>
+inline void simd_transform_parallel(std::size_t count, function fn)
+{
+	std::size_t const minChunk = std::size_t(1) << 15;
+	if(count < 2 * minChunk)
+	{
+		fn(std::size_t(0), count);
+		return;
+	}
+	static std::size_t const cores = std::max(1u, std::thread::hardware_concurrency());
+	std::size_t threads = std::min(cores, count / minChunk);
+	if(threads == 1)
+	{
+		fn(std::size_t(0), count);
+		return;
+	}
+	std::size_t chunk = (count / threads + 15) & ~std::size_t(15);
+	std::vector<std::thread> pool;
+	for(std::size_t first = chunk; first < count; first += chunk)
+		pool.push_back(std::thread(fn, first, std::min(first + chunk, count)));
+	fn(std::size_t(0), std::min(chunk, count));
+	for(std::size_t k = 0; k < pool.size(); ++k)
+		pool[k].join();
+}
+
+template <typename op, typename arrays>
+inline void simd_transform_run(op o, mat4 const & m, arrays const & a, std::size_t count)
+{
+	float const * p = &m[0][0];
+	simd_transform_parallel(count, [&](std::size_t first, std::size_t last)
+	{
+		simdDispatch<simd_transform>(o, p, a, first, last);
+	});
+}
+
+template <int C>
+inline simd_aos<C> simd_make_aos(void const * in, void * out, std::size_t stride)
+{
+	simd_aos<C> a = {static_cast<char const *>(in), static_cast<char *>(out), stride};
+	return a;
+}
+
+inline simd_soa3 simd_make_soa3(float const * x, float const * y, float const * z, float * ox, float * oy, float * oz)
+{
+	simd_soa3 a = {{x, y, z}, {ox, oy, oz}};
+	return a;
+}
+
+inline mat4 simd_normal_matrix(mat4 const & m)
+{
+	return mat4(transpose(inverse(mat3(m))));
+}
+
+}//namespace detail
+
+inline void transformPoints(mat4 const & m, vec3 const * in, std::size_t count, vec3 * out, std::size_t stride)
+{
+	detail::simd_transform_run(detail::simd_xform_point(), m, detail::simd_make_aos<3>(in, out, stride), count);
+}
+
+inline void transformPoints(mat4 const & m, vec4 const * in, std::size_t count, vec4 * out, std::size_t stride)
+{
+	detail::simd_transform_run(detail::simd_xform_point4(), m, detail::simd_make_aos<4>(in, out, stride), count);
+}
+
+inline void transformVectors(mat4 const & m, vec3 const * in, std::size_t count, vec3 * out, std::size_t stride)
+{
+	detail::simd_transform_run(detail::simd_xform_vector(), m, detail::simd_make_aos<3>(in, out, stride), count);
+}
+
+inline void transformNormals(mat4 const & m, vec3 const * in, std::size_t count, vec3 * out, std::size_t stride)
+{
+	detail::simd_transform_run(detail::simd_xform_normal(), detail::simd_normal_matrix(m), detail::simd_make_aos<3>(in, out, stride), count);
+}
+
+inline void transformAABBs(mat4 const & m, vec3 const * lo, vec3 const * hi, std::size_t count, vec3 * outLo, vec3 * outHi, std::size_t stride)
+{
+	detail::simd_aos<3> const a[2] = {detail::simd_make_aos<3>(lo, outLo, stride), detail::simd_make_aos<3>(hi, outHi, stride)};
+	detail::simd_transform_run(detail::simd_xform_aabb(), m, a, count);
+}
+
+inline void transformPoints(mat4 const & m, float const * x, float const * y, float const * z, std::size_t count, float * ox, float * oy, float * oz)
+{
+	detail::simd_transform_run(detail::simd_xform_point(), m, detail::simd_make_soa3(x, y, z, ox, oy, oz), count);
+}
+
+inline void transformVectors(mat4 const & m, float const * x, float const * y, float const * z, std::size_t count, float * ox, float * oy, float * oz)
+{
+	detail::simd_transform_run(detail::simd_xform_vector(), m, detail::simd_make_soa3(x, y, z, ox, oy, oz), count);
+}
+
+inline void transformNormals(mat4 const & m, float const * x, float const * y, float const * z, std::size_t count, float * ox, float * oy, float * oz)
+{
+	detail::simd_transform_run(detail::simd_xform_normal(), detail::simd_normal_matrix(m), detail::simd_make_soa3(x, y, z, ox, oy, oz), count);
+}
+
+}//namespace glm
@@ -0,0 +1,318 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// OpenGL Mathematics (glm.g-truc.net)
+///
+/// Copyright (c) 2005 - 2014 G-Truc Creation (www.g-truc.net)
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+/// @ref gtx_simd_wide
+/// @file glm/gtx/simd_wide.hpp
+/// @date 2026-10-17 / 2026-10-17
+///
+/// @see core (dependence)
+/// @see gtx_simd_vec4
+///
+/// @defgroup gtx_simd_wide GLM_GTX_simd_wide
+/// @ingroup gtx
+///
+/// @brief 8- and 16-wide float vectors and masks with runtime dispatch to SSE2, AVX2 or AVX-512.
+///
+/// Unlike fvec4SIMD (one vec4 per register), these hold one float per lane and are meant
+/// for batch kernels: N rays, N spheres, N planes at a time.
+///
+/// The instruction set is a template parameter (simdSSE2, simdAVX2, simdAVX512) rather
+/// than a compile-time switch. Values are stored as aligned float arrays, so the same
+/// object can be handed between code compiled for different instruction sets; each
+/// operation loads, computes with the widest registers of its instruction set and stores,
+/// and the loads and stores disappear once a kernel is inlined.
+///
+/// Kernels are written once as a class template over the instruction set and run with
+/// simdDispatch<Kernel>(args...), which picks the best level the CPU and OS support.
+/// On GCC and Clang the AVX2 and AVX-512 entry points are compiled with the matching
+/// target attribute and flatten, so no -mavx2 flag is needed for the translation unit.
+///
+/// Requires C++11 (alias and variadic templates).
+/// <glm/gtx/simd_wide.hpp> need to be included to use these functionalities.
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef GLM_GTX_simd_wide
+#define GLM_GTX_simd_wide
+
+// Dependency:
+#include "../glm.hpp"
+#include <cstring>
+#include <utility>
+
+#if(GLM_ARCH != GLM_ARCH_PURE)
+
+#if(GLM_ARCH & GLM_ARCH_SSE2)
+#	include <immintrin.h>
+#	if(GLM_COMPILER & GLM_COMPILER_VC)
+#		include <intrin.h>
+#	else
+#		include <cpuid.h>
+#	endif
+#else
+#	error "GLM: GLM_GTX_simd_wide requires compiler support of SSE2 through intrinsics"
+#endif
+
+#if(defined(GLM_MESSAGES) && !defined(GLM_EXT_INCLUDED))
+#	pragma message("GLM: GLM_GTX_simd_wide extension included")
+#endif
+
+// Functions using AVX2 / AVX-512 registers carry a target attribute on GCC and Clang.
+// MSVC accepts the intrinsics anywhere and needs nothing.
+#if(GLM_COMPILER & GLM_COMPILER_VC)
+#	define GLM_SIMD_TARGET_AVX2
+#	define GLM_SIMD_TARGET_AVX512
+#	define GLM_SIMD_FLATTEN
+#	define GLM_SIMD_INLINE __forceinline
+#else
+#	define GLM_SIMD_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#	define GLM_SIMD_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma,f16c")))
+#	define GLM_SIMD_FLATTEN __attribute__((flatten))
+#	define GLM_SIMD_INLINE inline
+#endif
+
+namespace glm{
+namespace detail
+{
+	/// Instruction set tags.
+	/// \ingroup gtx_simd_wide
+	struct simd_sse2{};
+	struct simd_avx2{};
+	struct simd_avx512{};
+
+	/// Register level operations on native registers, one specialization per instruction set.
+	template <typename isa>
+	struct simd_reg;
+
+	/// Operations on N floats in memory; picks the widest register of isa that fits N.
+	template <typename isa, int N>
+	struct simd_ops;
+
+	/// N-wide float vector (N = 4, 8 or 16).
+	/// \ingroup gtx_simd_wide
+	template <typename isa, int N>
+	struct fvecNSIMD
+	{
+		typedef float value_type;
+		typedef isa isa_type;
+		enum{size = N};
+
+		alignas(64) float Data[N];
+
+		//////////////////////////////////////
+		// Constructors (uninitialized by default)
+
+		fvecNSIMD(){}
+		explicit fvecNSIMD(float const & s);
+		/// Unaligned load of N floats.
+		explicit fvecNSIMD(float const * p);
+
+		void store(float * p) const;
+		float operator[](int i) const{return Data[i];}
+		float & operator[](int i){return Data[i];}
+
+		//////////////////////////////////////
+		// Unary arithmetic operators
+
+		fvecNSIMD & operator+=(fvecNSIMD const & v);
+		fvecNSIMD & operator-=(fvecNSIMD const & v);
+		fvecNSIMD & operator*=(fvecNSIMD const & v);
+		fvecNSIMD & operator/=(fvecNSIMD const & v);
+	};
+
+	/// N-wide lane mask, each lane all ones (true) or all zeros (false).
+	/// \ingroup gtx_simd_wide
+	template <typename isa, int N>
+	struct bvecNSIMD
+	{
+		typedef isa isa_type;
+		enum{size = N};
+
+		alignas(64) int Data[N];
+
+		bvecNSIMD(){}
+		explicit bvecNSIMD(bool b);
+
+		bool operator[](int i) const{return Data[i] != 0;}
+	};
+
+	template <typename isa> using fvec8SIMD = fvecNSIMD<isa, 8>;
+	template <typename isa> using fvec16SIMD = fvecNSIMD<isa, 16>;
+	template <typename isa> using bvec8SIMD = bvecNSIMD<isa, 8>;
+	template <typename isa> using bvec16SIMD = bvecNSIMD<isa, 16>;
+
+	//////////////////////////////////////
+	// Binary operators
+
+	template <typename isa, int N> fvecNSIMD<isa, N> operator+(fvecNSIMD<isa, N> const & a, fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> fvecNSIMD<isa, N> operator-(fvecNSIMD<isa, N> const & a, fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> fvecNSIMD<isa, N> operator*(fvecNSIMD<isa, N> const & a, fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> fvecNSIMD<isa, N> operator/(fvecNSIMD<isa, N> const & a, fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> fvecNSIMD<isa, N> operator+(fvecNSIMD<isa, N> const & a, float b);
+	template <typename isa, int N> fvecNSIMD<isa, N> operator-(fvecNSIMD<isa, N> const & a, float b);
+	template <typename isa, int N> fvecNSIMD<isa, N> operator*(fvecNSIMD<isa, N> const & a, float b);
+	template <typename isa, int N> fvecNSIMD<isa, N> operator/(fvecNSIMD<isa, N> const & a, float b);
+	template <typename isa, int N> fvecNSIMD<isa, N> operator+(float a, fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> fvecNSIMD<isa, N> operator-(float a, fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> fvecNSIMD<isa, N> operator*(float a, fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> fvecNSIMD<isa, N> operator/(float a, fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> fvecNSIMD<isa, N> operator-(fvecNSIMD<isa, N> const & a);
+
+	//////////////////////////////////////
+	// Comparison operators, returning lane masks
+
+	template <typename isa, int N> bvecNSIMD<isa, N> operator<(fvecNSIMD<isa, N> const & a, fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> bvecNSIMD<isa, N> operator<=(fvecNSIMD<isa, N> const & a, fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> bvecNSIMD<isa, N> operator>(fvecNSIMD<isa, N> const & a, fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> bvecNSIMD<isa, N> operator>=(fvecNSIMD<isa, N> const & a, fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> bvecNSIMD<isa, N> operator==(fvecNSIMD<isa, N> const & a, fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> bvecNSIMD<isa, N> operator!=(fvecNSIMD<isa, N> const & a, fvecNSIMD<isa, N> const & b);
+
+	//////////////////////////////////////
+	// Mask operators
+
+	template <typename isa, int N> bvecNSIMD<isa, N> operator&(bvecNSIMD<isa, N> const & a, bvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> bvecNSIMD<isa, N> operator|(bvecNSIMD<isa, N> const & a, bvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> bvecNSIMD<isa, N> operator^(bvecNSIMD<isa, N> const & a, bvecNSIMD<isa, N> const & b);
+	template <typename isa, int N> bvecNSIMD<isa, N> operator~(bvecNSIMD<isa, N> const & a);
+}//namespace detail
+
+	typedef detail::simd_sse2 simdSSE2;
+	typedef detail::simd_avx2 simdAVX2;
+	typedef detail::simd_avx512 simdAVX512;
+
+	/// Instruction set of the translation unit's compile flags (used by the simdVec typedefs).
+#if defined(__AVX512F__)
+	typedef simdAVX512 simdNative;
+#elif(GLM_ARCH & GLM_ARCH_AVX2)
+	typedef simdAVX2 simdNative;
+#else
+	typedef simdSSE2 simdNative;
+#endif
+
+	typedef detail::fvecNSIMD<simdNative, 8> simdVec8;
+	typedef detail::fvecNSIMD<simdNative, 16> simdVec16;
+	typedef detail::bvecNSIMD<simdNative, 8> simdBVec8;
+	typedef detail::bvecNSIMD<simdNative, 16> simdBVec16;
+
+	/// @addtogroup gtx_simd_wide
+	/// @{
+
+	/// Instruction set levels, in increasing order.
+	enum simdLevel
+	{
+		SIMD_SSE2 = 0,
+		SIMD_AVX2 = 1,     //!< AVX2, FMA and F16C
+		SIMD_AVX512 = 2    //!< AVX-512F
+	};
+
+	//! Highest level supported by both the CPU and the OS (cpuid and xgetbv), detected once.
+	/// @see gtx_simd_wide
+	simdLevel simdCpuLevel();
+
+	//! Level used by simdDispatch: simdCpuLevel() unless lowered with simdSetLevel().
+	/// @see gtx_simd_wide
+	simdLevel simdActiveLevel();
+
+	//! Limits simdDispatch to at most level (clamped to the CPU level), e.g. for comparisons.
+	//! Not synchronized with running kernels; set it before dispatching.
+	/// @see gtx_simd_wide
+	void simdSetLevel(simdLevel level);
+
+	//! Name of a level ("sse2", "avx2", "avx512").
+	/// @see gtx_simd_wide
+	char const * simdLevelName(simdLevel level);
+
+	//! Runs kernel<isa>::run(args...) for the active level and returns its result.
+	/// @see gtx_simd_wide
+	template <template <typename> class kernel, typename... args>
+	auto simdDispatch(args &&... a) -> decltype(kernel<simdSSE2>::run(std::forward<args>(a)...));
+
+	//! Lane-wise minimum / maximum.
+	/// @see gtx_simd_wide
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> min(detail::fvecNSIMD<isa, N> const & a, detail::fvecNSIMD<isa, N> const & b);
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> max(detail::fvecNSIMD<isa, N> const & a, detail::fvecNSIMD<isa, N> const & b);
+
+	//! a * b + c, fused (single rounding) on AVX2 and AVX-512, separate multiply and add on SSE2.
+	/// @see gtx_simd_wide
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> fma(detail::fvecNSIMD<isa, N> const & a, detail::fvecNSIMD<isa, N> const & b, detail::fvecNSIMD<isa, N> const & c);
+
+	//! Lane-wise square root (correctly rounded).
+	/// @see gtx_simd_wide
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> sqrt(detail::fvecNSIMD<isa, N> const & x);
+
+	//! 1 / sqrt(x): hardware estimate refined by one Newton-Raphson step
+	//! (relative error below 2^-21 on SSE2/AVX2, 2^-23 on AVX-512); rsqrt(0) is +inf.
+	/// @see gtx_simd_wide
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> rsqrt(detail::fvecNSIMD<isa, N> const & x);
+
+	//! Lane-wise absolute value.
+	/// @see gtx_simd_wide
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> abs(detail::fvecNSIMD<isa, N> const & x);
+
+	//! Nearest integer, ties to even.
+	/// @see gtx_simd_wide
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> roundEven(detail::fvecNSIMD<isa, N> const & x);
+
+	//! Splits x into a mantissa in [0.5, 1) with the sign of x and an integral exponent
+	//! (as a float) so that x = mantissa * 2^exp. Denormals are handled; 0, inf and NaN
+	//! return x with exp = 0.
+	/// @see gtx_simd_wide
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> frexp(detail::fvecNSIMD<isa, N> const & x, detail::fvecNSIMD<isa, N> & exp);
+
+	//! x * 2^exp for integral exp with |exp| <= 252.
+	/// @see gtx_simd_wide
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> ldexp(detail::fvecNSIMD<isa, N> const & x, detail::fvecNSIMD<isa, N> const & exp);
+
+	//! Lanes of a where mask is set, otherwise lanes of b.
+	/// @see gtx_simd_wide
+	template <typename isa, int N>
+	detail::fvecNSIMD<isa, N> select(detail::bvecNSIMD<isa, N> const & mask, detail::fvecNSIMD<isa, N> const & a, detail::fvecNSIMD<isa, N> const & b);
+
+	//! One bit per lane (bit i = lane i).
+	/// @see gtx_simd_wide
+	template <typename isa, int N>
+	unsigned int bitmask(detail::bvecNSIMD<isa, N> const & mask);
+
+	//! True if any / all lanes are set.
+	/// @see gtx_simd_wide
+	template <typename isa, int N>
+	bool any(detail::bvecNSIMD<isa, N> const & mask);
+	template <typename isa, int N>
+	bool all(detail::bvecNSIMD<isa, N> const & mask);
+
+	/// @}
+}//namespace glm
+
+#include "simd_wide.inl"
+
+#endif//(GLM_ARCH != GLM_ARCH_PURE)
+
+#endif//GLM_GTX_simd_wide
@@ -0,0 +1,602 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// OpenGL Mathematics Copyright (c) 2005 - 2014 G-Truc Creation (www.g-truc.net)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Created : 2026-10-17
+// Updated : 2026-10-17
+// Licence : This source is under MIT License
+// File    : glm/gtx/simd_wide.inl
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// GCC 12 reports the deliberately undefined source operand of the AVX-512 intrinsics
+// (_mm512_undefined_ps) once they are inlined into a kernel.
+#if(GLM_COMPILER & GLM_COMPILER_GCC)
+#	pragma GCC diagnostic push
+#	pragma GCC diagnostic ignored "-Wuninitialized"
+#	pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace glm{
+namespace detail{
+
+//////////////////////////////////////
+// Registers
+
+template <>
+struct simd_reg<simd_sse2>
+{
+	typedef __m128 type;
+	enum{width = 4};
+
+	static GLM_SIMD_INLINE type load(float const * p){return _mm_loadu_ps(p);}
+	static GLM_SIMD_INLINE void store(float * p, type v){_mm_storeu_ps(p, v);}
+	static GLM_SIMD_INLINE type set1(float s){return _mm_set1_ps(s);}
+	static GLM_SIMD_INLINE type add(type a, type b){return _mm_add_ps(a, b);}
+	static GLM_SIMD_INLINE type sub(type a, type b){return _mm_sub_ps(a, b);}
+	static GLM_SIMD_INLINE type mul(type a, type b){return _mm_mul_ps(a, b);}
+	static GLM_SIMD_INLINE type div(type a, type b){return _mm_div_ps(a, b);}
+	static GLM_SIMD_INLINE type min(type a, type b){return _mm_min_ps(a, b);}
+	static GLM_SIMD_INLINE type max(type a, type b){return _mm_max_ps(a, b);}
+	static GLM_SIMD_INLINE type fma(type a, type b, type c){return _mm_add_ps(_mm_mul_ps(a, b), c);}
+	static GLM_SIMD_INLINE type sqrt(type a){return _mm_sqrt_ps(a);}
+	static GLM_SIMD_INLINE type rsqrt_estimate(type a){return _mm_rsqrt_ps(a);}
+	// Current rounding mode (nearest even by default); |a| >= 2^23, inf and NaN are already integral
+	static GLM_SIMD_INLINE type roundeven(type a)
+	{
+		type r = _mm_cvtepi32_ps(_mm_cvtps_epi32(a));
+		type big = _mm_cmpnlt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), a), _mm_set1_ps(8388608.0f));
+		return _mm_or_ps(blend(big, a, r), _mm_and_ps(a, _mm_set1_ps(-0.0f)));
+	}
+	// 2^a for integral a in [-126, 127]
+	static GLM_SIMD_INLINE type pow2i(type a){return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(a), _mm_set1_epi32(127)), 23));}
+	// Biased exponent field, as a float
+	static GLM_SIMD_INLINE type exponent(type a){return _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_mm_castps_si128(a), 23), _mm_set1_epi32(0xff)));}
+	static GLM_SIMD_INLINE type and_(type a, type b){return _mm_and_ps(a, b);}
+	static GLM_SIMD_INLINE type or_(type a, type b){return _mm_or_ps(a, b);}
+	static GLM_SIMD_INLINE type xor_(type a, type b){return _mm_xor_ps(a, b);}
+	static GLM_SIMD_INLINE type andnot(type a, type b){return _mm_andnot_ps(a, b);}
+	// mask ? a : b
+	static GLM_SIMD_INLINE type blend(type m, type a, type b){return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));}
+	static GLM_SIMD_INLINE unsigned int movemask(type m){return unsigned(_mm_movemask_ps(m));}
+	template <int P>
+	static GLM_SIMD_INLINE type cmp(type a, type b)
+	{
+		return P == _CMP_LT_OQ ? _mm_cmplt_ps(a, b) :
+			P == _CMP_LE_OQ ? _mm_cmple_ps(a, b) :
+			P == _CMP_GT_OQ ? _mm_cmpgt_ps(a, b) :
+			P == _CMP_GE_OQ ? _mm_cmpge_ps(a, b) :
+			P == _CMP_EQ_OQ ? _mm_cmpeq_ps(a, b) : _mm_cmpneq_ps(a, b);
+	}
+};
+
+template <>
+struct simd_reg<simd_avx2>
+{
+	typedef __m256 type;
+	enum{width = 8};
+
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type load(float const * p){return _mm256_loadu_ps(p);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE void store(float * p, type v){_mm256_storeu_ps(p, v);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type set1(float s){return _mm256_set1_ps(s);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type add(type a, type b){return _mm256_add_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type sub(type a, type b){return _mm256_sub_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type mul(type a, type b){return _mm256_mul_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type div(type a, type b){return _mm256_div_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type min(type a, type b){return _mm256_min_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type max(type a, type b){return _mm256_max_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type fma(type a, type b, type c){return _mm256_fmadd_ps(a, b, c);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type sqrt(type a){return _mm256_sqrt_ps(a);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type rsqrt_estimate(type a){return _mm256_rsqrt_ps(a);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type roundeven(type a){return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type pow2i(type a){return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(a), _mm256_set1_epi32(127)), 23));}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type exponent(type a){return _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(_mm256_castps_si256(a), 23), _mm256_set1_epi32(0xff)));}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type and_(type a, type b){return _mm256_and_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type or_(type a, type b){return _mm256_or_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type xor_(type a, type b){return _mm256_xor_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type andnot(type a, type b){return _mm256_andnot_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type blend(type m, type a, type b){return _mm256_blendv_ps(b, a, m);}
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE unsigned int movemask(type m){return unsigned(_mm256_movemask_ps(m));}
+	template <int P>
+	static GLM_SIMD_TARGET_AVX2 GLM_SIMD_INLINE type cmp(type a, type b){return _mm256_cmp_ps(a, b, P);}
+};
+
+template <>
+struct simd_reg<simd_avx512>
+{
+	typedef __m512 type;
+	enum{width = 16};
+
+	// Lane masks are kept as all-ones lanes like the other levels; __mmask16 only inside an operation.
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE __mmask16 lanes(type m){return _mm512_test_epi32_mask(_mm512_castps_si512(m), _mm512_castps_si512(m));}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type expand(__mmask16 k){return _mm512_castsi512_ps(_mm512_maskz_set1_epi32(k, -1));}
+
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type load(float const * p){return _mm512_loadu_ps(p);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE void store(float * p, type v){_mm512_storeu_ps(p, v);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type set1(float s){return _mm512_set1_ps(s);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type add(type a, type b){return _mm512_add_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type sub(type a, type b){return _mm512_sub_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type mul(type a, type b){return _mm512_mul_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type div(type a, type b){return _mm512_div_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type min(type a, type b){return _mm512_min_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type max(type a, type b){return _mm512_max_ps(a, b);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type fma(type a, type b, type c){return _mm512_fmadd_ps(a, b, c);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type sqrt(type a){return _mm512_sqrt_ps(a);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type rsqrt_estimate(type a){return _mm512_rsqrt14_ps(a);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type roundeven(type a){return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type pow2i(type a){return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(_mm512_cvtps_epi32(a), _mm512_set1_epi32(127)), 23));}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type exponent(type a){return _mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(_mm512_castps_si512(a), 23), _mm512_set1_epi32(0xff)));}
+	// Bitwise float operations need AVX-512DQ, so go through the integer forms (AVX-512F)
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type and_(type a, type b){return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type or_(type a, type b){return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type xor_(type a, type b){return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type andnot(type a, type b){return _mm512_castsi512_ps(_mm512_andnot_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type blend(type m, type a, type b){return _mm512_mask_blend_ps(lanes(m), b, a);}
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE unsigned int movemask(type m){return unsigned(lanes(m));}
+	template <int P>
+	static GLM_SIMD_TARGET_AVX512 GLM_SIMD_INLINE type cmp(type a, type b){return expand(_mm512_cmp_ps_mask(a, b, P));}
+};
+
+// 8 lanes on AVX-512 use the AVX2 registers, 4 lanes use SSE registers everywhere
+template <typename isa, int N>
+struct simd_pick{typedef isa type;};
+template <typename isa>
+struct simd_pick<isa, 4>{typedef simd_sse2 type;};
+template <>
+struct simd_pick<simd_avx512, 8>{typedef simd_avx2 type;};
+
+//////////////////////////////////////
+// Operations on N floats, stamped out per instruction set so that each carries its target attribute.
+// The loops are unrolled so that, once inlined, the intermediate arrays stay in registers.
+
+#if(GLM_COMPILER & GLM_COMPILER_VC)
+#	define GLM_SIMD_UNROLL
+#else
+#	define GLM_SIMD_UNROLL _Pragma("GCC unroll 4")
+#endif
+
+inline float simd_float_bits(unsigned int u)
+{
+	float f;
+	std::memcpy(&f, &u, sizeof(f));
+	return f;
+}
+
+// frexp scales denormals by 2^24 first and leaves 0, inf and NaN with a zero exponent.
+// ldexp splits the exponent in two halves so that |e| up to 252 stays in the range of pow2i.
+#define GLM_SIMD_OPS(ISA, TARGET) \
+template <int N> \
+struct simd_ops<ISA, N> \
+{ \
+	typedef simd_reg<typename simd_pick<ISA, N>::type> R; \
+	static TARGET GLM_SIMD_INLINE void copy(float const * a, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::load(a + i));} \
+	static TARGET GLM_SIMD_INLINE void set1(float s, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::set1(s));} \
+	static TARGET GLM_SIMD_INLINE void add(float const * a, float const * b, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::add(R::load(a + i), R::load(b + i)));} \
+	static TARGET GLM_SIMD_INLINE void sub(float const * a, float const * b, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::sub(R::load(a + i), R::load(b + i)));} \
+	static TARGET GLM_SIMD_INLINE void mul(float const * a, float const * b, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::mul(R::load(a + i), R::load(b + i)));} \
+	static TARGET GLM_SIMD_INLINE void div(float const * a, float const * b, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::div(R::load(a + i), R::load(b + i)));} \
+	static TARGET GLM_SIMD_INLINE void min(float const * a, float const * b, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::min(R::load(a + i), R::load(b + i)));} \
+	static TARGET GLM_SIMD_INLINE void max(float const * a, float const * b, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::max(R::load(a + i), R::load(b + i)));} \
+	static TARGET GLM_SIMD_INLINE void fma(float const * a, float const * b, float const * c, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::fma(R::load(a + i), R::load(b + i), R::load(c + i)));} \
+	static TARGET GLM_SIMD_INLINE void sqrt(float const * a, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::sqrt(R::load(a + i)));} \
+	static TARGET GLM_SIMD_INLINE void rsqrt(float const * a, float * r) \
+	{ \
+		GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) \
+		{ \
+			typename R::type x = R::load(a + i), y = R::rsqrt_estimate(x); \
+			typename R::type yy = R::mul(R::mul(y, y), R::mul(x, R::set1(-0.5f))); \
+			typename R::type refined = R::mul(y, R::add(yy, R::set1(1.5f))); \
+			R::store(r + i, R::blend(R::template cmp<_CMP_EQ_OQ>(x, R::set1(0.0f)), y, refined)); \
+		} \
+	} \
+	static TARGET GLM_SIMD_INLINE void roundeven(float const * a, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::roundeven(R::load(a + i)));} \
+	static TARGET GLM_SIMD_INLINE void ldexp(float const * a, float const * e, float * r) \
+	{ \
+		GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) \
+		{ \
+			typename R::type x = R::load(e + i), e1 = R::roundeven(R::mul(x, R::set1(0.5f))); \
+			R::store(r + i, R::mul(R::mul(R::load(a + i), R::pow2i(e1)), R::pow2i(R::sub(x, e1)))); \
+		} \
+	} \
+	static TARGET GLM_SIMD_INLINE void frexp(float const * a, float * m, float * e) \
+	{ \
+		GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) \
+		{ \
+			typename R::type x = R::load(a + i), ax = R::andnot(R::set1(-0.0f), x); \
+			typename R::type tiny = R::template cmp<_CMP_LT_OQ>(ax, R::set1(1.17549435e-38f)); \
+			typename R::type xs = R::blend(tiny, R::mul(x, R::set1(16777216.0f)), x); \
+			typename R::type ex = R::sub(R::exponent(xs), R::blend(tiny, R::set1(150.0f), R::set1(126.0f))); \
+			typename R::type mant = R::or_(R::and_(xs, R::set1(simd_float_bits(0x807fffffu))), R::set1(0.5f)); \
+			typename R::type ok = R::and_(R::template cmp<_CMP_GT_OQ>(ax, R::set1(0.0f)), R::template cmp<_CMP_LE_OQ>(ax, R::set1(3.40282347e+38f))); \
+			R::store(m + i, R::blend(ok, mant, x)); \
+			R::store(e + i, R::and_(ok, ex)); \
+		} \
+	} \
+	static TARGET GLM_SIMD_INLINE void abs(float const * a, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::andnot(R::set1(-0.0f), R::load(a + i)));} \
+	static TARGET GLM_SIMD_INLINE void neg(float const * a, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::xor_(R::set1(-0.0f), R::load(a + i)));} \
+	template <int P> \
+	static TARGET GLM_SIMD_INLINE void cmp(float const * a, float const * b, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::template cmp<P>(R::load(a + i), R::load(b + i)));} \
+	static TARGET GLM_SIMD_INLINE void and_(float const * a, float const * b, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::and_(R::load(a + i), R::load(b + i)));} \
+	static TARGET GLM_SIMD_INLINE void or_(float const * a, float const * b, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::or_(R::load(a + i), R::load(b + i)));} \
+	static TARGET GLM_SIMD_INLINE void xor_(float const * a, float const * b, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::xor_(R::load(a + i), R::load(b + i)));} \
+	static TARGET GLM_SIMD_INLINE void not_(float const * a, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::andnot(R::load(a + i), R::template cmp<_CMP_EQ_OQ>(R::set1(0.0f), R::set1(0.0f))));} \
+	static TARGET GLM_SIMD_INLINE void blend(float const * m, float const * a, float const * b, float * r){GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) R::store(r + i, R::blend(R::load(m + i), R::load(a + i), R::load(b + i)));} \
+	static TARGET GLM_SIMD_INLINE unsigned int movemask(float const * m) \
+	{ \
+		unsigned int bits = 0; \
+		GLM_SIMD_UNROLL for(int i = 0; i < N; i += R::width) \
+			bits |= R::movemask(R::load(m + i)) << i; \
+		return bits; \
+	} \
+};
+
+GLM_SIMD_OPS(simd_sse2, )
+GLM_SIMD_OPS(simd_avx2, GLM_SIMD_TARGET_AVX2)
+GLM_SIMD_OPS(simd_avx512, GLM_SIMD_TARGET_AVX512)
+
+#undef GLM_SIMD_OPS
+#undef GLM_SIMD_UNROLL
+
+template <typename isa, int N>
+GLM_SIMD_INLINE float const * simd_bits(bvecNSIMD<isa, N> const & m){return reinterpret_cast<float const *>(m.Data);}
+template <typename isa, int N>
+GLM_SIMD_INLINE float * simd_bits(bvecNSIMD<isa, N> & m){return reinterpret_cast<float *>(m.Data);}
+
+//////////////////////////////////////
+// Constructors and members
+
+template <typename isa, int N>
+GLM_SIMD_INLINE fvecNSIMD<isa, N>::fvecNSIMD(float const & s)
+{
+	simd_ops<isa, N>::set1(s, Data);
+}
+
+// Register loads and stores rather than memcpy, which GCC splits into 16 byte moves
+// for AVX2 and then stalls reading them back as one register.
+template <typename isa, int N>
+GLM_SIMD_INLINE fvecNSIMD<isa, N>::fvecNSIMD(float const * p)
+{
+	simd_ops<isa, N>::copy(p, Data);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE void fvecNSIMD<isa, N>::store(float * p) const
+{
+	simd_ops<isa, N>::copy(Data, p);
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE fvecNSIMD<isa, N> & fvecNSIMD<isa, N>::operator+=(fvecNSIMD const & v)
+{
+	simd_ops<isa, N>::add(Data, v.Data, Data);
+	return *this;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE fvecNSIMD<isa, N> & fvecNSIMD<isa, N>::operator-=(fvecNSIMD const & v)
+{
+	simd_ops<isa, N>::sub(Data, v.Data, Data);
+	return *this;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE fvecNSIMD<isa, N> & fvecNSIMD<isa, N>::operator*=(fvecNSIMD const & v)
+{
+	simd_ops<isa, N>::mul(Data, v.Data, Data);
+	return *this;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE fvecNSIMD<isa, N> & fvecNSIMD<isa, N>::operator/=(fvecNSIMD const & v)
+{
+	simd_ops<isa, N>::div(Data, v.Data, Data);
+	return *this;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE bvecNSIMD<isa, N>::bvecNSIMD(bool b)
+{
+	for(int i = 0; i < N; ++i)
+		Data[i] = b ? -1 : 0;
+}
+
+//////////////////////////////////////
+// Binary operators
+
+#define GLM_SIMD_BINARY(OP, FN) \
+template <typename isa, int N> \
+GLM_SIMD_INLINE fvecNSIMD<isa, N> operator OP(fvecNSIMD<isa, N> const & a, fvecNSIMD<isa, N> const & b) \
+{ \
+	fvecNSIMD<isa, N> r; \
+	simd_ops<isa, N>::FN(a.Data, b.Data, r.Data); \
+	return r; \
+} \
+template <typename isa, int N> \
+GLM_SIMD_INLINE fvecNSIMD<isa, N> operator OP(fvecNSIMD<isa, N> const & a, float b) \
+{ \
+	return a OP fvecNSIMD<isa, N>(b); \
+} \
+template <typename isa, int N> \
+GLM_SIMD_INLINE fvecNSIMD<isa, N> operator OP(float a, fvecNSIMD<isa, N> const & b) \
+{ \
+	return fvecNSIMD<isa, N>(a) OP b; \
+}
+
+GLM_SIMD_BINARY(+, add)
+GLM_SIMD_BINARY(-, sub)
+GLM_SIMD_BINARY(*, mul)
+GLM_SIMD_BINARY(/, div)
+
+#undef GLM_SIMD_BINARY
+
+template <typename isa, int N>
+GLM_SIMD_INLINE fvecNSIMD<isa, N> operator-(fvecNSIMD<isa, N> const & a)
+{
+	fvecNSIMD<isa, N> r;
+	simd_ops<isa, N>::neg(a.Data, r.Data);
+	return r;
+}
+
+//////////////////////////////////////
+// Comparison operators
+
+#define GLM_SIMD_COMPARE(OP, PREDICATE) \
+template <typename isa, int N> \
+GLM_SIMD_INLINE bvecNSIMD<isa, N> operator OP(fvecNSIMD<isa, N> const & a, fvecNSIMD<isa, N> const & b) \
+{ \
+	bvecNSIMD<isa, N> r; \
+	simd_ops<isa, N>::template cmp<PREDICATE>(a.Data, b.Data, simd_bits(r)); \
+	return r; \
+}
+
+GLM_SIMD_COMPARE(<, _CMP_LT_OQ)
+GLM_SIMD_COMPARE(<=, _CMP_LE_OQ)
+GLM_SIMD_COMPARE(>, _CMP_GT_OQ)
+GLM_SIMD_COMPARE(>=, _CMP_GE_OQ)
+GLM_SIMD_COMPARE(==, _CMP_EQ_OQ)
+GLM_SIMD_COMPARE(!=, _CMP_NEQ_UQ)
+
+#undef GLM_SIMD_COMPARE
+
+//////////////////////////////////////
+// Mask operators
+
+#define GLM_SIMD_MASK(OP, FN) \
+template <typename isa, int N> \
+GLM_SIMD_INLINE bvecNSIMD<isa, N> operator OP(bvecNSIMD<isa, N> const & a, bvecNSIMD<isa, N> const & b) \
+{ \
+	bvecNSIMD<isa, N> r; \
+	simd_ops<isa, N>::FN(simd_bits(a), simd_bits(b), simd_bits(r)); \
+	return r; \
+}
+
+GLM_SIMD_MASK(&, and_)
+GLM_SIMD_MASK(|, or_)
+GLM_SIMD_MASK(^, xor_)
+
+#undef GLM_SIMD_MASK
+
+template <typename isa, int N>
+GLM_SIMD_INLINE bvecNSIMD<isa, N> operator~(bvecNSIMD<isa, N> const & a)
+{
+	bvecNSIMD<isa, N> r;
+	simd_ops<isa, N>::not_(simd_bits(a), simd_bits(r));
+	return r;
+}
+
+//////////////////////////////////////
+// Dispatch
+
+inline void simd_cpuid(int regs[4], int leaf, int subleaf)
+{
+#	if(GLM_COMPILER & GLM_COMPILER_VC)
+		__cpuidex(regs, leaf, subleaf);
+#	else
+		unsigned int a, b, c, d;
+		__cpuid_count(leaf, subleaf, a, b, c, d);
+		regs[0] = int(a); regs[1] = int(b); regs[2] = int(c); regs[3] = int(d);
+#	endif
+}
+
+inline unsigned long long simd_xgetbv()
+{
+#	if(GLM_COMPILER & GLM_COMPILER_VC)
+		return _xgetbv(0);
+#	else
+		unsigned int lo, hi;
+		__asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+		return (static_cast<unsigned long long>(hi) << 32) | lo;
+#	endif
+}
+
+// The CPU must report the feature and the OS must save the wider registers (XCR0)
+inline simdLevel simd_detect()
+{
+	int regs[4];
+	simd_cpuid(regs, 0, 0);
+	int maxLeaf = regs[0];
+	simd_cpuid(regs, 1, 0);
+	bool osxsave = (regs[2] & (1 << 27)) != 0;
+	bool fma = (regs[2] & (1 << 12)) != 0;
+	bool f16c = (regs[2] & (1 << 29)) != 0;
+	if(!osxsave || maxLeaf < 7)
+		return SIMD_SSE2;
+	unsigned long long xcr0 = simd_xgetbv();
+	if((xcr0 & 0x6) != 0x6)
+		return SIMD_SSE2;
+	simd_cpuid(regs, 7, 0);
+	bool avx2 = (regs[1] & (1 << 5)) != 0;
+	bool avx512f = (regs[1] & (1 << 16)) != 0;
+	if(avx512f && avx2 && fma && f16c && (xcr0 & 0xE6) == 0xE6)
+		return SIMD_AVX512;
+	if(avx2 && fma && f16c)
+		return SIMD_AVX2;
+	return SIMD_SSE2;
+}
+
+inline int & simd_limit()
+{
+	static int limit = SIMD_AVX512;
+	return limit;
+}
+
+template <template <typename> class kernel, typename... args>
+GLM_SIMD_FLATTEN inline auto simd_run_sse2(args &&... a) -> decltype(kernel<simd_sse2>::run(std::forward<args>(a)...))
+{
+	return kernel<simd_sse2>::run(std::forward<args>(a)...);
+}
+
+template <template <typename> class kernel, typename... args>
+GLM_SIMD_TARGET_AVX2 GLM_SIMD_FLATTEN auto simd_run_avx2(args &&... a) -> decltype(kernel<simd_sse2>::run(std::forward<args>(a)...))
+{
+	return kernel<simd_avx2>::run(std::forward<args>(a)...);
+}
+
+template <template <typename> class kernel, typename... args>
+GLM_SIMD_TARGET_AVX512 GLM_SIMD_FLATTEN auto simd_run_avx512(args &&... a) -> decltype(kernel<simd_sse2>::run(std::forward<args>(a)...))
+{
+	return kernel<simd_avx512>::run(std::forward<args>(a)...);
+}
+
+}//namespace detail
+
+inline simdLevel simdCpuLevel()
+{
+	static simdLevel const level = detail::simd_detect();
+	return level;
+}
+
+inline simdLevel simdActiveLevel()
+{
+	int cpu = simdCpuLevel();
+	return simdLevel(cpu < detail::simd_limit() ? cpu : detail::simd_limit());
+}
+
+inline void simdSetLevel(simdLevel level)
+{
+	detail::simd_limit() = level;
+}
+
+inline char const * simdLevelName(simdLevel level)
+{
+	return level == SIMD_AVX512 ? "avx512" : level == SIMD_AVX2 ? "avx2" : "sse2";
+}
+
+template <template <typename> class kernel, typename... args>
+inline auto simdDispatch(args &&... a) -> decltype(kernel<simdSSE2>::run(std::forward<args>(a)...))
+{
+	switch(simdActiveLevel())
+	{
+	case SIMD_AVX512:
+		return detail::simd_run_avx512<kernel>(std::forward<args>(a)...);
+	case SIMD_AVX2:
+		return detail::simd_run_avx2<kernel>(std::forward<args>(a)...);
+	default:
+		return detail::simd_run_sse2<kernel>(std::forward<args>(a)...);
+	}
+}
+
+//////////////////////////////////////
+// Functions
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> min(detail::fvecNSIMD<isa, N> const & a, detail::fvecNSIMD<isa, N> const & b)
+{
+	detail::fvecNSIMD<isa, N> r;
+	detail::simd_ops<isa, N>::min(a.Data, b.Data, r.Data);
+	return r;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> max(detail::fvecNSIMD<isa, N> const & a, detail::fvecNSIMD<isa, N> const & b)
+{
+	detail::fvecNSIMD<isa, N> r;
+	detail::simd_ops<isa, N>::max(a.Data, b.Data, r.Data);
+	return r;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> fma(detail::fvecNSIMD<isa, N> const & a, detail::fvecNSIMD<isa, N> const & b, detail::fvecNSIMD<isa, N> const & c)
+{
+	detail::fvecNSIMD<isa, N> r;
+	detail::simd_ops<isa, N>::fma(a.Data, b.Data, c.Data, r.Data);
+	return r;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> sqrt(detail::fvecNSIMD<isa, N> const & x)
+{
+	detail::fvecNSIMD<isa, N> r;
+	detail::simd_ops<isa, N>::sqrt(x.Data, r.Data);
+	return r;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> rsqrt(detail::fvecNSIMD<isa, N> const & x)
+{
+	detail::fvecNSIMD<isa, N> r;
+	detail::simd_ops<isa, N>::rsqrt(x.Data, r.Data);
+	return r;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> abs(detail::fvecNSIMD<isa, N> const & x)
+{
+	detail::fvecNSIMD<isa, N> r;
+	detail::simd_ops<isa, N>::abs(x.Data, r.Data);
+	return r;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> roundEven(detail::fvecNSIMD<isa, N> const & x)
+{
+	detail::fvecNSIMD<isa, N> r;
+	detail::simd_ops<isa, N>::roundeven(x.Data, r.Data);
+	return r;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> frexp(detail::fvecNSIMD<isa, N> const & x, detail::fvecNSIMD<isa, N> & exp)
+{
+	detail::fvecNSIMD<isa, N> r;
+	detail::simd_ops<isa, N>::frexp(x.Data, r.Data, exp.Data);
+	return r;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> ldexp(detail::fvecNSIMD<isa, N> const & x, detail::fvecNSIMD<isa, N> const & exp)
+{
+	detail::fvecNSIMD<isa, N> r;
+	detail::simd_ops<isa, N>::ldexp(x.Data, exp.Data, r.Data);
+	return r;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE detail::fvecNSIMD<isa, N> select(detail::bvecNSIMD<isa, N> const & mask, detail::fvecNSIMD<isa, N> const & a, detail::fvecNSIMD<isa, N> const & b)
+{
+	detail::fvecNSIMD<isa, N> r;
+	detail::simd_ops<isa, N>::blend(detail::simd_bits(mask), a.Data, b.Data, r.Data);
+	return r;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE unsigned int bitmask(detail::bvecNSIMD<isa, N> const & mask)
+{
+	return detail::simd_ops<isa, N>::movemask(detail::simd_bits(mask));
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE bool any(detail::bvecNSIMD<isa, N> const & mask)
+{
+	return bitmask(mask) != 0;
+}
+
+template <typename isa, int N>
+GLM_SIMD_INLINE bool all(detail::bvecNSIMD<isa, N> const & mask)
+{
+	return bitmask(mask) == (1u << N) - 1u;
+}
+
+}//namespace glm
+
+#if(GLM_COMPILER & GLM_COMPILER_GCC)
+#	pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,108 @@
+// bench_packing: glm/gtx/simd_packing.hpp 배열 변환의 속도를 스칼라 gtc/packing 반복과 비교
+// 집합(SSE2, AVX2)마다 결과가 스칼라 함수와 비트 단위로 같은지도 확인
+//
+//   g++ -std=c++17 -O2 -I include tools/bench_packing.cpp -o bench_packing
+//   ./bench_packing [개수]      (기본 2^20, 7번 반복 중 가장 빠른 시간, 초당 백만 개)
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtx/simd_packing.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+using namespace glm;
+
+template <typename F>
+double bestSeconds(F f) {
+    double best = 1e9;
+    for (int r = 0; r < 7; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+    return best;
+}
+
+int failures = 0;
+
+// 배열판 결과 a와 스칼라 반복 결과 b를 바이트 단위로 비교
+template <typename T>
+void compare(const char* name, const std::vector<T>& a, const std::vector<T>& b) {
+    if (memcmp(a.data(), b.data(), a.size() * sizeof(T)) != 0) {
+        std::printf("  %s: result differs from the scalar function\n", name);
+        ++failures;
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? size_t(atol(argv[1])) : size_t(1) << 20;
+    // 범위 밖과 경계 근처 값이 섞이도록 [-1.2, 1.2]에서 뽑음
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> dist(-1.2f, 1.2f);
+    std::vector<float> f(n), fo(n), fr(n);
+    for (float& x : f) x = dist(rng);
+    std::vector<uint8> b(n), br(n);
+    std::vector<uint16> h(n), hr(n);
+    std::vector<uint32> w(n / 4), wr(n / 4);
+    const vec4* f4 = reinterpret_cast<const vec4*>(f.data());
+    vec4* fo4 = reinterpret_cast<vec4*>(fo.data());
+    vec4* fr4 = reinterpret_cast<vec4*>(fr.data());
+    // 풀기 입력은 압축 결과를 그대로 사용
+    packUnorm1x8(f.data(), n, b.data());
+    packHalf1x16(f.data(), n, h.data());
+    packSnorm3x10_1x2(f4, n / 4, w.data());
+
+    std::printf("%zu values, Melem/s (3x10_1x2: vec4 per element)\n", n);
+    std::printf("%-22s %9s", "", "scalar");
+    for (int l = SIMD_SSE2; l <= std::min<int>(simdCpuLevel(), SIMD_AVX2); ++l) std::printf(" %9s", simdLevelName(simdLevel(l)));
+    std::printf("\n");
+
+    // scalar는 스칼라 함수를 원소마다 부르는 반복, batch는 배열판, check는 두 결과 비교
+    auto row = [&](const char* name, size_t count, auto scalar, auto batch, auto check) {
+        std::printf("%-22s %9.0f", name, count / bestSeconds(scalar) / 1e6);
+        for (int l = SIMD_SSE2; l <= std::min<int>(simdCpuLevel(), SIMD_AVX2); ++l) {
+            simdSetLevel(simdLevel(l));
+            std::printf(" %9.0f", count / bestSeconds(batch) / 1e6);
+            check(name);
+        }
+        simdSetLevel(simdCpuLevel());
+        std::printf("\n");
+    };
+
+    row("packUnorm1x8", n,
+        [&]() { for (size_t i = 0; i < n; ++i) br[i] = packUnorm1x8(f[i]); },
+        [&]() { packUnorm1x8(f.data(), n, b.data()); },
+        [&](const char* s) { compare(s, b, br); });
+    row("unpackUnorm1x8", n,
+        [&]() { for (size_t i = 0; i < n; ++i) fr[i] = unpackUnorm1x8(b[i]); },
+        [&]() { unpackUnorm1x8(b.data(), n, fo.data()); },
+        [&](const char* s) { compare(s, fo, fr); });
+    row("packSnorm1x16", n,
+        [&]() { for (size_t i = 0; i < n; ++i) hr[i] = packSnorm1x16(f[i]); },
+        [&]() { packSnorm1x16(f.data(), n, h.data()); },
+        [&](const char* s) { compare(s, h, hr); });
+    row("packHalf1x16", n,
+        [&]() { for (size_t i = 0; i < n; ++i) hr[i] = packHalf1x16(f[i]); },
+        [&]() { packHalf1x16(f.data(), n, h.data()); },
+        [&](const char* s) { compare(s, h, hr); });
+    row("unpackHalf1x16", n,
+        [&]() { for (size_t i = 0; i < n; ++i) fr[i] = unpackHalf1x16(h[i]); },
+        [&]() { unpackHalf1x16(h.data(), n, fo.data()); },
+        [&](const char* s) { compare(s, fo, fr); });
+    row("packSnorm3x10_1x2", n / 4,
+        [&]() { for (size_t i = 0; i < n / 4; ++i) wr[i] = packSnorm3x10_1x2(f4[i]); },
+        [&]() { packSnorm3x10_1x2(f4, n / 4, w.data()); },
+        [&](const char* s) { compare(s, w, wr); });
+    row("unpackSnorm3x10_1x2", n / 4,
+        [&]() { for (size_t i = 0; i < n / 4; ++i) fr4[i] = unpackSnorm3x10_1x2(w[i]); },
+        [&]() { unpackSnorm3x10_1x2(w.data(), n / 4, fo4); },
+        [&](const char* s) { compare(s, fo, fr); });
+
+    if (failures) std::printf("%d mismatches\n", failures);
+    return failures ? 1 : 0;
+}
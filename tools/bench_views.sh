@@ -0,0 +1,64 @@
+#!/bin/bash
+# bench_views: 다중 시점 렌더링(--views N)과 단일 시점 렌더링 N번의 시간 비교
+# 스레드 1개, 시점 수마다 반복 중 가장 빠른 render 시간, 장면을 주지 않으면 임의의 구 3000개와 평면으로 만듦
+# 단일 시점과 다중 시점 모두 같은 경로(픽셀 블록 ray 묶음 순회)로 렌더링하므로 차이는 시점 사이에 공유한 것뿐
+# 나머지 인자는 렌더러 옵션으로 그대로 전달 (예: --gi 64, --path 4 --guide 3, --photons 200000)
+# 옵션이 없으면 시점 3개의 가운데 이미지가 단일 시점 이미지와 같은 바이트인지도 확인
+# (확인은 --simd sse2로: 곱셈과 덧셈을 FMA로 합치는 컴파일러에서는 AVX2 구 검사가 스칼라 검사와 마지막 비트가 다를 수 있음)
+#
+#   tools/bench_views.sh <EmptyViewer 실행 파일> [장면 파일] [반복 횟수] [렌더러 옵션...]     (기본 반복 9)
+
+viewer=$1
+scene=$2
+reps=${3:-9}
+shift 3 2> /dev/null || shift $#
+options=("$@")
+if [ -z "$viewer" ]; then
+    echo "usage: $0 <viewer> [scene] [repetitions] [renderer options...]"
+    exit 2
+fi
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+if [ -z "$scene" ]; then
+    scene=$work/spheres.txt
+    awk 'BEGIN {
+        srand(1)
+        print "camera 0 0 0 -0.1 0.1 -0.1 0.1 0.1"
+        print "light -2 3 -5 40 40 40"
+        print "plane -3"
+        for (k = 0; k < 3000; ++k) {
+            printf "material diffuse %.2f %.2f %.2f\n", rand(), rand(), rand()
+            printf "sphere %.3f %.3f %.3f %.3f\n", rand() * 8 - 4, rand() * 6 - 3, -6 - rand() * 10, 0.03 + rand() * 0.12
+        }
+    }' > "$scene"
+fi
+
+# best <시점 수>: 가장 빠른 render 시간 (1이면 단일 시점)
+best() {
+    local args="" t b=""
+    [ "$1" -gt 1 ] && args="--views $1 0.05"
+    for r in $(seq "$reps"); do
+        t=$("$viewer" --scene "$scene" --threads 1 "${options[@]}" $args --output "$work/out.ppm" | awk '/^render:/ { print $(NF - 1) }')
+        if [ -z "$b" ] || awk -v a="$t" -v b="$b" 'BEGIN { exit !(a < b) }'; then b=$t; fi
+    done
+    echo "$b"
+}
+
+single=$(best 1)
+printf "%5s %10s %10s %12s %8s\n" views "time (s)" "per view" "N x single" speedup
+printf "%5d %10.4f %10.4f %12.4f %8.2f\n" 1 "$single" "$single" "$single" 1
+for n in 2 4 8 16; do
+    t=$(best "$n")
+    awk -v n="$n" -v t="$t" -v s="$single" 'BEGIN { printf "%5d %10.4f %10.4f %12.4f %8.2f\n", n, t, t / n, n * s, n * s / t }'
+done
+
+[ ${#options[@]} -gt 0 ] && exit 0
+"$viewer" --scene "$scene" --simd sse2 --threads 1 --output "$work/single.ppm" > /dev/null
+"$viewer" --scene "$scene" --simd sse2 --threads 1 --views 3 0.05 --output "$work/views.ppm" > /dev/null
+if cmp -s "$work/single.ppm" "$work/views_1.ppm"; then
+    echo "middle view matches the single render"
+else
+    echo "middle view differs from the single render"
+    exit 1
+fi
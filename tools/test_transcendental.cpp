@@ -0,0 +1,238 @@
+// test_transcendental: glm/gtx/simd_transcendental.hpp의 정확도와 속도 측정
+// 헤더 주석의 오차 표를 다시 만들고, 표의 값을 넘거나 특수값 결과가 틀리면 실패(종료 코드 1)
+//
+//   g++ -std=c++17 -O2 -I include tools/test_transcendental.cpp -o test_transcendental
+//   ./test_transcendental [log2 개수]   정확도: 구간마다 2^개수(기본 24)개 임의 인자와 구간 끝을 double libm과 비교
+//   ./test_transcendental speed         속도: 2^16개 배열을 반복 계산, 초당 백만 개
+
+#include <glm/glm.hpp>
+#include <glm/gtx/simd_transcendental.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cfloat>
+#include <limits>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+using namespace glm;
+
+enum Function { SIN, COS, EXP, EXP2, LOG, LOG2, POW, FunctionCount };
+const char* functionNames[FunctionCount] = {"sin", "cos", "exp", "exp2", "log", "log2", "pow"};
+
+// 배열 전체를 8레인씩 계산 (n은 8의 배수), 집합은 simdDispatch가 고름
+template <typename isa>
+struct EvalKernel {
+    typedef detail::fvecNSIMD<isa, 8> F;
+
+    template <simdAccuracy A>
+    static F eval(int fn, const F& a, const F& b) {
+        switch (fn) {
+        case SIN: return glm::sin<A>(a);
+        case COS: return glm::cos<A>(a);
+        case EXP: return glm::exp<A>(a);
+        case EXP2: return glm::exp2<A>(a);
+        case LOG: return glm::log<A>(a);
+        case LOG2: return glm::log2<A>(a);
+        default: return glm::pow<A>(a, b);
+        }
+    }
+    static void run(int fn, bool fast, const float* x, const float* y, float* out, size_t n) {
+        for (size_t i = 0; i < n; i += 8) {
+            F a(x + i), b(y + i);
+            (fast ? eval<SIMD_FAST>(fn, a, b) : eval<SIMD_ACCURATE>(fn, a, b)).store(out + i);
+        }
+    }
+};
+
+double exact(int fn, double x, double y) {
+    switch (fn) {
+    case SIN: return std::sin(x);
+    case COS: return std::cos(x);
+    case EXP: return std::exp(x);
+    case EXP2: return std::exp2(x);
+    case LOG: return std::log(x);
+    case LOG2: return std::log2(x);
+    default: return std::pow(x, y);
+    }
+}
+
+float libm(int fn, float x, float y) {
+    switch (fn) {
+    case SIN: return sinf(x);
+    case COS: return cosf(x);
+    case EXP: return expf(x);
+    case EXP2: return exp2f(x);
+    case LOG: return logf(x);
+    case LOG2: return log2f(x);
+    default: return powf(x, y);
+    }
+}
+
+// f와 정확한 값 r의 차이를 r 자리의 ulp로 (denormal은 최소 지수의 ulp), 무한대/NaN이 틀리면 아주 큰 값
+double ulps(float f, double r) {
+    if (std::isnan(r)) return std::isnan(f) ? 0.0 : 1e30;
+    if (std::isinf(r)) return f == r ? 0.0 : 1e30;
+    if (std::isnan(f) || std::isinf(f)) return std::fabs(r) > double(FLT_MAX) ? 0.0 : 1e30;
+    int e;
+    std::frexp(r, &e);
+    return std::fabs(f - r) / std::ldexp(1.0, std::max(e, -125) - 24);
+}
+
+// 헤더 표의 한 줄: 인자 구간(logScale이면 로그 균등), pow의 지수 구간, 표의 최대 오차
+// fast sin/cos는 절대 오차로 잼 (0 근처에서 상대 정확도를 잃으므로)
+struct Row {
+    int fn;
+    const char* label;
+    float lo, hi;
+    bool logScale;
+    float ylo, yhi;
+    double accurateLimit, fastLimit;
+};
+
+const Row rows[] = {
+    {SIN, "[-pi, pi]", -3.14159265f, 3.14159265f, false, 0, 0, 1.6, 1.2e-5},
+    {SIN, "[-8192, 8192]", -8192.0f, 8192.0f, false, 0, 0, 2.4, 1.3e-5},
+    {COS, "[-pi, pi]", -3.14159265f, 3.14159265f, false, 0, 0, 1.6, 1.2e-5},
+    {COS, "[-8192, 8192]", -8192.0f, 8192.0f, false, 0, 0, 2.4, 1.3e-5},
+    {EXP, "[-87.3, 88.7]", -87.3f, 88.7f, false, 0, 0, 1.1, 122},
+    {EXP, "[-103, -87.3] (denormal result)", -103.0f, -87.3f, false, 0, 0, 0.8, 50},
+    {EXP2, "[-126, 128]", -126.0f, 127.99f, false, 0, 0, 1.0, 70},
+    {LOG, "normal x > 0", 1.17549435e-38f, 3.4e38f, true, 0, 0, 0.9, 141},
+    {LOG, "denormal x", 1e-45f, 1.17549435e-38f, true, 0, 0, 0.5, 0.9},
+    {LOG2, "normal x > 0", 1.17549435e-38f, 3.4e38f, true, 0, 0, 1.4, 142},
+    {POW, "x in [1e-3, 1e3], |y| <= 4", 1e-3f, 1e3f, true, -4, 4, 3.7, 218},
+    {POW, "x in [1e-3, 1e3], |y| <= 12", 1e-3f, 1e3f, true, -12, 12, 8.1, 588},
+    {POW, "x in [0.5, 2], |y| <= 64", 0.5f, 2.0f, false, -64, 64, 39, 3108},
+};
+
+int failures = 0;
+
+void accuracy(size_t n) {
+    std::vector<float> x(n), y(n), out(n);
+    std::mt19937_64 rng(1234);
+    int top = std::min<int>(simdCpuLevel(), SIMD_AVX512);
+    std::printf("max error in ulp over %zu arguments per range (fast sin/cos: absolute error)\n", n);
+    std::printf("%-5s %-32s %-9s", "", "range", "tier");
+    for (int l = SIMD_SSE2; l <= top; ++l) std::printf(" %10s", simdLevelName(simdLevel(l)));
+    std::printf(" %10s\n", "glibc");
+    for (const Row& row : rows) {
+        std::uniform_real_distribution<double> ux(row.lo, row.hi), uy(row.ylo, row.yhi);
+        std::uniform_real_distribution<double> ul(std::log2(double(row.lo)), std::log2(double(row.hi)));
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = row.logScale ? float(std::exp2(ul(rng))) : float(ux(rng));
+            y[i] = float(uy(rng));
+        }
+        x[0] = row.lo;
+        x[1] = row.hi;
+        double lib = 0.0;
+        for (size_t i = 0; i < n; ++i) lib = std::max(lib, ulps(libm(row.fn, x[i], y[i]), exact(row.fn, x[i], y[i])));
+        for (int tier = 0; tier < 2; ++tier) {
+            bool fast = tier == 1;
+            bool absolute = fast && (row.fn == SIN || row.fn == COS);
+            double limit = fast ? row.fastLimit : row.accurateLimit;
+            std::printf("%-5s %-32s %-9s", functionNames[row.fn], row.label, fast ? "fast" : "accurate");
+            for (int l = SIMD_SSE2; l <= top; ++l) {
+                simdSetLevel(simdLevel(l));
+                simdDispatch<EvalKernel>(row.fn, fast, x.data(), y.data(), out.data(), n);
+                double worst = 0.0;
+                for (size_t i = 0; i < n; ++i) {
+                    double r = exact(row.fn, x[i], y[i]);
+                    worst = std::max(worst, absolute ? std::fabs(out[i] - r) : ulps(out[i], r));
+                }
+                // 표는 소수 한 자리(절대 오차는 두 자리)로 적혀 있으므로 반올림 폭만큼 여유
+                bool ok = worst <= limit * 1.05;
+                if (!ok) ++failures;
+                std::printf(absolute ? " %9.2g%s" : " %9.2f%s", worst, ok ? " " : "!");
+            }
+            std::printf(" %10.2f\n", lib);
+        }
+    }
+    simdSetLevel(simdCpuLevel());
+}
+
+// 헤더 주석의 특수값 규칙, 집합과 정확도 등급마다 검사
+void specialValues() {
+    const float inf = std::numeric_limits<float>::infinity(), nan = std::numeric_limits<float>::quiet_NaN();
+    struct Case { int fn; float x, y, expected; };
+    const Case cases[] = {
+        {SIN, inf, 0, nan}, {SIN, nan, 0, nan}, {COS, -inf, 0, nan},
+        {EXP, 100.0f, 0, inf}, {EXP, -110.0f, 0, 0.0f}, {EXP, -inf, 0, 0.0f}, {EXP, inf, 0, inf},
+        {EXP2, 128.0f, 0, inf}, {EXP2, -150.0f, 0, 0.0f},
+        {LOG, 0.0f, 0, -inf}, {LOG, -1.0f, 0, nan}, {LOG, inf, 0, inf}, {LOG2, 0.0f, 0, -inf},
+        {POW, 2.0f, inf, inf}, {POW, 0.5f, inf, 0.0f}, {POW, 2.0f, -inf, 0.0f}, {POW, 3.0f, 0.0f, 1.0f},
+        {POW, 1.0f, 1e30f, 1.0f}, {POW, -2.0f, 2.0f, nan},
+    };
+    for (const Case& c : cases) {
+        for (int tier = 0; tier < 2; ++tier) {
+            for (int l = SIMD_SSE2; l <= std::min<int>(simdCpuLevel(), SIMD_AVX512); ++l) {
+                simdSetLevel(simdLevel(l));
+                float x[8], y[8], out[8];
+                std::fill(x, x + 8, c.x);
+                std::fill(y, y + 8, c.y);
+                simdDispatch<EvalKernel>(c.fn, tier == 1, x, y, out, size_t(8));
+                bool ok = std::isnan(c.expected) ? std::isnan(out[0]) : out[0] == c.expected;
+                if (!ok) {
+                    ++failures;
+                    std::printf("%s %s(%g, %g) = %g, expected %g\n", simdLevelName(simdLevel(l)),
+                                functionNames[c.fn], c.x, c.y, out[0], c.expected);
+                }
+            }
+        }
+    }
+    simdSetLevel(simdCpuLevel());
+    std::printf("special values: %s\n", failures ? "FAILED" : "ok");
+}
+
+template <typename F>
+double bestSeconds(F f) {
+    double best = 1e9;
+    for (int r = 0; r < 7; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+    return best;
+}
+
+void speed() {
+    const size_t n = size_t(1) << 16;
+    std::vector<float> x(n), y(n, 1.5f), out(n);
+    for (size_t i = 0; i < n; ++i) x[i] = float(i % 1000) * 0.01f + 0.001f;
+    int top = std::min<int>(simdCpuLevel(), SIMD_AVX512);
+    std::printf("%u elements, Melem/s\n%-5s %9s", unsigned(n), "", "glibc");
+    for (int tier = 0; tier < 2; ++tier)
+        for (int l = SIMD_SSE2; l <= top; ++l)
+            std::printf(" %4s %-7s", tier ? "fast" : "acc", simdLevelName(simdLevel(l)));
+    std::printf("\n");
+    for (int fn = 0; fn < FunctionCount; ++fn) {
+        std::printf("%-5s %9.0f", functionNames[fn],
+                    n / bestSeconds([&]() { for (size_t i = 0; i < n; ++i) out[i] = libm(fn, x[i], y[i]); }) / 1e6);
+        for (int tier = 0; tier < 2; ++tier) {
+            for (int l = SIMD_SSE2; l <= top; ++l) {
+                simdSetLevel(simdLevel(l));
+                double s = bestSeconds([&]() { simdDispatch<EvalKernel>(fn, tier == 1, x.data(), y.data(), out.data(), n); });
+                std::printf(" %12.0f", n / s / 1e6);
+            }
+        }
+        simdSetLevel(simdCpuLevel());
+        std::printf("\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string(argv[1]) == "speed") {
+        speed();
+        return 0;
+    }
+    int bits = argc > 1 ? atoi(argv[1]) : 24;
+    size_t n = (size_t(1) << std::max(std::min(bits, 28), 3));
+    specialValues();
+    accuracy(n);
+    if (failures) std::printf("%d failures\n", failures);
+    return failures ? 1 : 0;
+}